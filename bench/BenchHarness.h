@@ -0,0 +1,260 @@
+#pragma once
+
+// bench/BenchHarness.h
+// Minimal microbenchmark runner shared by the bench/ programs.
+//
+//   Bench::Runner runner(options);
+//   runner.run("parser.parseInto", points, bytes, [&](int thread) { ... });
+//   runner.writeJson("results.json");
+//
+// Every benchmark runs once per configured thread count. Each thread
+// calls the body in a loop for at least Options::minSeconds after one
+// warm-up call; every call is timed individually. Reported:
+//   • per-call latency: min / p50 / p90 / p99 / max / mean
+//   • throughput over all threads: calls, items and bytes per second
+//
+// Bodies receive their thread index, so per-thread scratch buffers can
+// be set up in advance and the measured loop never shares state.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Bench
+{
+    struct Options
+    {
+        std::vector<int> threadCounts{ 1 };
+        double      minSeconds = 0.5;
+        std::string filter;              // substring; empty = run all
+    };
+
+    struct Result
+    {
+        std::string name;
+        int      threads    = 1;
+        uint64_t calls      = 0;
+        double   itemsPerCall = 0.0;
+        double   bytesPerCall = 0.0;
+
+        // Per-call latency, nanoseconds
+        double minNs = 0.0, p50Ns = 0.0, p90Ns = 0.0, p99Ns = 0.0, maxNs = 0.0, meanNs = 0.0;
+
+        // Aggregate over all threads
+        double callsPerSec = 0.0;
+        double itemsPerSec = 0.0;
+        double bytesPerSec = 0.0;
+    };
+
+    class Runner
+    {
+    public:
+        explicit Runner(Options options) : m_options(std::move(options)) {}
+
+        int maxThreads() const
+        {
+            return *std::max_element(m_options.threadCounts.begin(), m_options.threadCounts.end());
+        }
+
+        bool enabled(const char* name) const
+        {
+            return m_options.filter.empty() || std::string(name).find(m_options.filter) != std::string::npos;
+        }
+
+        template <typename Fn>
+        void run(const char* name, double itemsPerCall, double bytesPerCall, Fn&& body)
+        {
+            if (!enabled(name))
+                return;
+
+            for (int threads : m_options.threadCounts)
+                m_results.push_back(measure(name, threads, itemsPerCall, bytesPerCall, body));
+        }
+
+        // Single-threaded only (bodies that are not thread-safe)
+        template <typename Fn>
+        void runSingle(const char* name, double itemsPerCall, double bytesPerCall, Fn&& body)
+        {
+            if (!enabled(name))
+                return;
+
+            m_results.push_back(measure(name, 1, itemsPerCall, bytesPerCall, body));
+        }
+
+        const std::vector<Result>& results() const { return m_results; }
+
+        bool writeJson(const std::string& path, const std::string& label) const
+        {
+            std::FILE* file = std::fopen(path.c_str(), "w");
+            if (!file)
+                return false;
+
+            char date[32];
+            std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+            std::fprintf(file, "{\n  \"label\": \"%s\",\n  \"date\": \"%s\",\n", label.c_str(), date);
+            std::fprintf(file, "  \"compiler\": \"%s\",\n", compilerName());
+#ifdef NDEBUG
+            std::fprintf(file, "  \"optimized\": true,\n");
+#else
+            std::fprintf(file, "  \"optimized\": false,\n");
+#endif
+            std::fprintf(file, "  \"hardware_threads\": %u,\n  \"results\": [", std::thread::hardware_concurrency());
+
+            for (size_t i = 0; i < m_results.size(); ++i)
+            {
+                const Result& r = m_results[i];
+                std::fprintf(file,
+                    "%s\n    {\"name\": \"%s\", \"threads\": %d, \"calls\": %llu, "
+                    "\"items_per_call\": %.0f, \"bytes_per_call\": %.0f, "
+                    "\"min_ns\": %.1f, \"p50_ns\": %.1f, \"p90_ns\": %.1f, \"p99_ns\": %.1f, "
+                    "\"max_ns\": %.1f, \"mean_ns\": %.1f, "
+                    "\"calls_per_sec\": %.1f, \"items_per_sec\": %.1f, \"bytes_per_sec\": %.1f}",
+                    i == 0 ? "" : ",", r.name.c_str(), r.threads,
+                    static_cast<unsigned long long>(r.calls), r.itemsPerCall, r.bytesPerCall,
+                    r.minNs, r.p50Ns, r.p90Ns, r.p99Ns, r.maxNs, r.meanNs,
+                    r.callsPerSec, r.itemsPerSec, r.bytesPerSec);
+            }
+
+            std::fprintf(file, "\n  ]\n}\n");
+            return std::fclose(file) == 0;
+        }
+
+        static void printHeader()
+        {
+            std::printf("%-28s %3s %9s %10s %10s %10s %12s %10s\n",
+                        "benchmark", "thr", "calls", "p50", "p90", "p99", "items/s", "MB/s");
+        }
+
+        static void print(const Result& r)
+        {
+            std::printf("%-28s %3d %9llu %10s %10s %10s %12.4g %10.1f\n",
+                        r.name.c_str(), r.threads, static_cast<unsigned long long>(r.calls),
+                        formatNs(r.p50Ns).c_str(), formatNs(r.p90Ns).c_str(), formatNs(r.p99Ns).c_str(),
+                        r.itemsPerSec, r.bytesPerSec / (1024.0 * 1024.0));
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        static const char* compilerName()
+        {
+#if defined(__clang__)
+            return "clang " __clang_version__;
+#elif defined(__GNUC__)
+            return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+            return "msvc";
+#else
+            return "unknown";
+#endif
+        }
+
+        static std::string formatNs(double ns)
+        {
+            char buf[32];
+            if (ns < 1e3)      std::snprintf(buf, sizeof(buf), "%.0f ns", ns);
+            else if (ns < 1e6) std::snprintf(buf, sizeof(buf), "%.2f us", ns / 1e3);
+            else               std::snprintf(buf, sizeof(buf), "%.2f ms", ns / 1e6);
+            return buf;
+        }
+
+        static double percentile(const std::vector<double>& sorted, double p)
+        {
+            if (sorted.empty())
+                return 0.0;
+            size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+            return sorted[std::min(index, sorted.size() - 1)];
+        }
+
+        template <typename Fn>
+        Result measure(const char* name, int threads, double itemsPerCall, double bytesPerCall, Fn& body)
+        {
+            const auto minDuration = std::chrono::duration<double>(m_options.minSeconds);
+
+            std::vector<std::vector<double>> samples(threads);
+            std::atomic<int>  arrived{0};
+            std::atomic<bool> go{false};
+
+            auto worker = [&](int t)
+            {
+                std::vector<double>& mine = samples[t];
+                mine.reserve(1 << 16);
+
+                body(t);   // warm-up: caches, first-touch, lazy init
+
+                arrived.fetch_add(1);
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+
+                const Clock::time_point start = Clock::now();
+                Clock::time_point now = start;
+                while (now - start < minDuration)
+                {
+                    const Clock::time_point t0 = now;
+                    body(t);
+                    now = Clock::now();
+                    mine.push_back(std::chrono::duration<double, std::nano>(now - t0).count());
+                }
+            };
+
+            std::vector<std::thread> pool;
+            for (int t = 1; t < threads; ++t)
+                pool.emplace_back(worker, t);
+
+            // Thread 0 is this thread
+            while (arrived.load() < threads - 1)
+                std::this_thread::yield();
+
+            const Clock::time_point wallStart = Clock::now();
+            go.store(true, std::memory_order_release);
+            arrived.fetch_add(1);
+            worker(0);
+            for (auto& t : pool)
+                t.join();
+            const double wallSec = std::chrono::duration<double>(Clock::now() - wallStart).count();
+
+            std::vector<double> all;
+            for (auto& s : samples)
+                all.insert(all.end(), s.begin(), s.end());
+            std::sort(all.begin(), all.end());
+
+            Result r;
+            r.name = name;
+            r.threads = threads;
+            r.calls = all.size();
+            r.itemsPerCall = itemsPerCall;
+            r.bytesPerCall = bytesPerCall;
+            if (!all.empty())
+            {
+                double sum = 0.0;
+                for (double v : all)
+                    sum += v;
+
+                r.minNs  = all.front();
+                r.maxNs  = all.back();
+                r.meanNs = sum / all.size();
+                r.p50Ns  = percentile(all, 0.50);
+                r.p90Ns  = percentile(all, 0.90);
+                r.p99Ns  = percentile(all, 0.99);
+            }
+            r.callsPerSec = r.calls / wallSec;
+            r.itemsPerSec = r.callsPerSec * itemsPerCall;
+            r.bytesPerSec = r.callsPerSec * bytesPerCall;
+
+            print(r);
+            return r;
+        }
+
+    private:
+        Options m_options;
+        std::vector<Result> m_results;
+    };
+}
@@ -0,0 +1,119 @@
+// bench/frame_arena_bench.cpp
+// Per-frame upload staging as the renderers do it: a KITTI-sized
+// point buffer (x,y,z,intensity), packed normals and a trajectory
+// line, built once per frame. Compares heap vectors (the old code)
+// with FrameArena and reports heap allocations per frame.
+//
+// Built with KITTI_TRACK_ALLOCS so AllocCounter is live.
+//
+// Usage: kitti_arena_bench [frames]   (default: 500)
+
+#include "core/AllocCounter.h"
+#include "core/FrameArena.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    constexpr size_t kPoints     = 120000;
+    constexpr size_t kTrajectory = 4500;
+
+    volatile float g_sink = 0.0f;
+
+    void consume(const float* data, size_t count)
+    {
+        // Stands in for glBufferSubData: touch the staged data
+        float acc = 0.0f;
+        for (size_t i = 0; i < count; i += 64)
+            acc += data[i];
+        g_sink = g_sink + acc;
+    }
+
+    void stageWithVectors(const std::vector<float>& src)
+    {
+        std::vector<float> points;
+        points.reserve(kPoints * 4);
+        for (size_t i = 0; i < kPoints * 4; ++i)
+            points.push_back(src[i]);
+        consume(points.data(), points.size());
+
+        std::vector<uint32_t> normals(kPoints);
+        for (size_t i = 0; i < kPoints; ++i)
+            normals[i] = static_cast<uint32_t>(i);
+        consume(reinterpret_cast<const float*>(normals.data()), normals.size());
+
+        std::vector<float> traj;
+        traj.reserve(kTrajectory * 3);
+        for (size_t i = 0; i < kTrajectory * 3; ++i)
+            traj.push_back(src[i]);
+        consume(traj.data(), traj.size());
+    }
+
+    void stageWithArena(const std::vector<float>& src, FrameArena& arena)
+    {
+        float* points = arena.allocArray<float>(kPoints * 4);
+        for (size_t i = 0; i < kPoints * 4; ++i)
+            points[i] = src[i];
+        consume(points, kPoints * 4);
+
+        uint32_t* normals = arena.allocArray<uint32_t>(kPoints);
+        for (size_t i = 0; i < kPoints; ++i)
+            normals[i] = static_cast<uint32_t>(i);
+        consume(reinterpret_cast<const float*>(normals), kPoints);
+
+        float* traj = arena.allocArray<float>(kTrajectory * 3);
+        for (size_t i = 0; i < kTrajectory * 3; ++i)
+            traj[i] = src[i];
+        consume(traj, kTrajectory * 3);
+
+        arena.reset();
+    }
+
+    template <typename Fn>
+    void run(const char* label, int frames, Fn&& frame)
+    {
+        frame();   // warm-up (first touch of the arena pages)
+
+        AllocCounter::Counts before = AllocCounter::thisThread();
+        auto t0 = Clock::now();
+        for (int f = 0; f < frames; ++f)
+            frame();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        AllocCounter::Counts after = AllocCounter::thisThread();
+
+        std::printf("  %-22s %7.3f ms/frame  %6.2f allocs/frame  %8.1f KB heap/frame\n",
+                    label, ms / frames,
+                    double(after.allocations - before.allocations) / frames,
+                    double(after.bytes - before.bytes) / frames / 1024.0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int frames = argc > 1 ? std::atoi(argv[1]) : 500;
+
+    std::vector<float> src(kPoints * 4);
+    for (size_t i = 0; i < src.size(); ++i)
+        src[i] = static_cast<float>(i % 997) * 0.01f;
+
+    std::printf("Per-frame staging, %zu points + %zu trajectory vertices, %d frames\n",
+                kPoints, kTrajectory, frames);
+
+    run("heap vectors", frames, [&] { stageWithVectors(src); });
+
+    FrameArena arena;
+    arena.configure(FrameArena::kDefaultCapacity, false);
+    run("arena", frames, [&] { stageWithArena(src, arena); });
+
+    FrameArena hugeArena;
+    hugeArena.configure(FrameArena::kDefaultCapacity, true);
+    run(hugeArena.usesHugePages() ? "arena (huge pages)" : "arena (no THP here)",
+        frames, [&] { stageWithArena(src, hugeArena); });
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+// bench/job_system_bench.cpp
+// Scheduling benchmark for JobSystem: submit/wait overhead,
+// parallelFor scaling and task-graph (fan-out / fan-in) throughput.
+//
+// Usage: kitti_job_bench [threads...]   (default: 1 2 4 hw-1)
+
+#include "core/JobSystem.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// ------------------------------------------------------------
+// 1) Many tiny independent jobs: pure scheduling overhead
+// ------------------------------------------------------------
+static void benchSubmitWait(JobSystem& jobs)
+{
+    const int count = 200000;
+    std::atomic<int> sum{0};
+
+    std::vector<JobSystem::TaskHandle> handles;
+    handles.reserve(count);
+
+    auto t0 = Clock::now();
+    for (int i = 0; i < count; ++i)
+        handles.push_back(jobs.submit([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }));
+    for (const auto& h : handles)
+        jobs.wait(h);
+    double ms = msSince(t0);
+
+    std::printf("  submit+wait   %7d jobs  %8.2f ms  %8.0f ns/job\n",
+                count, ms, ms * 1e6 / count);
+}
+
+// ------------------------------------------------------------
+// 2) parallelFor over a point-sized workload at several grains
+// ------------------------------------------------------------
+static void benchParallelFor(JobSystem& jobs)
+{
+    const size_t n = 4 * 1000 * 1000;
+    std::vector<float> data(n);
+    std::iota(data.begin(), data.end(), 0.0f);
+
+    const size_t grains[] = { 1024, 16384, 131072 };
+    for (size_t grain : grains)
+    {
+        auto t0 = Clock::now();
+        const int reps = 10;
+        for (int r = 0; r < reps; ++r)
+        {
+            jobs.parallelFor(0, n, grain, [&data](size_t b, size_t e)
+            {
+                for (size_t i = b; i < e; ++i)
+                    data[i] = std::sqrt(data[i] * 1.0001f + 1.0f);
+            });
+        }
+        double ms = msSince(t0) / reps;
+
+        std::printf("  parallelFor   grain %6zu  %8.3f ms/pass  %6.1f Mpts/s\n",
+                    grain, ms, n / (ms * 1e3));
+    }
+}
+
+// ------------------------------------------------------------
+// 3) Task graph: root → N children → join, repeated
+// ------------------------------------------------------------
+static void benchTaskGraph(JobSystem& jobs)
+{
+    const int graphs = 2000;
+    const int fanOut = 16;
+    std::atomic<int> work{0};
+
+    auto t0 = Clock::now();
+    for (int g = 0; g < graphs; ++g)
+    {
+        auto root = jobs.submit([&work] { work.fetch_add(1, std::memory_order_relaxed); });
+
+        std::vector<JobSystem::TaskHandle> children;
+        children.reserve(fanOut);
+        for (int c = 0; c < fanOut; ++c)
+            children.push_back(jobs.submit([&work] { work.fetch_add(1, std::memory_order_relaxed); }, { root }));
+
+        auto join = jobs.submit([&work] { work.fetch_add(1, std::memory_order_relaxed); }, children);
+        jobs.wait(join);
+    }
+    double ms = msSince(t0);
+
+    std::printf("  task graph    %5d x (1 -> %d -> 1)  %8.2f ms  %6.2f us/graph\n",
+                graphs, fanOut, ms, ms * 1e3 / graphs);
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<int> threadCounts;
+    for (int i = 1; i < argc; ++i)
+        threadCounts.push_back(std::atoi(argv[i]));
+
+    if (threadCounts.empty())
+    {
+        int hw = static_cast<int>(std::thread::hardware_concurrency());
+        threadCounts = { 1, 2, 4 };
+        if (hw - 1 > 4)
+            threadCounts.push_back(hw - 1);
+    }
+
+    for (int threads : threadCounts)
+    {
+        JobSystem jobs;
+        jobs.start(threads);
+
+        std::printf("JobSystem: %d worker thread(s)\n", jobs.getWorkerCount());
+        benchSubmitWait(jobs);
+        benchParallelFor(jobs);
+        benchTaskGraph(jobs);
+
+        jobs.stop();
+    }
+
+    return 0;
+}
@@ -0,0 +1,412 @@
+// bench/kitti_bench.cpp
+// Microbenchmarks for the data and math hot paths: scan parsing,
+// pose and image loading, file reads, point cloud reductions, config
+// parsing and MathUtils. See BenchHarness.h for what is measured.
+//
+// Inputs are synthetic (written to a temp directory) unless --data
+// points at a KITTI sequence, in which case velodyne/000000.bin,
+// poses.txt and image_2/000000.png of that sequence are used.
+// Synthetic images are PPM, so their decode cost is not PNG's.
+//
+// Usage: kitti_bench [--threads 1,2,4] [--seconds 0.5] [--filter name]
+//                    [--data <sequence dir>] [--json out.json] [--label text]
+
+#include "BenchHarness.h"
+
+#include "core/Config.h"
+#include "data/ImageLoader.h"
+#include "data/PointCloud.h"
+#include "data/PointCloudParser.h"
+#include "data/PoseLoader.h"
+#include "utils/FileUtils.h"
+#include "utils/Logger.h"
+#include "utils/MathUtils.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    constexpr int kSyntheticPoints = 120000;
+    constexpr int kSyntheticPoses  = 4541;    // sequence 00
+    constexpr int kImageWidth      = 1242;
+    constexpr int kImageHeight     = 375;
+    constexpr int kMathBatch       = 4096;
+
+    volatile float g_sink = 0.0f;
+
+    struct Inputs
+    {
+        std::string scanPath;
+        std::string posesPath;
+        std::string imagePath;
+        std::string configPath;
+        fs::path    tempDir;   // empty when nothing was generated
+    };
+
+    // ---------------- synthetic data ----------------
+
+    void writeScan(const std::string& path)
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+        std::uniform_real_distribution<float> range(2.0f, 80.0f);
+        std::uniform_real_distribution<float> height(-2.0f, 3.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        std::vector<float> data(kSyntheticPoints * 4);
+        for (int i = 0; i < kSyntheticPoints; ++i)
+        {
+            float a = angle(rng), r = range(rng);
+            data[i * 4 + 0] = r * std::cos(a);
+            data[i * 4 + 1] = r * std::sin(a);
+            data[i * 4 + 2] = height(rng);
+            data[i * 4 + 3] = unit(rng);
+        }
+
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(float));
+    }
+
+    void writePoses(const std::string& path)
+    {
+        std::ofstream out(path);
+        for (int i = 0; i < kSyntheticPoses; ++i)
+        {
+            float yaw = i * 0.002f;
+            out << std::cos(yaw) << " 0 " << std::sin(yaw) << " " << i * 0.8f << " "
+                << "0 1 0 " << 0.01f * i << " "
+                << -std::sin(yaw) << " 0 " << std::cos(yaw) << " " << i * 0.1f << "\n";
+        }
+    }
+
+    void writeImage(const std::string& path)
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "P6\n" << kImageWidth << " " << kImageHeight << "\n255\n";
+        std::vector<unsigned char> row(kImageWidth * 3);
+        for (int y = 0; y < kImageHeight; ++y)
+        {
+            for (int x = 0; x < kImageWidth; ++x)
+            {
+                row[x * 3 + 0] = static_cast<unsigned char>(x);
+                row[x * 3 + 1] = static_cast<unsigned char>(y);
+                row[x * 3 + 2] = static_cast<unsigned char>(x ^ y);
+            }
+            out.write(reinterpret_cast<const char*>(row.data()), row.size());
+        }
+    }
+
+    void writeConfig(const std::string& path)
+    {
+        // Shaped like settings.ini: comments, blank lines, key = value
+        std::ofstream out(path);
+        for (int i = 0; i < 64; ++i)
+        {
+            out << "# ------------------------------------------------------------\n";
+            out << "# setting group " << i << "\n\n";
+            out << "int_value_" << i << "   = " << i * 3 << "\n";
+            out << "float_value_" << i << " = " << i * 0.25f << "\n";
+            out << "path_value_" << i << "  = data/kitti/sequences/" << i << "\n";
+        }
+    }
+
+    Inputs prepareInputs(const std::string& sequence)
+    {
+        Inputs in;
+        if (!sequence.empty())
+        {
+            in.scanPath   = sequence + "/velodyne/000000.bin";
+            in.posesPath  = sequence + "/poses.txt";
+            in.imagePath  = sequence + "/image_2/000000.png";
+            in.configPath = "resources/config/settings.ini";
+            return in;
+        }
+
+        in.tempDir = fs::temp_directory_path() / ("kitti_bench_" + std::to_string(std::rand()));
+        fs::create_directories(in.tempDir);
+
+        in.scanPath   = (in.tempDir / "000000.bin").string();
+        in.posesPath  = (in.tempDir / "poses.txt").string();
+        in.imagePath  = (in.tempDir / "000000.ppm").string();
+        in.configPath = (in.tempDir / "settings.ini").string();
+
+        writeScan(in.scanPath);
+        writePoses(in.posesPath);
+        writeImage(in.imagePath);
+        writeConfig(in.configPath);
+        return in;
+    }
+
+    size_t fileSize(const std::string& path)
+    {
+        std::error_code ec;
+        auto size = fs::file_size(path, ec);
+        return ec ? 0 : static_cast<size_t>(size);
+    }
+
+    size_t countLines(const std::string& path)
+    {
+        std::ifstream in(path);
+        size_t lines = 0;
+        std::string line;
+        while (std::getline(in, line))
+            ++lines;
+        return lines;
+    }
+
+    std::vector<int> parseThreadList(const char* text)
+    {
+        std::vector<int> counts;
+        std::stringstream ss(text);
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            int n = std::atoi(item.c_str());
+            if (n > 0)
+                counts.push_back(n);
+        }
+        return counts;
+    }
+
+    std::vector<int> defaultThreadCounts()
+    {
+        int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        std::vector<int> counts{ 1 };
+        for (int n = 2; n < hw; n *= 2)
+            counts.push_back(n);
+        if (hw > 1)
+            counts.push_back(hw);
+        return counts;
+    }
+
+    // ---------------- benchmarks ----------------
+
+    void benchIo(Bench::Runner& runner, const Inputs& in)
+    {
+        const int threads = runner.maxThreads();
+
+        // PointCloudParser: bulk read into a recycled cloud
+        {
+            const size_t bytes = fileSize(in.scanPath);
+            const double points = static_cast<double>(bytes / sizeof(PointCloud::Point));
+            std::vector<PointCloud> clouds(threads);
+            runner.run("parser.parseInto", points, static_cast<double>(bytes), [&](int t)
+            {
+                PointCloudParser parser;
+                parser.parseInto(in.scanPath, clouds[t]);
+            });
+        }
+
+        // FileUtils: raw binary read of the same scan
+        {
+            const size_t bytes = fileSize(in.scanPath);
+            std::vector<std::vector<unsigned char>> buffers(threads);
+            runner.run("fileutils.readFileAsBinary", 1.0, static_cast<double>(bytes), [&](int t)
+            {
+                FileUtils::readFileAsBinary(in.scanPath, buffers[t]);
+            });
+        }
+
+        // PoseLoader: full poses.txt
+        {
+            const size_t bytes = fileSize(in.posesPath);
+            const double poses = static_cast<double>(countLines(in.posesPath));
+            runner.run("poseloader.loadPoseFile", poses, static_cast<double>(bytes), [&](int)
+            {
+                PoseLoader loader;
+                loader.loadPoseFile(in.posesPath);
+                g_sink = g_sink + static_cast<float>(loader.getPoseCount());
+            });
+        }
+
+        // ImageLoader: decode to RGB8
+        {
+            int w = 0, h = 0;
+            std::vector<unsigned char> probe;
+            ImageLoader loader;
+            if (loader.loadImage(in.imagePath, w, h, probe))
+            {
+                std::vector<std::vector<unsigned char>> images(threads);
+                runner.run("imageloader.loadImage", 1.0, static_cast<double>(probe.size()), [&](int t)
+                {
+                    ImageLoader local;
+                    int iw = 0, ih = 0;
+                    local.loadImage(in.imagePath, iw, ih, images[t]);
+                });
+            }
+            else
+            {
+                std::printf("%-28s skipped (cannot read %s)\n", "imageloader.loadImage", in.imagePath.c_str());
+            }
+        }
+
+        // Config: load + a few lookups
+        {
+            const size_t bytes = fileSize(in.configPath);
+            const double lines = static_cast<double>(countLines(in.configPath));
+            runner.run("config.load", lines, static_cast<double>(bytes), [&](int)
+            {
+                Config config(in.configPath);
+                config.load();
+                g_sink = g_sink + static_cast<float>(config.getInt("int_value_7", 0)) +
+                         config.getFloat("float_value_9", 0.0f);
+            });
+        }
+    }
+
+    void benchPointCloud(Bench::Runner& runner, const Inputs& in)
+    {
+        PointCloud cloud;
+        PointCloudParser parser;
+        if (!parser.parseInto(in.scanPath, cloud))
+            return;
+
+        const double points = static_cast<double>(cloud.size());
+        const double bytes  = points * sizeof(PointCloud::Point);
+
+        runner.run("pointcloud.computeCentroid", points, bytes, [&](int)
+        {
+            g_sink = g_sink + cloud.computeCentroid().x;
+        });
+        runner.run("pointcloud.minBounds", points, bytes, [&](int)
+        {
+            g_sink = g_sink + cloud.minBounds().x;
+        });
+        runner.run("pointcloud.maxBounds", points, bytes, [&](int)
+        {
+            g_sink = g_sink + cloud.maxBounds().x;
+        });
+    }
+
+    void benchMath(Bench::Runner& runner)
+    {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> u(-1.0f, 1.0f);
+
+        // Covariance-like symmetric matrices (normal estimation)
+        std::vector<glm::mat3> covariances(kMathBatch);
+        std::vector<glm::vec3> normals(kMathBatch);
+        std::vector<glm::mat4> poses(kMathBatch);
+        std::vector<glm::vec2> ndc(kMathBatch);
+        for (int i = 0; i < kMathBatch; ++i)
+        {
+            glm::vec3 a(u(rng), u(rng), u(rng) * 0.05f);
+            glm::vec3 b(u(rng), u(rng), u(rng) * 0.05f);
+            covariances[i] = glm::outerProduct(a, a) + glm::outerProduct(b, b) + glm::mat3(0.001f);
+            normals[i] = MathUtils::safeNormalize(glm::vec3(u(rng), u(rng), u(rng)));
+            poses[i] = MathUtils::quatToMatrix(MathUtils::eulerToQuat(glm::vec3(0.0f, u(rng) * 180.0f, 0.0f)));
+            ndc[i] = glm::vec2(u(rng), u(rng));
+        }
+
+        const glm::mat4 view = MathUtils::computeLookAt(glm::vec3(0, 20, 30), glm::vec3(0), glm::vec3(0, 1, 0));
+        const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+
+        runner.run("math.smallestEigenvector", kMathBatch, 0.0, [&](int)
+        {
+            float acc = 0.0f;
+            for (const glm::mat3& c : covariances)
+                acc += MathUtils::smallestEigenvector(c).z;
+            g_sink = g_sink + acc;
+        });
+
+        runner.run("math.packSnorm1010102", kMathBatch, 0.0, [&](int)
+        {
+            uint32_t acc = 0;
+            for (const glm::vec3& n : normals)
+                acc ^= MathUtils::packSnorm1010102(n);
+            g_sink = g_sink + static_cast<float>(acc & 0xff);
+        });
+
+        runner.run("math.extractYaw", kMathBatch, 0.0, [&](int)
+        {
+            float acc = 0.0f;
+            for (const glm::mat4& pose : poses)
+                acc += MathUtils::extractYaw(pose);
+            g_sink = g_sink + acc;
+        });
+
+        runner.run("math.ndcToWorldRay", kMathBatch, 0.0, [&](int)
+        {
+            float acc = 0.0f;
+            glm::vec3 origin, dir;
+            for (const glm::vec2& p : ndc)
+            {
+                MathUtils::ndcToWorldRay(p, view, projection, origin, dir);
+                acc += dir.x;
+            }
+            g_sink = g_sink + acc;
+        });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Bench::Options options;
+    options.threadCounts = defaultThreadCounts();
+
+    std::string sequence, jsonPath, label = "kitti_bench";
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--threads") && hasValue)      options.threadCounts = parseThreadList(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seconds") && hasValue) options.minSeconds = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--filter") && hasValue)  options.filter = argv[++i];
+        else if (!std::strcmp(argv[i], "--data") && hasValue)    sequence = argv[++i];
+        else if (!std::strcmp(argv[i], "--json") && hasValue)    jsonPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--label") && hasValue)   label = argv[++i];
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--threads 1,2,4] [--seconds s] [--filter name] "
+                                 "[--data sequence] [--json out.json] [--label text]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (options.threadCounts.empty())
+        options.threadCounts = { 1 };
+
+    // Config::load and friends log; keep the table readable
+    Logger::enableConsole(false);
+
+    Inputs inputs = prepareInputs(sequence);
+    std::printf("Inputs: %s\n\n", sequence.empty() ? ("synthetic in " + inputs.tempDir.string()).c_str()
+                                                  : sequence.c_str());
+
+    Bench::Runner runner(options);
+    Bench::Runner::printHeader();
+
+    benchIo(runner, inputs);
+    benchPointCloud(runner, inputs);
+    benchMath(runner);
+
+    if (!inputs.tempDir.empty())
+    {
+        std::error_code ec;
+        fs::remove_all(inputs.tempDir, ec);
+    }
+
+    if (!jsonPath.empty())
+    {
+        if (!runner.writeJson(jsonPath, label))
+        {
+            std::fprintf(stderr, "Failed to write %s\n", jsonPath.c_str());
+            return 1;
+        }
+        std::printf("\nResults written to %s\n", jsonPath.c_str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,946 @@
+// bench/kitti_synth.cpp
+// Synthetic KITTI odometry sequence generator for scale testing.
+//
+// Writes a sequence directory the viewer loads like a real one:
+//   velodyne/NNNNNN.bin   float32 x, y, z, intensity per return
+//   image_2/NNNNNN.png    RGB8 view of camera 2
+//   image_3, image_0, image_1   with --cameras 2..4 (0 and 1 grey,
+//                         stored as RGB8), for multi-camera replays
+//   poses.txt             camera 0 poses (3x4 row-major, frame 0 = identity)
+//   calib.txt             P0..P3 and Tr (LiDAR → camera 0)
+//   times.txt             timestamps at 10 Hz
+//
+// Scene: the vehicle drives a winding street at constant speed. The
+// street is lined with sidewalks, building blocks, parked cars and
+// poles, all placed in world coordinates from the seed, so consecutive
+// scans and images agree with each other and with poses.txt.
+//
+// LiDAR: 64 beams from +2° to -24.8°, 120 m range, 2 cm range noise.
+// --points is the number of returns per scan; rays that hit nothing
+// are not counted (scans only fall short when most rays see sky).
+//
+// Frames are generated in parallel on the JobSystem. Every frame is a
+// pure function of (seed, frame index), so the output does not depend
+// on the thread count.
+//
+// PNGs are written with stored (uncompressed) deflate blocks: valid
+// for every decoder, fast to produce, about twice KITTI's file size.
+//
+// Usage: kitti_synth --out <dir> [--frames 1000] [--points 120000]
+//                    [--width 1241] [--height 376] [--no-images]
+//                    [--cameras 1]
+//                    [--seed 1] [--threads 0] [--speed 10]
+//                    [--street-width 12] [--building-density 0.8]
+//                    [--cars-per-km 80] [--poles-per-km 40]
+
+#include "core/JobSystem.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    constexpr float kPi           = 3.14159265f;
+    constexpr float kFrameDt      = 0.1f;    // 10 Hz
+    constexpr float kSensorHeight = 1.73f;   // LiDAR above ground
+    constexpr float kMaxRange     = 120.0f;
+    constexpr float kRangeNoise   = 0.02f;
+    constexpr int   kBeams        = 64;
+    constexpr float kSidewalk     = 3.0f;
+    constexpr float kParkingLane  = 2.2f;
+    constexpr int   kAzimuthBins  = 256;
+    constexpr float kBlockLength  = 18.0f;   // building footprint along the street
+    constexpr float kCullDistance = kMaxRange + kBlockLength;
+
+    // Reference intrinsics (sequence 00, 1241x376)
+    constexpr float kRefWidth  = 1241.0f;
+    constexpr float kRefHeight = 376.0f;
+    constexpr float kRefFocal  = 718.856f;
+    constexpr float kRefCx     = 607.1928f;
+    constexpr float kRefCy     = 185.2157f;
+
+    // Camera x offsets from camera 0 (m, positive = left) and the order
+    // --cameras adds them in
+    constexpr float kBaselines[4]   = { 0.0f, -0.54f, 0.06f, -0.48f };
+    constexpr int   kCameraOrder[4] = { 2, 3, 0, 1 };
+
+    struct Options
+    {
+        std::string out;
+        int      frames          = 1000;
+        int      points          = 120000;
+        int      width           = 1241;
+        int      height          = 376;
+        bool     images          = true;
+        int      cameras         = 1;       // image_2, then image_3, image_0, image_1
+        uint32_t seed            = 1;
+        int      threads         = 0;       // 0 = hardware_concurrency - 1
+        float    speed           = 10.0f;   // m/s
+        float    streetWidth     = 12.0f;   // curb to curb, parking lanes included
+        float    buildingDensity = 0.8f;    // fraction of blocks built
+        float    carsPerKm       = 80.0f;   // per side
+        float    polesPerKm      = 40.0f;   // per side
+    };
+
+    // ---------------- hashing / noise ----------------
+
+    uint32_t hash32(uint32_t x)
+    {
+        x ^= x >> 16; x *= 0x7feb352du;
+        x ^= x >> 15; x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    uint32_t hash32(uint32_t a, uint32_t b, uint32_t c = 0)
+    {
+        return hash32(a ^ hash32((b + 0x9e3779b9u) ^ hash32(c + 0x85ebca6bu)));
+    }
+
+    float unitFloat(uint32_t h)
+    {
+        return (h >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // ---------------- scene ----------------
+
+    enum Material : uint8_t { Sky, Ground, Building, Car, Pole };
+
+    // Oriented box standing on the ground, world frame (z up)
+    struct Box
+    {
+        float    s;           // arc length along the path (for culling)
+        glm::vec2 center;
+        float    yaw;
+        glm::vec2 half;       // half extents along its own x / y
+        float    height;
+        Material material;
+        uint32_t id;
+    };
+
+    // Box in the sensor-local frame of one frame, ready for ray tests
+    struct LocalBox
+    {
+        glm::vec2 center;
+        float    cosYaw, sinYaw;
+        glm::vec2 half;
+        float    height;
+        Material material;
+        uint32_t id;
+    };
+
+    struct PathPoint
+    {
+        glm::vec2 position;
+        float     yaw;
+        float     s;
+    };
+
+    struct Scene
+    {
+        std::vector<PathPoint> path;    // one per frame
+        std::vector<Box>       boxes;   // sorted by s
+        float streetHalf = 4.0f;
+        float roadCenter = 2.0f;        // street axis, left of the vehicle (right-hand traffic)
+    };
+
+    // Box indices bucketed by the azimuth range each box covers as seen
+    // from one origin: a ray only tests the boxes in its direction
+    struct AzimuthBins
+    {
+        std::vector<uint32_t> bins[kAzimuthBins];
+
+        static int binOf(float azimuth)
+        {
+            const int bin = static_cast<int>((azimuth + kPi) * (kAzimuthBins / (2.0f * kPi)));
+            return std::clamp(bin, 0, kAzimuthBins - 1);
+        }
+    };
+
+    struct Hit
+    {
+        float    t = 0.0f;
+        Material material = Sky;
+        uint32_t id = 0;
+        glm::vec3 local{0.0f};   // hit in box frame (boxes) or sensor frame (ground)
+        int      axis = 2;       // slab entered: 0 = x face, 1 = y face, 2 = top
+    };
+
+    // Smooth winding road: heading is a sum of two slow sinusoids
+    std::vector<PathPoint> buildPath(const Options& options)
+    {
+        std::mt19937 rng(options.seed);
+        std::uniform_real_distribution<float> phase(0.0f, 2.0f * kPi);
+        const float p1 = phase(rng), p2 = phase(rng);
+
+        auto heading = [&](float s)
+        {
+            return 0.9f * std::sin(s / 260.0f + p1) + 0.35f * std::sin(s / 70.0f + p2);
+        };
+
+        std::vector<PathPoint> path(options.frames);
+        const float step = options.speed * kFrameDt;
+        const int   substeps = 8;
+
+        glm::vec2 position(0.0f);
+        float s = 0.0f;
+        for (int i = 0; i < options.frames; ++i)
+        {
+            path[i] = PathPoint{ position, heading(s), s };
+            for (int k = 0; k < substeps; ++k)
+            {
+                const float yaw = heading(s + 0.5f * step / substeps);
+                position += glm::vec2(std::cos(yaw), std::sin(yaw)) * (step / substeps);
+                s += step / substeps;
+            }
+        }
+        return path;
+    }
+
+    // Path point at arc length s; straight extension beyond both ends
+    PathPoint pathAt(const std::vector<PathPoint>& path, float s, float step)
+    {
+        const float f = std::clamp(s / step, 0.0f, static_cast<float>(path.size() - 1));
+        const size_t i = std::min(static_cast<size_t>(f), path.size() - 1);
+        const size_t j = std::min(i + 1, path.size() - 1);
+        const float w = f - i;
+
+        PathPoint p;
+        p.position = glm::mix(path[i].position, path[j].position, w);
+        p.yaw      = path[i].yaw + (path[j].yaw - path[i].yaw) * w;
+        p.s        = s;
+
+        const float beyond = s - (path[i].s + (path[j].s - path[i].s) * w);
+        p.position += glm::vec2(std::cos(p.yaw), std::sin(p.yaw)) * beyond;
+        return p;
+    }
+
+    Scene buildScene(const Options& options)
+    {
+        Scene scene;
+        scene.path = buildPath(options);
+        scene.streetHalf = options.streetWidth * 0.5f;
+        scene.roadCenter = std::max(1.0f, (scene.streetHalf - kParkingLane) * 0.5f);
+
+        const float step   = options.speed * kFrameDt;
+        const float length = scene.path.back().s + kMaxRange;
+        std::mt19937 rng(options.seed * 7919u + 1u);
+        std::uniform_real_distribution<float> u01(0.0f, 1.0f);
+        uint32_t nextId = 1;
+
+        auto place = [&](float s, float lateral, float yawOffset, glm::vec2 half, float height, Material m)
+        {
+            const PathPoint p = pathAt(scene.path, s, step);
+            const glm::vec2 left(-std::sin(p.yaw), std::cos(p.yaw));
+            scene.boxes.push_back(Box{ s, p.position + left * (scene.roadCenter + lateral),
+                                       p.yaw + yawOffset, half, height, m, nextId++ });
+        };
+
+        for (int side = -1; side <= 1; side += 2)
+        {
+            // Building blocks with varying setback, depth and height
+            for (float s = -kMaxRange; s < length; s += kBlockLength)
+            {
+                if (u01(rng) > options.buildingDensity)
+                    continue;
+                const float setback = u01(rng) * 4.0f;
+                const float depth   = 8.0f + u01(rng) * 10.0f;
+                const float height  = 6.0f + u01(rng) * u01(rng) * 24.0f;
+                const float gap     = 0.5f + u01(rng) * 2.0f;
+                const float lateral = scene.streetHalf + kSidewalk + setback + depth * 0.5f;
+                place(s + kBlockLength * 0.5f, side * lateral, 0.0f,
+                      glm::vec2((kBlockLength - gap) * 0.5f, depth * 0.5f), height, Building);
+            }
+
+            // Parked cars along the curb
+            const int cars = static_cast<int>(options.carsPerKm * length / 1000.0f);
+            for (int i = 0; i < cars; ++i)
+            {
+                const float s = u01(rng) * length - kMaxRange * 0.5f;
+                const float lateral = scene.streetHalf - 1.1f - u01(rng) * 0.2f;
+                place(s, side * lateral, (u01(rng) - 0.5f) * 0.08f,
+                      glm::vec2(2.1f + u01(rng) * 0.4f, 0.85f + u01(rng) * 0.1f),
+                      1.4f + u01(rng) * 0.3f, Car);
+            }
+
+            // Poles on the sidewalk
+            const int poles = static_cast<int>(options.polesPerKm * length / 1000.0f);
+            for (int i = 0; i < poles; ++i)
+            {
+                const float s = u01(rng) * length - kMaxRange * 0.5f;
+                place(s, side * (scene.streetHalf + 0.6f), 0.0f, glm::vec2(0.12f), 4.0f + u01(rng) * 4.0f, Pole);
+            }
+        }
+
+        std::sort(scene.boxes.begin(), scene.boxes.end(),
+                  [](const Box& a, const Box& b) { return a.s < b.s; });
+        return scene;
+    }
+
+    // Boxes near frame i, expressed in that frame's sensor-local
+    // coordinates (x forward, y left, z up, ground at z = 0)
+    void gatherLocalBoxes(const Scene& scene, int frame, std::vector<LocalBox>& out)
+    {
+        out.clear();
+
+        const PathPoint& p = scene.path[frame];
+        const float c = std::cos(p.yaw), s = std::sin(p.yaw);
+
+        auto first = std::lower_bound(scene.boxes.begin(), scene.boxes.end(), p.s - kCullDistance,
+                                      [](const Box& b, float value) { return b.s < value; });
+        for (auto it = first; it != scene.boxes.end() && it->s < p.s + kCullDistance; ++it)
+        {
+            const glm::vec2 d = it->center - p.position;
+            const float yaw = it->yaw - p.yaw;
+
+            LocalBox box;
+            box.center   = glm::vec2(c * d.x + s * d.y, -s * d.x + c * d.y);
+            box.cosYaw   = std::cos(yaw);
+            box.sinYaw   = std::sin(yaw);
+            box.half     = it->half;
+            box.height   = it->height;
+            box.material = it->material;
+            box.id       = it->id;
+            out.push_back(box);
+        }
+    }
+
+    float wrapAngle(float a)
+    {
+        while (a > kPi)  a -= 2.0f * kPi;
+        while (a < -kPi) a += 2.0f * kPi;
+        return a;
+    }
+
+    void buildAzimuthBins(const std::vector<LocalBox>& boxes, const glm::vec3& origin, AzimuthBins& out)
+    {
+        for (auto& bin : out.bins)
+            bin.clear();
+
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            const LocalBox& box = boxes[i];
+            const glm::vec2 toCenter(box.center.x - origin.x, box.center.y - origin.y);
+            const float centerAngle = std::atan2(toCenter.y, toCenter.x);
+
+            // Angular extent of the footprint corners around the center direction
+            float lo = 0.0f, hi = 0.0f;
+            bool all = glm::length(toCenter) <= glm::length(box.half) + 0.1f;
+            for (int corner = 0; corner < 4 && !all; ++corner)
+            {
+                const float hx = (corner & 1) ? box.half.x : -box.half.x;
+                const float hy = (corner & 2) ? box.half.y : -box.half.y;
+                const float cx = toCenter.x + box.cosYaw * hx - box.sinYaw * hy;
+                const float cy = toCenter.y + box.sinYaw * hx + box.cosYaw * hy;
+                const float delta = wrapAngle(std::atan2(cy, cx) - centerAngle);
+                lo = std::min(lo, delta);
+                hi = std::max(hi, delta);
+                all = hi - lo > kPi;
+            }
+
+            if (all)
+            {
+                for (auto& bin : out.bins)
+                    bin.push_back(static_cast<uint32_t>(i));
+                continue;
+            }
+
+            const int first = AzimuthBins::binOf(wrapAngle(centerAngle + lo));
+            const int last  = AzimuthBins::binOf(wrapAngle(centerAngle + hi));
+            for (int b = first;; b = (b + 1) % kAzimuthBins)
+            {
+                out.bins[b].push_back(static_cast<uint32_t>(i));
+                if (b == last)
+                    break;
+            }
+        }
+    }
+
+    // Nearest hit along origin + t * dir (dir normalized)
+    Hit castRay(const std::vector<LocalBox>& boxes, const AzimuthBins& bins,
+                const glm::vec3& origin, const glm::vec3& dir, float maxT)
+    {
+        Hit hit;
+        hit.t = maxT;
+
+        if (dir.z < -1e-6f)
+        {
+            const float t = -origin.z / dir.z;
+            if (t < hit.t)
+            {
+                hit.t = t;
+                hit.material = Ground;
+                hit.local = origin + dir * t;
+            }
+        }
+
+        for (uint32_t index : bins.bins[AzimuthBins::binOf(std::atan2(dir.y, dir.x))])
+        {
+            const LocalBox& box = boxes[index];
+
+            // Into the box frame (rotation about z)
+            const float px = origin.x - box.center.x, py = origin.y - box.center.y;
+            const glm::vec3 o( box.cosYaw * px + box.sinYaw * py, -box.sinYaw * px + box.cosYaw * py, origin.z);
+            const glm::vec3 d( box.cosYaw * dir.x + box.sinYaw * dir.y, -box.sinYaw * dir.x + box.cosYaw * dir.y, dir.z);
+
+            const float lo[3] = { -box.half.x, -box.half.y, 0.0f };
+            const float hi[3] = {  box.half.x,  box.half.y, box.height };
+
+            float tNear = 0.0f, tFar = hit.t;
+            int axis = -1;
+            bool miss = false;
+            for (int a = 0; a < 3 && !miss; ++a)
+            {
+                if (std::fabs(d[a]) < 1e-9f)
+                {
+                    miss = o[a] < lo[a] || o[a] > hi[a];
+                    continue;
+                }
+                float t0 = (lo[a] - o[a]) / d[a];
+                float t1 = (hi[a] - o[a]) / d[a];
+                if (t0 > t1)
+                    std::swap(t0, t1);
+                if (t0 > tNear)
+                {
+                    tNear = t0;
+                    axis = a;
+                }
+                tFar = std::min(tFar, t1);
+                miss = tNear > tFar;
+            }
+
+            // axis < 0: origin inside the box, ignore
+            if (!miss && axis >= 0 && tNear < hit.t)
+            {
+                hit.t = tNear;
+                hit.material = box.material;
+                hit.id = box.id;
+                hit.axis = axis;
+                hit.local = o + d * tNear;
+            }
+        }
+
+        if (hit.material == Sky)
+            hit.t = maxT;
+        return hit;
+    }
+
+    // ---------------- surface appearance ----------------
+
+    bool isLaneMarking(const Scene& scene, const glm::vec3& p, float s)
+    {
+        const float along = s + p.x;
+        const float lateral = p.y - scene.roadCenter;
+        const float y = std::fabs(lateral);
+        const bool center = y < 0.06f && std::fmod(along + 1000.0f, 9.0f) < 3.0f;
+        const bool edge   = y > scene.streetHalf - kParkingLane - 0.15f && y < scene.streetHalf - kParkingLane;
+        return center || edge;
+    }
+
+    float intensityOf(const Scene& scene, const Hit& hit, float s, float noise)
+    {
+        switch (hit.material)
+        {
+        case Ground:
+        {
+            if (isLaneMarking(scene, hit.local, s))
+                return std::min(1.0f, 0.75f + noise * 0.2f);
+            if (std::fabs(hit.local.y - scene.roadCenter) < scene.streetHalf)
+                return 0.12f + noise * 0.12f;
+            return 0.3f + noise * 0.1f;
+        }
+        case Building: return 0.2f + 0.35f * unitFloat(hash32(hit.id)) + noise * 0.1f;
+        case Car:      return 0.45f + noise * 0.3f;
+        case Pole:     return 0.55f + noise * 0.1f;
+        default:       return 0.0f;
+        }
+    }
+
+    glm::vec3 colorOf(const Scene& scene, const Hit& hit, const glm::vec3& dir, float s)
+    {
+        const glm::vec3 horizon(0.80f, 0.85f, 0.90f);
+        if (hit.material == Sky)
+            return glm::mix(horizon, glm::vec3(0.42f, 0.58f, 0.82f), std::clamp(dir.z * 4.0f, 0.0f, 1.0f));
+
+        glm::vec3 color;
+        const glm::vec3& p = hit.local;
+        switch (hit.material)
+        {
+        case Ground:
+        {
+            const float along = s + p.x;
+            const float lateral = std::fabs(p.y - scene.roadCenter);
+            const float grain = unitFloat(hash32(static_cast<uint32_t>(std::floor(along * 8.0f)),
+                                                 static_cast<uint32_t>(std::floor(p.y * 8.0f) + 4096)));
+            if (isLaneMarking(scene, p, s))
+                color = glm::vec3(0.88f);
+            else if (lateral < scene.streetHalf)
+                color = glm::vec3(0.28f + grain * 0.05f);
+            else if (lateral < scene.streetHalf + kSidewalk)
+                color = glm::vec3(0.58f + grain * 0.04f) * (std::fmod(along + 1000.0f, 1.5f) < 0.04f ? 0.8f : 1.0f);
+            else
+                color = glm::vec3(0.24f, 0.38f, 0.16f) * (0.85f + grain * 0.3f);
+            break;
+        }
+        case Building:
+        {
+            static const glm::vec3 palette[] = {
+                { 0.62f, 0.52f, 0.44f }, { 0.70f, 0.66f, 0.58f }, { 0.50f, 0.36f, 0.30f },
+                { 0.78f, 0.76f, 0.72f }, { 0.45f, 0.48f, 0.52f }, { 0.66f, 0.58f, 0.40f } };
+            color = palette[hash32(hit.id) % 6];
+
+            // Window grid on the walls
+            const float across = hit.axis == 0 ? p.y : p.x;
+            const bool window = hit.axis != 2 && p.z > 2.5f &&
+                                std::fmod(across + 100.0f, 3.0f) > 0.8f && std::fmod(across + 100.0f, 3.0f) < 2.2f &&
+                                std::fmod(p.z, 3.2f) > 1.0f && std::fmod(p.z, 3.2f) < 2.4f;
+            if (window)
+                color = glm::vec3(0.18f, 0.22f, 0.28f);
+            break;
+        }
+        case Car:
+        {
+            static const glm::vec3 palette[] = {
+                { 0.75f, 0.10f, 0.10f }, { 0.85f, 0.85f, 0.86f }, { 0.12f, 0.12f, 0.14f },
+                { 0.20f, 0.30f, 0.60f }, { 0.55f, 0.56f, 0.58f }, { 0.15f, 0.40f, 0.25f } };
+            color = palette[hash32(hit.id) % 6];
+            if (p.z > 0.95f && hit.axis != 2)
+                color = glm::vec3(0.10f, 0.12f, 0.15f);   // glass
+            break;
+        }
+        case Pole:
+            color = glm::vec3(0.45f);
+            break;
+        default:
+            color = horizon;
+            break;
+        }
+
+        // Fixed sun: tops brightest, side faces darker
+        static const float faceLight[3] = { 0.78f, 0.62f, 1.0f };
+        if (hit.material != Ground)
+            color *= faceLight[hit.axis];
+
+        const float fog = 1.0f - std::exp(-hit.t / 220.0f);
+        return glm::mix(color, horizon, fog);
+    }
+
+    // ---------------- writers ----------------
+
+    uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0)
+    {
+        static const auto table = []
+        {
+            std::vector<uint32_t> t(256);
+            for (uint32_t n = 0; n < 256; ++n)
+            {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                t[n] = c;
+            }
+            return t;
+        }();
+
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i)
+            crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    void putBE32(std::vector<uint8_t>& out, uint32_t v)
+    {
+        out.push_back(static_cast<uint8_t>(v >> 24));
+        out.push_back(static_cast<uint8_t>(v >> 16));
+        out.push_back(static_cast<uint8_t>(v >> 8));
+        out.push_back(static_cast<uint8_t>(v));
+    }
+
+    void putChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size)
+    {
+        putBE32(out, static_cast<uint32_t>(size));
+        const size_t typeAt = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data, data + size);
+        putBE32(out, crc32(out.data() + typeAt, size + 4));
+    }
+
+    // RGB8 → PNG with filter 0 rows and stored deflate blocks
+    void encodePng(int width, int height, const std::vector<uint8_t>& rgb,
+                   std::vector<uint8_t>& scanlines, std::vector<uint8_t>& zlib, std::vector<uint8_t>& out)
+    {
+        const size_t stride = static_cast<size_t>(width) * 3;
+        scanlines.resize((stride + 1) * height);
+        for (int y = 0; y < height; ++y)
+        {
+            scanlines[y * (stride + 1)] = 0;
+            std::memcpy(&scanlines[y * (stride + 1) + 1], &rgb[y * stride], stride);
+        }
+
+        zlib.clear();
+        zlib.push_back(0x78);
+        zlib.push_back(0x01);
+        uint32_t a = 1, b = 0;
+        for (size_t offset = 0; offset < scanlines.size();)
+        {
+            const size_t n = std::min<size_t>(65535, scanlines.size() - offset);
+            const bool last = offset + n == scanlines.size();
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(static_cast<uint8_t>(n));
+            zlib.push_back(static_cast<uint8_t>(n >> 8));
+            zlib.push_back(static_cast<uint8_t>(~n));
+            zlib.push_back(static_cast<uint8_t>(~n >> 8));
+            zlib.insert(zlib.end(), scanlines.begin() + offset, scanlines.begin() + offset + n);
+
+            for (size_t i = offset; i < offset + n; ++i)
+            {
+                a = (a + scanlines[i]) % 65521u;
+                b = (b + a) % 65521u;
+            }
+            offset += n;
+        }
+        putBE32(zlib, (b << 16) | a);
+
+        static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+        out.assign(signature, signature + 8);
+
+        uint8_t ihdr[13] = {};
+        for (int i = 0; i < 4; ++i)
+        {
+            ihdr[i]     = static_cast<uint8_t>(width  >> (24 - 8 * i));
+            ihdr[4 + i] = static_cast<uint8_t>(height >> (24 - 8 * i));
+        }
+        ihdr[8] = 8;   // bit depth
+        ihdr[9] = 2;   // truecolor
+        putChunk(out, "IHDR", ihdr, sizeof(ihdr));
+        putChunk(out, "IDAT", zlib.data(), zlib.size());
+        putChunk(out, "IEND", nullptr, 0);
+    }
+
+    bool writeFile(const std::string& path, const void* data, size_t size)
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return false;
+        const bool ok = std::fwrite(data, 1, size, file) == size;
+        return std::fclose(file) == 0 && ok;
+    }
+
+    // LiDAR → camera 0, ideal mounting (x fwd/y left/z up → x right/y down/z fwd)
+    glm::mat4 veloToCam()
+    {
+        glm::mat4 Tr(0.0f);
+        Tr[1][0] = -1.0f;   // cam x = -velo y
+        Tr[2][1] = -1.0f;   // cam y = -velo z
+        Tr[0][2] =  1.0f;   // cam z =  velo x
+        Tr[3] = glm::vec4(0.0f, -0.08f, -0.27f, 1.0f);
+        return Tr;
+    }
+
+    // Sensor pose in the world (z up)
+    glm::mat4 veloPose(const PathPoint& p)
+    {
+        const float c = std::cos(p.yaw), s = std::sin(p.yaw);
+        glm::mat4 M(1.0f);
+        M[0] = glm::vec4(c, s, 0.0f, 0.0f);
+        M[1] = glm::vec4(-s, c, 0.0f, 0.0f);
+        M[3] = glm::vec4(p.position, kSensorHeight, 1.0f);
+        return M;
+    }
+
+    void writeRow3x4(std::FILE* file, const char* prefix, const glm::mat4& M)
+    {
+        std::fputs(prefix, file);
+        for (int row = 0; row < 3; ++row)
+            for (int col = 0; col < 4; ++col)
+                std::fprintf(file, "%s%.12e", (row == 0 && col == 0) ? "" : " ", M[col][row]);
+        std::fputc('\n', file);
+    }
+
+    bool writeMetadata(const Options& options, const Scene& scene)
+    {
+        const fs::path dir(options.out);
+        const glm::mat4 Tr = veloToCam();
+        const glm::mat4 TrInv = glm::inverse(Tr);
+        const glm::mat4 world0Inv = glm::inverse(veloPose(scene.path[0]));
+
+        // poses.txt: camera 0 at frame i in camera 0 at frame 0
+        std::FILE* poses = std::fopen((dir / "poses.txt").string().c_str(), "w");
+        std::FILE* times = std::fopen((dir / "times.txt").string().c_str(), "w");
+        std::FILE* calib = std::fopen((dir / "calib.txt").string().c_str(), "w");
+        if (!poses || !times || !calib)
+        {
+            if (poses) std::fclose(poses);
+            if (times) std::fclose(times);
+            if (calib) std::fclose(calib);
+            return false;
+        }
+
+        for (size_t i = 0; i < scene.path.size(); ++i)
+        {
+            writeRow3x4(poses, "", Tr * world0Inv * veloPose(scene.path[i]) * TrInv);
+            std::fprintf(times, "%.6e\n", i * kFrameDt);
+        }
+
+        // Intrinsics scaled from the reference camera to the output size
+        const float fx = kRefFocal * options.width / kRefWidth;
+        const float fy = kRefFocal * options.height / kRefHeight;
+        const float cx = kRefCx * options.width / kRefWidth;
+        const float cy = kRefCy * options.height / kRefHeight;
+        for (int c = 0; c < 4; ++c)
+        {
+            glm::mat4 P(0.0f);
+            P[0][0] = fx; P[2][0] = cx; P[3][0] = fx * kBaselines[c];
+            P[1][1] = fy; P[2][1] = cy;
+            P[2][2] = 1.0f;
+            char prefix[8];
+            std::snprintf(prefix, sizeof(prefix), "P%d: ", c);
+            writeRow3x4(calib, prefix, P);
+        }
+        writeRow3x4(calib, "Tr: ", Tr);
+
+        const bool ok = std::fclose(poses) == 0;
+        return (std::fclose(times) == 0) && (std::fclose(calib) == 0) && ok;
+    }
+
+    // ---------------- per frame ----------------
+
+    struct FrameScratch
+    {
+        std::vector<LocalBox> boxes;
+        AzimuthBins           bins;
+        std::vector<float>    points;
+        std::vector<uint8_t>  rgb, scanlines, zlib, png;
+    };
+
+    void generateScan(const Options& options, const Scene& scene, int frame, FrameScratch& scratch)
+    {
+        std::mt19937 rng(hash32(options.seed, static_cast<uint32_t>(frame), 1u));
+        std::normal_distribution<float> rangeNoise(0.0f, kRangeNoise);
+        std::uniform_real_distribution<float> u01(0.0f, 1.0f);
+
+        const float s = scene.path[frame].s;
+        const glm::vec3 origin(0.0f, 0.0f, kSensorHeight);
+        const float topDeg = 2.0f, bottomDeg = -24.8f;
+        const float golden = 0.6180339887f;
+
+        buildAzimuthBins(scratch.boxes, origin, scratch.bins);
+
+        std::vector<float>& out = scratch.points;
+        out.clear();
+        out.reserve(static_cast<size_t>(options.points) * 4);
+
+        // Beams in order, azimuths on a low-discrepancy sequence so
+        // any prefix of the rays covers the full circle
+        const int64_t maxRays = static_cast<int64_t>(options.points) * 4;
+        int hits = 0;
+        for (int64_t ray = 0; ray < maxRays && hits < options.points; ++ray)
+        {
+            const int beam = static_cast<int>(ray % kBeams);
+            const int64_t column = ray / kBeams;
+
+            const float elevation = glm::radians(topDeg + (bottomDeg - topDeg) * beam / (kBeams - 1));
+            float azimuth = static_cast<float>(column) * golden;
+            azimuth = (azimuth - std::floor(azimuth)) * 2.0f * kPi;
+
+            const float ce = std::cos(elevation);
+            const glm::vec3 dir(ce * std::cos(azimuth), ce * std::sin(azimuth), std::sin(elevation));
+
+            const Hit hit = castRay(scratch.boxes, scratch.bins, origin, dir, kMaxRange);
+            if (hit.material == Sky)
+                continue;
+
+            const float range = hit.t + rangeNoise(rng);
+            const glm::vec3 p = dir * range;   // relative to the sensor
+            out.push_back(p.x);
+            out.push_back(p.y);
+            out.push_back(p.z);
+            out.push_back(intensityOf(scene, hit, s, u01(rng)));
+            ++hits;
+        }
+    }
+
+    void renderImage(const Options& options, const Scene& scene, int frame, int camera, FrameScratch& scratch)
+    {
+        const int w = options.width, h = options.height;
+        const float fx = kRefFocal * w / kRefWidth;
+        const float fy = kRefFocal * h / kRefHeight;
+        const float cx = kRefCx * w / kRefWidth;
+        const float cy = kRefCy * h / kRefHeight;
+        const float s = scene.path[frame].s;
+
+        // Camera in the sensor-local frame; 0 and 1 are greyscale
+        const glm::vec3 origin(0.27f, kBaselines[camera], kSensorHeight - 0.08f);
+        const bool grey = camera < 2;
+        buildAzimuthBins(scratch.boxes, origin, scratch.bins);
+
+        scratch.rgb.resize(static_cast<size_t>(w) * h * 3);
+        for (int y = 0; y < h; ++y)
+        {
+            uint8_t* row = &scratch.rgb[static_cast<size_t>(y) * w * 3];
+            for (int x = 0; x < w; ++x)
+            {
+                // Camera ray (x right, y down, z fwd) → local (x fwd, y left, z up)
+                const float xc = (x + 0.5f - cx) / fx;
+                const float yc = (y + 0.5f - cy) / fy;
+                const glm::vec3 dir = glm::normalize(glm::vec3(1.0f, -xc, -yc));
+
+                const Hit hit = castRay(scratch.boxes, scratch.bins, origin, dir, 1000.0f);
+                glm::vec3 c = glm::clamp(colorOf(scene, hit, dir, s), 0.0f, 1.0f);
+                if (grey)
+                    c = glm::vec3(glm::dot(c, glm::vec3(0.299f, 0.587f, 0.114f)));
+                row[x * 3 + 0] = static_cast<uint8_t>(c.r * 255.0f + 0.5f);
+                row[x * 3 + 1] = static_cast<uint8_t>(c.g * 255.0f + 0.5f);
+                row[x * 3 + 2] = static_cast<uint8_t>(c.b * 255.0f + 0.5f);
+            }
+        }
+
+        encodePng(w, h, scratch.rgb, scratch.scanlines, scratch.zlib, scratch.png);
+    }
+
+    bool generateFrame(const Options& options, const Scene& scene, int frame)
+    {
+        thread_local FrameScratch scratch;
+
+        gatherLocalBoxes(scene, frame, scratch.boxes);
+
+        char name[32];
+        const fs::path dir(options.out);
+
+        generateScan(options, scene, frame, scratch);
+        std::snprintf(name, sizeof(name), "%06d.bin", frame);
+        if (!writeFile((dir / "velodyne" / name).string(), scratch.points.data(), scratch.points.size() * sizeof(float)))
+            return false;
+
+        for (int i = 0; options.images && i < options.cameras; ++i)
+        {
+            const int camera = kCameraOrder[i];
+            renderImage(options, scene, frame, camera, scratch);
+            std::snprintf(name, sizeof(name), "image_%d/%06d.png", camera, frame);
+            if (!writeFile((dir / name).string(), scratch.png.data(), scratch.png.size()))
+                return false;
+        }
+        return true;
+    }
+
+    // ---------------- command line ----------------
+
+    bool parseArguments(int argc, char** argv, Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+            auto takes = [&](const char* flag) { return std::strcmp(arg, flag) == 0 && value && ++i; };
+
+            if (std::strcmp(arg, "--no-images") == 0)     options.images = false;
+            else if (takes("--out"))                      options.out = value;
+            else if (takes("--frames"))                   options.frames = std::atoi(value);
+            else if (takes("--points"))                   options.points = std::atoi(value);
+            else if (takes("--width"))                    options.width = std::atoi(value);
+            else if (takes("--height"))                   options.height = std::atoi(value);
+            else if (takes("--cameras"))                  options.cameras = std::atoi(value);
+            else if (takes("--seed"))                     options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            else if (takes("--threads"))                  options.threads = std::atoi(value);
+            else if (takes("--speed"))                    options.speed = static_cast<float>(std::atof(value));
+            else if (takes("--street-width"))             options.streetWidth = static_cast<float>(std::atof(value));
+            else if (takes("--building-density"))         options.buildingDensity = static_cast<float>(std::atof(value));
+            else if (takes("--cars-per-km"))              options.carsPerKm = static_cast<float>(std::atof(value));
+            else if (takes("--poles-per-km"))             options.polesPerKm = static_cast<float>(std::atof(value));
+            else
+                return false;
+        }
+
+        return !options.out.empty() && options.frames > 0 && options.points > 0 &&
+               options.width > 0 && options.height > 0 &&
+               options.cameras >= 1 && options.cameras <= 4 && options.speed > 0.0f && options.streetWidth > 2.0f;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseArguments(argc, argv, options))
+    {
+        std::fprintf(stderr,
+            "usage: %s --out <dir> [--frames n] [--points n] [--width px] [--height px] [--no-images]\n"
+            "          [--cameras 1..4] [--seed n] [--threads n] [--speed m/s] [--street-width m]\n"
+            "          [--building-density 0..1] [--cars-per-km n] [--poles-per-km n]\n", argv[0]);
+        return 1;
+    }
+
+    const fs::path dir(options.out);
+    std::error_code ec;
+    fs::create_directories(dir / "velodyne", ec);
+    for (int i = 0; options.images && i < options.cameras && !ec; ++i)
+        fs::create_directories(dir / ("image_" + std::to_string(kCameraOrder[i])), ec);
+    if (ec)
+    {
+        std::fprintf(stderr, "Cannot create %s: %s\n", options.out.c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    const double scanBytes  = static_cast<double>(options.points) * 16.0;
+    const double imageBytes = options.images ? static_cast<double>(options.width) * options.height * 3.0 * options.cameras : 0.0;
+    std::printf("Generating %d frames, %d points/scan%s into %s (~%.1f GB)\n",
+                options.frames, options.points, options.images ? "" : ", no images", options.out.c_str(),
+                options.frames * (scanBytes + imageBytes) / 1e9);
+
+    const auto t0 = std::chrono::steady_clock::now();
+
+    const Scene scene = buildScene(options);
+    if (!writeMetadata(options, scene))
+    {
+        std::fprintf(stderr, "Failed to write poses/calib/times into %s\n", options.out.c_str());
+        return 1;
+    }
+
+    JobSystem& jobs = JobSystem::instance();
+    jobs.start(options.threads);
+    std::printf("Scene: %.1f km, %zu objects, %d worker threads\n",
+                scene.path.back().s / 1000.0f, scene.boxes.size(), jobs.getWorkerCount());
+
+    std::atomic<int>  done{0};
+    std::atomic<bool> failed{false};
+    const int reportEvery = std::max(1, options.frames / 20);
+
+    jobs.parallelFor(0, static_cast<size_t>(options.frames), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t frame = begin; frame < end && !failed.load(std::memory_order_relaxed); ++frame)
+        {
+            if (!generateFrame(options, scene, static_cast<int>(frame)))
+            {
+                std::fprintf(stderr, "Failed to write frame %zu\n", frame);
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+
+            const int n = done.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (n % reportEvery == 0 || n == options.frames)
+                std::printf("  %6d / %d frames\n", n, options.frames);
+        }
+    });
+
+    jobs.stop();
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    if (failed.load())
+        return 1;
+
+    std::printf("Done in %.1f s (%.1f frames/s)\n", seconds, options.frames / seconds);
+    return 0;
+}
@@ -0,0 +1,106 @@
+// bench/logger_bench.cpp
+// Logger throughput with several producer threads writing to a log
+// file (console off): the synchronous path (mutex, format, flush per
+// line) against the async backend (MPSC ring + writer thread).
+//
+// Reports the producers' time per message, which is what a frame
+// pays, and the time until everything is written. The async run
+// also reports how many lines were dropped because the ring was
+// full (producers never wait for info lines); its throughput counts
+// written lines only.
+//
+// Usage: kitti_logger_bench [producers] [messages per producer] [log file]
+//        defaults: 8 20000 logger_bench.log
+
+#include "utils/Logger.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    double runProducers(int producers, int messages)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(producers);
+
+        auto t0 = Clock::now();
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([p, messages]()
+            {
+                for (int i = 0; i < messages; ++i)
+                    LOG_INFO("producer " + std::to_string(p) + " frame " + std::to_string(i) +
+                             " points_drawn=120000 cpu_frame_ms=4.2");
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    // ns/msg is per call; msg/s is over the lines actually written
+    void report(const char* label, int total, uint64_t written, double producerMs, double totalMs)
+    {
+        std::printf("  %-6s %8.1f ns/msg (producers)  %8.1f ms until written  %8.0f msg/s written\n",
+                    label, producerMs * 1e6 / total, totalMs,
+                    static_cast<double>(written) / (totalMs / 1000.0));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int producers = argc > 1 ? std::atoi(argv[1]) : 8;
+    int messages  = argc > 2 ? std::atoi(argv[2]) : 20000;
+    std::string path = argc > 3 ? argv[3] : "logger_bench.log";
+
+    const int total = producers * messages;
+
+    Logger::enableConsole(false);
+    Logger::setLogFile(path);
+
+    std::printf("Logger: %d producers x %d messages -> %s\n", producers, messages, path.c_str());
+
+    // Synchronous: every call formats, writes and flushes under the lock
+    {
+        auto t0 = Clock::now();
+        double producerMs = runProducers(producers, messages);
+        double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        report("sync", total, static_cast<uint64_t>(total), producerMs, totalMs);
+    }
+
+    // Async: producers copy into the ring, one writer batches
+    {
+        Logger::startAsync(1 << 16);
+        uint64_t droppedBefore = Logger::getDroppedCount();
+
+        auto t0 = Clock::now();
+        double producerMs = runProducers(producers, messages);
+        Logger::flush();
+        double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        Logger::stopAsync();
+
+        const uint64_t dropped = Logger::getDroppedCount() - droppedBefore;
+        report("async", total, static_cast<uint64_t>(total) - dropped, producerMs, totalMs);
+        std::printf("  async dropped: %llu of %d\n", static_cast<unsigned long long>(dropped), total);
+    }
+
+    // Filtered out at compile time: the message is never built
+    {
+        auto t0 = Clock::now();
+        for (int i = 0; i < total; ++i)
+            LOG_DEBUG("never built " + std::to_string(i));
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        std::printf("  LOG_DEBUG (filtered) %.2f ns/msg\n", ms * 1e6 / total);
+    }
+
+    return 0;
+}
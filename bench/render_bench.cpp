@@ -0,0 +1,236 @@
+// bench/render_bench.cpp
+// Renderer CPU cost without a GPU: runs Renderer::renderFrame against
+// RecordingDevice (no GL context, no window) on a synthetic frame.
+//
+// Reports:
+//   • CPU time per renderFrame (BenchHarness: p50/p90/p99, frames/s)
+//   • per-frame command counts: device calls, draw calls, vertices,
+//     state changes (redundant ones), uniform updates/lookups,
+//     uploads and uploaded bytes
+//   • a hash of the steady-state command stream
+//
+// The counts and the hash are deterministic for a given set of
+// options, so the bench doubles as a regression check:
+//   --expect-hash <hex>  exit 1 if the command stream changed
+//   --capture <file>     write that frame's commands as text (diffable)
+//   --redraw             the same frame every time (as when only the
+//                        camera moves): points and images stay uploaded
+//
+// Must run from the repository root (shaders are read from
+// resources/shaders; their text is hashed, nothing is compiled).
+//
+// Usage: kitti_render_bench [--points n] [--image WxH] [--cameras n]
+//                           [--trajectory n] [--lit] [--budget n] [--seconds s]
+//                           [--redraw] [--capture file] [--expect-hash hex]
+//                           [--json out.json] [--label text]
+
+#include "BenchHarness.h"
+
+#include "core/FrameArena.h"
+#include "data/CameraImage.h"
+#include "data/PointCloud.h"
+#include "data/Trajectory.h"
+#include "input/Camera.h"
+#include "rendering/RecordingDevice.h"
+#include "rendering/Renderer.h"
+#include "utils/Logger.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    struct Scene
+    {
+        PointCloud cloud;
+        std::vector<uint32_t> normals;   // packed 10:10:10:2 (+Z)
+        CameraImage images[CameraImage::kCameraCount];
+        int imageCount = 1;
+        int imageWidth = 1242;
+        int imageHeight = 375;
+        Trajectory trajectory;
+    };
+
+    void buildScene(Scene& scene, int points, int trajectoryPoints)
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        std::vector<PointCloud::Point> pts(points);
+        for (auto& p : pts)
+        {
+            float azimuth = unit(rng) * 6.2831853f;
+            float range = 2.0f + unit(rng) * 60.0f;
+            p = { range * std::cos(azimuth), range * std::sin(azimuth), -1.7f + unit(rng) * 3.0f, unit(rng) };
+        }
+        scene.cloud.setPoints(std::move(pts));
+
+        // (0, 0, 511) in 10:10:10:2 snorm
+        scene.normals.assign(points, 511u << 20);
+
+        for (int c = 0; c < scene.imageCount; ++c)
+        {
+            CameraImage& image = scene.images[c];
+            image.camera = (c + 2) % CameraImage::kCameraCount;
+            image.width = scene.imageWidth;
+            image.height = scene.imageHeight;
+            image.pixels.resize(static_cast<size_t>(scene.imageWidth) * scene.imageHeight * 3);
+            for (size_t i = 0; i < image.pixels.size(); ++i)
+                image.pixels[i] = static_cast<unsigned char>(i * 31 + c);
+        }
+
+        // Whole path at once, vehicle at its end (100k+ is simplified)
+        std::vector<glm::vec3> path(trajectoryPoints);
+        for (int i = 0; i < trajectoryPoints; ++i)
+            path[i] = glm::vec3(i * 0.8f, std::sin(i * 0.01f) * 20.0f, 0.0f);
+        scene.trajectory.build(std::move(path));
+        scene.trajectory.setCurrentFrame(trajectoryPoints - 1);
+    }
+
+    void printCounters(const RecordingDevice::Counters& c)
+    {
+        std::printf("  device calls        %llu\n", static_cast<unsigned long long>(c.calls));
+        std::printf("  draw calls          %llu (%llu vertices)\n",
+                    static_cast<unsigned long long>(c.drawCalls), static_cast<unsigned long long>(c.vertices));
+        std::printf("  state changes       %llu (%llu redundant)\n",
+                    static_cast<unsigned long long>(c.stateChanges),
+                    static_cast<unsigned long long>(c.redundantStateChanges));
+        std::printf("  uniform updates     %llu (%llu location lookups)\n",
+                    static_cast<unsigned long long>(c.uniformUpdates),
+                    static_cast<unsigned long long>(c.uniformLookups));
+        std::printf("  uploads             %llu calls, %.2f MB, %llu buffer allocations\n",
+                    static_cast<unsigned long long>(c.uploadCalls), c.uploadBytes / (1024.0 * 1024.0),
+                    static_cast<unsigned long long>(c.bufferAllocations));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Bench::Options options;
+    options.threadCounts = { 1 };
+
+    int points = 120000;
+    int trajectoryPoints = 4541;
+    bool lit = false;
+    bool redraw = false;
+    size_t budget = 0;
+    std::string capturePath, expectHash, jsonPath, label = "kitti_render_bench";
+    Scene scene;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--points") && hasValue)            points = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--trajectory") && hasValue)   trajectoryPoints = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--image") && hasValue)
+        {
+            if (std::sscanf(argv[++i], "%dx%d", &scene.imageWidth, &scene.imageHeight) != 2)
+                scene.imageWidth = scene.imageHeight = 0;
+        }
+        else if (!std::strcmp(argv[i], "--cameras") && hasValue)      scene.imageCount = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--lit"))                      lit = true;
+        else if (!std::strcmp(argv[i], "--redraw"))                   redraw = true;
+        else if (!std::strcmp(argv[i], "--budget") && hasValue)       budget = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--seconds") && hasValue)      options.minSeconds = std::atof(argv[++i]);
+        else if (!std::strcmp(argv[i], "--capture") && hasValue)      capturePath = argv[++i];
+        else if (!std::strcmp(argv[i], "--expect-hash") && hasValue)  expectHash = argv[++i];
+        else if (!std::strcmp(argv[i], "--json") && hasValue)         jsonPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--label") && hasValue)        label = argv[++i];
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--points n] [--image WxH] [--cameras n] [--trajectory n] [--lit] "
+                                 "[--budget n] [--seconds s] [--redraw] [--capture file] [--expect-hash hex] [--json out.json] "
+                                 "[--label text]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (points < 0 || trajectoryPoints < 0 || scene.imageWidth < 0 || scene.imageHeight < 0 ||
+        scene.imageCount < 0 || scene.imageCount > CameraImage::kCameraCount)
+    {
+        std::fprintf(stderr, "Invalid sizes\n");
+        return 1;
+    }
+
+    Logger::enableConsole(false);
+
+    buildScene(scene, points, trajectoryPoints);
+
+    // Declared before the renderer, so it outlives the renderer's destructors
+    RecordingDevice device;
+    GpuDevice::setCurrent(&device);
+
+    Camera camera;
+    Renderer renderer;
+    renderer.init();
+    renderer.setCamera(&camera);
+    renderer.setPointShading(lit ? PointShading::Lit : PointShading::Intensity);
+    renderer.setPointBudget(budget);
+
+    // A new frame each time (content id 0), or one that stays on screen
+    const uint64_t contentId = redraw ? 1 : 0;
+    auto renderOnce = [&]()
+    {
+        renderer.renderFrame(camera, scene.cloud, scene.images, scene.imageCount,
+                             scene.trajectory, lit ? &scene.normals : nullptr, contentId);
+        FrameArena::mainThread().reset();
+    };
+
+    // First frames allocate buffers; the steady state starts after them
+    renderOnce();
+    renderOnce();
+
+    device.resetCounters();
+    device.setCapture(true);
+    renderOnce();
+    device.setCapture(false);
+    const RecordingDevice::Counters frame = device.counters();
+
+    char hash[32];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(device.captureHash()));
+
+    std::printf("Scene: %d points%s, %d camera image(s) %dx%d, trajectory %d points, budget %zu%s\n\n",
+                points, lit ? " (lit)" : "", scene.imageCount, scene.imageWidth, scene.imageHeight,
+                trajectoryPoints, budget, redraw ? ", redraw" : "");
+    std::printf("Per frame (steady state):\n");
+    printCounters(frame);
+    std::printf("  command stream      %zu commands, hash %s\n\n", device.commands().size(), hash);
+
+    if (!capturePath.empty())
+    {
+        if (!device.writeCapture(capturePath))
+        {
+            std::fprintf(stderr, "Failed to write %s\n", capturePath.c_str());
+            return 1;
+        }
+        std::printf("Command stream written to %s\n\n", capturePath.c_str());
+    }
+    device.clearCapture();
+
+    const double uploadBytes = static_cast<double>(frame.uploadBytes);
+    Bench::Runner runner(options);
+    Bench::Runner::printHeader();
+    runner.runSingle("renderer.renderFrame", 1.0, uploadBytes, [&](int) { renderOnce(); });
+
+    if (!jsonPath.empty())
+    {
+        if (!runner.writeJson(jsonPath, label))
+        {
+            std::fprintf(stderr, "Failed to write %s\n", jsonPath.c_str());
+            return 1;
+        }
+        std::printf("\nResults written to %s\n", jsonPath.c_str());
+    }
+
+    if (!expectHash.empty() && expectHash != hash)
+    {
+        std::fprintf(stderr, "\nCommand stream changed: expected %s, got %s\n", expectHash.c_str(), hash);
+        return 1;
+    }
+    return 0;
+}
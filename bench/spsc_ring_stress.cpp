@@ -0,0 +1,166 @@
+// bench/spsc_ring_stress.cpp
+// Stress test for SpscRing: ordering/loss checks under contention and
+// the pooled-buffer round trip used by FramePipeline. Meant to be run
+// under ThreadSanitizer as well as in release builds.
+//
+// Usage: kitti_spsc_stress [items]   (default: 5,000,000)
+
+#include "core/SpscRing.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// ------------------------------------------------------------
+// 1) Sequence numbers through a tiny ring: every item arrives
+//    exactly once and in order
+// ------------------------------------------------------------
+static bool stressSequence(uint64_t items, size_t capacity)
+{
+    SpscRing<uint64_t> ring(capacity);
+
+    auto t0 = Clock::now();
+    std::thread producer([&ring, items]()
+    {
+        for (uint64_t i = 0; i < items; ++i)
+        {
+            while (!ring.tryPush(i))
+                std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    bool ok = true;
+    while (expected < items)
+    {
+        uint64_t value;
+        if (!ring.tryPop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        if (value != expected)
+        {
+            std::printf("  FAIL: got %llu, expected %llu\n",
+                        (unsigned long long)value, (unsigned long long)expected);
+            ok = false;
+            break;
+        }
+        ++expected;
+    }
+
+    producer.join();
+    double ms = msSince(t0);
+
+    std::printf("  sequence  cap %4zu  %10llu items  %8.1f ms  %6.1f Mitems/s  %s\n",
+                ring.capacity(), (unsigned long long)items, ms,
+                items / (ms * 1e3), ok ? "ok" : "FAILED");
+    return ok;
+}
+
+// ------------------------------------------------------------
+// 2) Buffer pool round trip (ready + free rings), with payload
+//    written by the producer and verified by the consumer
+// ------------------------------------------------------------
+struct Payload
+{
+    uint64_t id = 0;
+    std::vector<uint32_t> data;
+};
+
+static bool stressPool(uint64_t frames, int poolSize)
+{
+    std::vector<std::unique_ptr<Payload>> pool;
+    SpscRing<Payload*> ready(poolSize);
+    SpscRing<Payload*> freeList(poolSize);
+
+    for (int i = 0; i < poolSize; ++i)
+    {
+        pool.push_back(std::make_unique<Payload>());
+        freeList.tryPush(pool.back().get());
+    }
+
+    std::atomic<uint64_t> backpressureWaits{0};
+
+    auto t0 = Clock::now();
+    std::thread producer([&]()
+    {
+        for (uint64_t f = 0; f < frames; ++f)
+        {
+            Payload* p = nullptr;
+            while (!freeList.tryPop(p))
+            {
+                backpressureWaits.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+
+            p->id = f;
+            p->data.resize(64 + (f % 64));
+            for (size_t i = 0; i < p->data.size(); ++i)
+                p->data[i] = static_cast<uint32_t>(f * 31 + i);
+
+            while (!ready.tryPush(std::move(p)))
+                std::this_thread::yield();
+        }
+    });
+
+    bool ok = true;
+    for (uint64_t f = 0; f < frames && ok; )
+    {
+        Payload* p = nullptr;
+        if (!ready.tryPop(p))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (p->id != f || p->data.size() != 64 + (f % 64))
+            ok = false;
+        for (size_t i = 0; ok && i < p->data.size(); ++i)
+            ok = p->data[i] == static_cast<uint32_t>(f * 31 + i);
+        if (!ok)
+            std::printf("  FAIL: corrupt payload at frame %llu\n", (unsigned long long)f);
+
+        freeList.tryPush(std::move(p));
+        ++f;
+    }
+
+    producer.join();
+    double ms = msSince(t0);
+
+    std::printf("  pool      %d bufs  %10llu frames  %8.1f ms  backpressure waits %llu  %s\n",
+                poolSize, (unsigned long long)frames, ms,
+                (unsigned long long)backpressureWaits.load(), ok ? "ok" : "FAILED");
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t items = 5000000;
+    if (argc > 1)
+        items = std::strtoull(argv[1], nullptr, 10);
+
+    std::printf("SpscRing stress\n");
+
+    bool ok = true;
+    ok &= stressSequence(items, 2);
+    ok &= stressSequence(items, 64);
+    ok &= stressSequence(items, 1024);
+    ok &= stressPool(items / 10, 2);
+    ok &= stressPool(items / 10, 4);
+
+    std::printf(ok ? "PASSED\n" : "FAILED\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+
+// ------------------------------------------------------------
+// AllocCounter
+// ------------------------------------------------------------
+// Counts heap allocations made through global operator new, per
+// thread, per PROFILE_SCOPE and process-wide. Opt-in: the operator
+// new replacement is only compiled with KITTI_TRACK_ALLOCS (CMake
+// option of the same name); otherwise every query returns zeros and
+// costs nothing.
+//
+// Responsibilities:
+//   ✓ Allocation / free counts and requested bytes per thread
+//   ✓ Attribution to the innermost open scope on the allocating
+//     thread (PROFILE_SCOPE opens one in tracking builds)
+//   ✓ No-allocation regions: count, or abort on, any allocation the
+//     calling thread makes between begin/endNoAllocRegion()
+//
+// Usage (per-frame allocation count):
+//   auto before = AllocCounter::thisThread();
+//   ... frame ...
+//   uint64_t allocs = AllocCounter::thisThread().allocations - before.allocations;
+//
+// Usage (steady-state check):
+//   AllocCounter::beginNoAllocRegion(false);
+//   ... frame ...
+//   AllocCounter::Violation v = AllocCounter::endNoAllocRegion();
+//   if (v.allocations) ... v.firstScope allocated v.firstBytes first
+//
+// The hooks run inside operator new: nothing here may allocate, lock
+// or log. Scope names must be string literals (only the pointer is
+// kept).
+// ------------------------------------------------------------
+
+namespace AllocCounter
+{
+    struct Counts
+    {
+        uint64_t allocations = 0;
+        uint64_t frees       = 0;
+        uint64_t bytes       = 0;   // requested bytes
+    };
+
+    // Process-wide totals of one scope (nullptr name: outside any scope)
+    struct ScopeCounts
+    {
+        const char* name = nullptr;
+        uint64_t allocations = 0;
+        uint64_t bytes       = 0;
+    };
+
+    // Allocations seen inside a no-allocation region
+    struct Violation
+    {
+        uint64_t    allocations = 0;
+        uint64_t    bytes       = 0;
+        const char* firstScope  = nullptr;   // scope of the first one
+        uint64_t    firstBytes  = 0;
+    };
+
+    // True when built with KITTI_TRACK_ALLOCS
+    bool isEnabled();
+
+    // Totals of the calling thread since it started
+    Counts thisThread();
+
+    // Totals across all threads
+    Counts global();
+
+    // Per-scope totals, most allocations first; returns how many
+    // were written
+    int scopeSnapshot(ScopeCounts* out, int capacity);
+
+    // Innermost open scope of the calling thread (nullptr if none)
+    const char* currentScope();
+
+    // Calling thread only. With abortOnAlloc the first allocation
+    // prints its scope and size to stderr and calls std::abort(), so
+    // the debugger / core dump shows the allocating stack.
+    void beginNoAllocRegion(bool abortOnAlloc);
+    Violation endNoAllocRegion();
+
+    namespace detail
+    {
+        extern thread_local const char* t_scope;
+        extern thread_local int         t_allowDepth;
+    }
+
+    // ------------------------------------------------------------
+    // RAII attribution scope (opened by PROFILE_SCOPE)
+    // ------------------------------------------------------------
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name) : m_previous(detail::t_scope) { detail::t_scope = name; }
+        ~Scope() { detail::t_scope = m_previous; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_previous;
+    };
+
+    // ------------------------------------------------------------
+    // RAII exemption: allocations inside are expected (user actions,
+    // periodic logging) and do not count against a no-alloc region
+    // ------------------------------------------------------------
+    class AllowAllocs
+    {
+    public:
+        AllowAllocs() { ++detail::t_allowDepth; }
+        ~AllowAllocs() { --detail::t_allowDepth; }
+
+        AllowAllocs(const AllowAllocs&) = delete;
+        AllowAllocs& operator=(const AllowAllocs&) = delete;
+    };
+}
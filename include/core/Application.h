@@ -1,16 +1,37 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
+#include <glm/glm.hpp>
 
+#include "JobSystem.h"
+#include "AllocCounter.h"
+#include "BufferPool.h"
+#include "ReplayBenchmark.h"
+#include "ThumbnailStrip.h"
+
+class Config;
 class Window;
 class Renderer;
+class GlDevice;
 class InputHandler;
 class Camera;
 class IKittiLoader;
 class Trajectory;
-class SteeringWheelRenderer;
+class NormalEstimator;
+class ScanDeskewer;
+class KdTree;
+class FrameStats;
+class PlaybackClock;
+class PointBudgetController;
+class PointCloud;
+class FramePipeline;
+class PerfOverlay;
+struct FrameData;
 
 class Application
 {
@@ -18,32 +39,158 @@ public:
     Application();
     ~Application();
 
-    bool init(const std::string& configPath);
+    // Settings, window, loaders, renderers, input; false on failure
+    bool initialize(const std::string& configPath);
     void run();
-    void shutdown();
+    // Stops background work and releases everything (also on destruction)
+    void cleanup();
+
+    // Before init: a setting that wins over the config file
+    void overrideSetting(const std::string& key, const std::string& value);
+
+    // Before init: hidden window, no vsync, no overlay; then
+    // runBenchmark() replays the frame range instead of run()
+    void enableBenchmark(const ReplayBenchmark::Options& options);
+    bool runBenchmark();
 
 private:
-    bool loadSettings(const std::string& configPath);
-    bool setupWindow();
-    bool setupCoreSystems();
-    bool setupRenderers();
-    bool setupInput();
+    // Manual stepping (arrow keys) within the active sequence
+    void nextFrame();
+    void prevFrame();
+
+    // Picking: background kd-tree build + mouse-ray query
+    void updatePickIndex(const FrameData& frame);
+    void pickPoint();
+    // Once per loop iteration; 'presented' = a frame was drawn
+    void reportStats(bool presented = true);
+    void deskewCloud(FrameData& frame);
+
+    // Profiler capture (F9): start, or stop and write the trace
+    void toggleTraceCapture();
 
-    void updateFrame();
-    void updateSimulation();
-    void render();
+    // ImGui performance panel (F1), drawn over the scene
+    void renderOverlay();
+
+    // Loader thread: per-frame stages (deskew, normals)
+    void prepareFrame(FrameData& frame);
+    // Render thread: a new frame became current
+    void onFrameArrived(const FrameData& frame);
+    // Whole path of a sequence from its poses, once per sequence
+    void buildTrajectory(IKittiLoader& loader);
+    void updatePlayback();
+    // Timeline (drag along the bottom edge): seek with a thumbnail
+    // preview until the full frame is on screen
+    void updateTimeline();
+    void seekTo(int frame);
+    void endSeek();
+    // Comparison sequences (Tab)
+    IKittiLoader& activeLoader() const;
+    void updateHiddenStreams();
+    void switchSequence();
+    void waitForWork();
+    void updatePointBudget(double cpuFrameMs);
+    // Reset the frame arena, record arena use and heap allocations
+    void endFrameMemory(const AllocCounter::Counts& atFrameStart);
+    // Pool usage → MemoryBudget, evict if over budget, mem_* stats
+    void updateMemoryBudget();
+    // alloc_check: no-allocation region around each steady-state frame
+    void beginAllocCheck();
+    void endAllocCheck();
+    // Heap allocations by PROFILE_SCOPE (tracking builds, at exit)
+    void logAllocScopes();
 
 private:
+    std::unique_ptr<Config> m_config;
     std::unique_ptr<Window> m_window;
+    std::unique_ptr<IKittiLoader> m_loader;
+    std::unique_ptr<GlDevice> m_gpuDevice;   // current GpuDevice while the renderer lives
     std::unique_ptr<Renderer> m_renderer;
     std::unique_ptr<InputHandler> m_inputHandler;
     std::unique_ptr<Camera> m_camera;
-    std::unique_ptr<IKittiLoader> m_dataLoader;
     std::unique_ptr<Trajectory> m_trajectory;
-    std::unique_ptr<SteeringWheelRenderer> m_wheelRenderer;
+    std::vector<glm::mat4> m_knownPoses;   // scratch: estimated poses not yet on the path
+    std::unique_ptr<NormalEstimator> m_normalEstimator;   // only when lit shading is on
+    std::unique_ptr<ScanDeskewer> m_deskewer;             // only when deskew is on
 
     int m_currentFrame = 0;
-    int m_totalFrames  = 0;
 
-    std::string m_datasetPath;
+    // Frames prepared on the loader thread; m_displayed stays on
+    // screen until the next requested frame is ready
+    std::unique_ptr<FramePipeline> m_pipeline;
+    FrameData* m_displayed = nullptr;
+
+    // Sequences opened for comparison (compare_sequences) are streams
+    // 1.. of m_pipeline, sharing its loader thread and buffers. Tab
+    // cycles the displayed stream; the others keep their latest frame
+    // at the same index so switching is immediate.
+    std::vector<std::unique_ptr<IKittiLoader>> m_compareLoaders;
+    std::vector<FrameData*> m_streamFrames;   // per stream; null for the displayed one
+    int m_activeStream = 0;
+
+    // Event-driven loop: redraw only when something changed
+    bool   m_eventDriven = false;
+    bool   m_dirty       = true;
+    double m_idleTimeout = 0.5;   // seconds, upper bound on a sleep
+
+    // Pick index for the current frame, built as a JobSystem job.
+    // Trees and the cloud snapshots they are built from are recycled,
+    // so rebuilding every frame reuses the same storage.
+    std::unique_ptr<BufferPool<KdTree>>     m_kdTreePool;
+    std::unique_ptr<BufferPool<PointCloud>> m_snapshotPool;
+    int m_kdTreeMemoryId   = -1;   // MemoryBudget ids of the pools
+    int m_snapshotMemoryId = -1;
+
+    struct KdTreeBuild
+    {
+        BufferPool<KdTree>::Handle     tree;
+        BufferPool<PointCloud>::Handle snapshot;
+        double buildMs = 0.0;
+        int frame = -1;
+        int stream = 0;
+    };
+    std::shared_ptr<KdTreeBuild> m_kdTreeBuild;   // written by the job
+    JobSystem::TaskHandle        m_kdTreeJob;
+    BufferPool<KdTree>::Handle   m_kdTree;
+    int   m_kdTreeFrame     = -1;
+    int   m_kdTreeStream    = 0;    // FramePipeline stream of that frame
+    float m_pickRadiusPx    = 6.0f;   // pick cone, in screen pixels
+    float m_pickQueryRadius = 1.0f;   // metres, radius query around the hit
+
+    // Timeline: thumbnails per stream (empty when timeline = false).
+    // m_preview stands in for the frame being seeked to until it
+    // arrives; seek_ms runs from the seek to that frame's swap.
+    std::vector<std::unique_ptr<ThumbnailStrip>> m_thumbnails;
+    const ThumbnailStrip::Thumbnail* m_preview = nullptr;
+    float m_timelineHeight = 28.0f;   // px
+    bool  m_seekPending = false;      // waiting for the seeked frame
+    bool  m_seekLanded  = false;      // it arrived, record after the swap
+    int   m_seekFrame   = -1;
+    std::chrono::steady_clock::time_point m_seekStart;
+    float    m_seekTargetMs = 50.0f;
+    uint64_t m_slowSeeks    = 0;
+
+    // Timed playback (space); arrow keys step manually and pause it
+    std::unique_ptr<PlaybackClock> m_playback;
+    uint64_t m_droppedReported = 0;   // active stream's dropped frames at the last report
+
+    // Adaptive point budget (only when target_frame_ms > 0)
+    std::unique_ptr<PointBudgetController> m_pointBudget;
+    size_t m_lastPointCount  = 0;
+    double m_lastGpuFrameMs  = 0.0;
+
+    std::unique_ptr<FrameStats> m_stats;
+    std::unique_ptr<PerfOverlay> m_overlay;   // null when perf_overlay = false
+    float m_statsInterval = 1.0f;     // seconds, 0 = off
+
+    std::string m_tracePath = "kitti_trace.json";
+
+    // Steady-state allocation check (alloc_check)
+    bool     m_allocCheck        = false;
+    bool     m_allocCheckAbort   = false;
+    bool     m_allocCheckArmed   = false;
+    int      m_allocCheckWarmup  = 0;   // frames left before checking
+    uint64_t m_allocViolations   = 0;
+
+    std::vector<std::pair<std::string, std::string>> m_settingOverrides;
+    std::unique_ptr<ReplayBenchmark> m_benchmark;   // headless replay mode
 };
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// ------------------------------------------------------------
+// BufferPool
+// ------------------------------------------------------------
+// Recycles large, long-lived buffer objects (point clouds, kd-trees,
+// image buffers) instead of allocating a fresh one per frame.
+//
+//   BufferPool<PointCloud> pool(2, [](PointCloud& c) { c.reserve(131072); });
+//   BufferPool<PointCloud>::Handle cloud = pool.acquire();
+//   ...                         // handle going away returns it
+//
+// Objects keep their contents and capacity between uses, so a
+// consumer that refills them (assign, resize, parseInto) reaches
+// a steady state with no allocations and no fresh page faults.
+//
+// acquire() creates a new object only when the pool is empty;
+// handles may be released from any thread. The pool must outlive
+// all handles.
+//
+// Memory accounting (optional): with a SizeFn, each object is
+// measured when created and whenever it comes back (never while in
+// use), and getBytes() sums the latest sizes. trim() deletes idle
+// objects, e.g. from a MemoryBudget eviction callback.
+// ------------------------------------------------------------
+
+template <typename T>
+class BufferPool
+{
+public:
+    // Returns the object to its pool instead of deleting it
+    struct Returner
+    {
+        BufferPool* pool = nullptr;
+        void operator()(T* object) const
+        {
+            if (pool && object)
+                pool->giveBack(object);
+        }
+    };
+
+    using Handle = std::unique_ptr<T, Returner>;
+    using InitFn = std::function<void(T&)>;
+    using SizeFn = std::function<size_t(const T&)>;
+
+public:
+    // Pre-create 'preallocate' objects, each passed through init
+    explicit BufferPool(size_t preallocate = 0, InitFn init = InitFn())
+        : m_init(std::move(init))
+    {
+        m_all.reserve(preallocate);
+        m_free.reserve(preallocate);
+        for (size_t i = 0; i < preallocate; ++i)
+            m_free.push_back(create());
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    // Measures idle objects now; later on return
+    void setSizeFn(SizeFn size)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_size = std::move(size);
+        m_bytes = 0;
+        for (Slot& slot : m_all)
+        {
+            if (isFree(slot.object.get()))
+                slot.bytes = measure(*slot.object);
+            m_bytes += slot.bytes;
+        }
+    }
+
+    Handle acquire()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        T* object = nullptr;
+        if (!m_free.empty())
+        {
+            object = m_free.back();
+            m_free.pop_back();
+            m_hits++;
+        }
+        else
+        {
+            object = create();
+            m_misses++;
+        }
+
+        return Handle(object, Returner{ this });
+    }
+
+    size_t getCreatedCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_all.size();
+    }
+
+    size_t getAvailableCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_free.size();
+    }
+
+    // Sum of the last measured object sizes (0 without a SizeFn)
+    size_t getBytes() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bytes;
+    }
+
+    // Delete idle objects until at most 'keepIdle' remain; returns
+    // the bytes they accounted for
+    size_t trim(size_t keepIdle = 0)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        size_t released = 0;
+        while (m_free.size() > keepIdle)
+        {
+            T* object = m_free.back();
+            m_free.pop_back();
+
+            for (size_t i = 0; i < m_all.size(); ++i)
+            {
+                if (m_all[i].object.get() != object)
+                    continue;
+
+                released += m_all[i].bytes;
+                m_all[i] = std::move(m_all.back());
+                m_all.pop_back();
+                break;
+            }
+        }
+        m_bytes -= released;
+        return released;
+    }
+
+    // acquire() calls served from the pool / that had to create
+    uint64_t getHits() const { std::lock_guard<std::mutex> lock(m_mutex); return m_hits; }
+    uint64_t getMisses() const { std::lock_guard<std::mutex> lock(m_mutex); return m_misses; }
+
+private:
+    struct Slot
+    {
+        std::unique_ptr<T> object;
+        size_t bytes = 0;   // as of the last measurement
+    };
+
+    T* create()
+    {
+        m_all.push_back(Slot{ std::make_unique<T>(), 0 });
+        Slot& slot = m_all.back();
+        if (m_init)
+            m_init(*slot.object);
+        slot.bytes = measure(*slot.object);
+        m_bytes += slot.bytes;
+        return slot.object.get();
+    }
+
+    void giveBack(T* object)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free.push_back(object);
+
+        if (!m_size)
+            return;
+        for (Slot& slot : m_all)
+        {
+            if (slot.object.get() != object)
+                continue;
+            size_t bytes = measure(*object);
+            m_bytes = m_bytes - slot.bytes + bytes;
+            slot.bytes = bytes;
+            break;
+        }
+    }
+
+    size_t measure(const T& object) const { return m_size ? m_size(object) : 0; }
+
+    bool isFree(const T* object) const
+    {
+        for (const T* idle : m_free)
+            if (idle == object)
+                return true;
+        return false;
+    }
+
+private:
+    InitFn m_init;
+    SizeFn m_size;
+
+    mutable std::mutex m_mutex;
+    std::vector<Slot> m_all;    // owns every object
+    std::vector<T*>   m_free;
+    size_t            m_bytes = 0;
+
+    uint64_t m_hits   = 0;
+    uint64_t m_misses = 0;
+};
@@ -6,21 +6,23 @@
 class Config
 {
 public:
-    Config() = default;
+    explicit Config(const std::string& filepath);
     ~Config() = default;
 
-    // Load a .ini or .cfg style configuration file
-    bool loadFromFile(const std::string& filepath);
+    // Load the .ini / .cfg style file given at construction
+    bool load();
 
     // Getters for configuration values
     std::string getString(const std::string& key, const std::string& defaultValue = "") const;
     int         getInt(const std::string& key, int defaultValue = 0) const;
     float       getFloat(const std::string& key, float defaultValue = 0.0f) const;
     bool        getBool(const std::string& key, bool defaultValue = false) const;
+    bool        has(const std::string& key) const;
 
-private:
-    void parseLine(const std::string& line);
+    // Override a value (command-line settings win over the file)
+    void set(const std::string& key, const std::string& value);
 
 private:
+    std::string m_filepath;
     std::unordered_map<std::string, std::string> m_values;
 };
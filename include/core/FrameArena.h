@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// ------------------------------------------------------------
+// FrameArena
+// ------------------------------------------------------------
+// Bump allocator for data that only lives until the end of the
+// current frame (upload staging, per-frame scratch arrays).
+//
+//   float* buf = FrameArena::mainThread().allocArray<float>(n * 4);
+//   ...
+//   FrameArena::mainThread().reset();   // once, at frame end
+//
+// Responsibilities:
+//   ✓ One reserved block, allocation = pointer bump
+//   ✓ Optional transparent huge pages (Linux, madvise)
+//   ✓ Overflow into heap blocks instead of failing; they are freed
+//     on reset and reported so the capacity can be raised
+//   ✓ High-water mark for sizing
+//
+// Only trivially destructible types: reset() runs no destructors.
+// Not thread-safe; the main-thread instance belongs to the thread
+// that renders.
+// ------------------------------------------------------------
+
+class FrameArena
+{
+public:
+    static constexpr size_t kDefaultCapacity = 16u << 20;   // 16 MB
+
+public:
+    // Arena used by the render thread; configure() before first use
+    static FrameArena& mainThread();
+
+    FrameArena() = default;
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // (Re)reserve the backing block; drops everything allocated
+    bool configure(size_t capacityBytes, bool useHugePages);
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    template <typename T>
+    T* allocArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "FrameArena never runs destructors");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Release everything allocated this frame
+    void reset();
+
+    size_t getUsed() const { return m_offset + m_overflowBytes; }
+    size_t getCapacity() const { return m_capacity; }
+    size_t getHighWater() const { return m_highWater; }
+    bool   usesHugePages() const { return m_hugePages; }
+
+    // Heap fallbacks since the last reset (0 when correctly sized)
+    size_t getOverflowCount() const { return m_overflow.size(); }
+
+private:
+    void release();
+
+private:
+    uint8_t* m_base     = nullptr;
+    size_t   m_capacity = 0;
+    size_t   m_offset   = 0;
+    size_t   m_highWater = 0;
+    bool     m_mapped    = false;   // mmap'd (else malloc'd)
+    bool     m_hugePages = false;
+
+    std::vector<void*> m_overflow;
+    size_t m_overflowBytes = 0;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ------------------------------------------------------------
+// FrameStats
+// ------------------------------------------------------------
+// Collects named per-frame measurements (timings in ms, counters)
+// and produces a periodic one-line summary for the log.
+//
+// Usage:
+//   stats.record("kdtree_build_ms", ms);
+//   stats.endFrame();
+//   if (stats.reportDue(1.0)) { Logger::info(stats.summary()); stats.resetInterval(); }
+//
+// Names must be string literals (or otherwise outlive the stats
+// object); they are stored by pointer so recording never allocates
+// once a name has been seen.
+// ------------------------------------------------------------
+
+class FrameStats
+{
+public:
+    struct Entry
+    {
+        const char* name = nullptr;
+        double   last    = 0.0;
+        double   sum     = 0.0;   // since last report
+        double   max     = 0.0;   // since last report
+        uint32_t samples = 0;     // since last report
+    };
+
+public:
+    FrameStats();
+    ~FrameStats() = default;
+
+    // Record one sample for a named value
+    void record(const char* name, double value);
+
+    // Latest value of a named entry (fallback if never recorded)
+    double get(const char* name, double fallback = 0.0) const;
+
+    // Marks the end of a rendered frame (drives FPS)
+    void endFrame();
+
+    // True once intervalSeconds have passed since the last reset
+    bool reportDue(double intervalSeconds) const;
+
+    // "fps=59.8 | kdtree_build_ms=3.10 (avg 3.05, max 3.40) | ..."
+    std::string summary() const;
+
+    // Start a new reporting interval (keeps last values)
+    void resetInterval();
+
+    const std::vector<Entry>& entries() const { return m_entries; }
+    double fps() const;
+
+private:
+    Entry* find(const char* name);
+    const Entry* find(const char* name) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<Entry> m_entries;
+    Clock::time_point  m_intervalStart;
+    uint32_t           m_framesInInterval = 0;
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ------------------------------------------------------------
+// JobSystem
+// ------------------------------------------------------------
+// Process-wide work-stealing thread pool. Every CPU stage that
+// wants parallelism (loading, decoding, normal estimation, ICP,
+// index builds) submits work here instead of spawning threads.
+//
+// Features:
+//   ✓ Per-worker deques: owner pushes/pops LIFO, idle workers
+//     steal FIFO from the others
+//   ✓ Task graphs: submit(job, {deps...}) runs once all
+//     dependencies have finished
+//   ✓ parallelFor over index ranges; the calling thread works too
+//   ✓ wait() runs the awaited job (and its queued dependencies)
+//     inline instead of blocking, but never unrelated jobs
+//   ✓ Main-thread queue for work that needs the GL context
+//
+// Usage:
+//   JobSystem& jobs = JobSystem::instance();
+//   auto a = jobs.submit([]{ ... });
+//   auto b = jobs.submit([]{ ... }, { a });
+//   jobs.parallelFor(0, n, 1024, [&](size_t begin, size_t end) { ... });
+//   jobs.postToMainThread([]{ glBufferData(...); });
+//   jobs.wait(b);
+//
+// Before start() (or with 0 workers) everything runs inline on
+// the calling thread, so stages stay usable in tools and tests.
+// While stop() runs, submit() rejects work (invalid handle);
+// afterwards jobs run inline again.
+// ------------------------------------------------------------
+
+class JobSystem
+{
+public:
+    using Job = std::function<void()>;
+    using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+private:
+    struct Task;
+    using TaskPtr = std::shared_ptr<Task>;
+
+public:
+    // Handle to a submitted job; usable as a dependency
+    class TaskHandle
+    {
+    public:
+        TaskHandle() = default;
+
+        bool valid() const { return m_task != nullptr; }
+        bool isDone() const;
+
+    private:
+        friend class JobSystem;
+        explicit TaskHandle(TaskPtr task) : m_task(std::move(task)) {}
+
+        TaskPtr m_task;
+    };
+
+public:
+    static JobSystem& instance();
+
+    JobSystem();
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Launch workers. threadCount <= 0 → hardware_concurrency - 1
+    // (the main thread also executes jobs while it waits).
+    void start(int threadCount = 0);
+
+    // Reject further submits, finish queued jobs and join all workers
+    void stop();
+
+    int getWorkerCount() const { return m_workerCount.load(std::memory_order_acquire); }
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    // Schedule a job, optionally after other jobs finished. Returns
+    // an invalid handle (job not run) while stop() is in progress.
+    TaskHandle submit(Job job);
+    TaskHandle submit(Job job, std::initializer_list<TaskHandle> dependencies);
+    TaskHandle submit(Job job, const std::vector<TaskHandle>& dependencies);
+
+    // Block until the job finished. A queued job or dependency of it
+    // is run on the calling thread; other jobs are left to workers,
+    // so a short wait never picks up someone's long job.
+    void wait(const TaskHandle& handle);
+
+    // Run fn over [begin, end) in chunks of at most grain indices.
+    // Returns when every chunk has finished.
+    void parallelFor(size_t begin, size_t end, size_t grain, const RangeJob& fn);
+
+    // Queue work for the thread that owns the GL context
+    void postToMainThread(Job job);
+
+    // Run queued main-thread jobs (call once per frame from the
+    // main loop). Returns how many ran.
+    size_t runMainThreadJobs(size_t maxJobs = static_cast<size_t>(-1));
+
+    // Jobs queued but not yet started (for stats)
+    int getPendingJobCount() const { return m_pendingJobs.load(std::memory_order_relaxed); }
+
+private:
+    struct Task
+    {
+        Job job;
+        std::atomic<int>  remainingDeps{1};   // +1 held by submit()
+        std::atomic<bool> claimed{false};     // set by whoever runs it
+        std::atomic<bool> done{false};
+
+        std::mutex continuationMutex;
+        std::vector<TaskPtr> continuations;
+        std::vector<TaskPtr> dependencies;    // unfinished at submit, for wait()
+    };
+
+    struct alignas(64) WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<TaskPtr> tasks;
+    };
+
+    TaskHandle submitTask(TaskPtr task, const TaskHandle* deps, size_t depCount);
+    void schedule(TaskPtr task);
+    // Notify sleeping workers, if any (one, or all on stop)
+    void wakeWorkers(bool all);
+    // Runs the task unless someone else claimed it first
+    bool execute(const TaskPtr& task);
+    void releaseDependency(const TaskPtr& task);
+
+    TaskPtr popLocal(int workerIndex);
+    TaskPtr steal(int thiefIndex);
+    TaskPtr findWork(int workerIndex);
+    // wait(): run the task or one of its queued dependencies inline
+    bool tryRunWithin(const TaskPtr& task);
+
+    void workerLoop(int workerIndex);
+
+private:
+    std::vector<std::thread> m_workers;
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;   // [workers] + shared injection queue
+
+    std::atomic<bool> m_running{false};
+    std::atomic<int>  m_workerCount{0};
+    std::atomic<bool> m_stopping{false};
+    std::atomic<int>  m_submitting{0};   // submits between the stop check and the push
+    std::atomic<int>  m_pendingJobs{0};
+    std::atomic<unsigned> m_nextQueue{0};
+
+    // Idle workers block on m_wake without a timeout. m_sleepers is
+    // raised under m_sleepMutex before a worker checks for work, so a
+    // scheduler that sees it zero is seen by that check.
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<int> m_sleepers{0};
+
+    std::mutex m_mainMutex;
+    std::deque<Job> m_mainThreadJobs;
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+// ------------------------------------------------------------
+// MemoryBudget
+// ------------------------------------------------------------
+// Process-wide accountant for large buffers. Every subsystem that
+// holds big allocations registers once and keeps its byte count up
+// to date; the accountant compares the totals against a host and a
+// GPU budget and asks subsystems to give memory back when a budget
+// is exceeded.
+//
+// Responsibilities:
+//   ✓ Per-subsystem usage (current + peak), per memory kind
+//   ✓ Host / GPU byte budgets (0 = unlimited)
+//   ✓ Eviction: enforce() calls the registered callbacks of the
+//     over-budget kind, highest priority first, until the
+//     estimated excess is covered
+//   ✓ Stat names per subsystem ("mem_<name>_mb") for FrameStats
+//
+// Usage:
+//   MemoryBudget& budget = MemoryBudget::instance();
+//   MemoryBudget::Id id = budget.add("frame_images", MemoryBudget::Host,
+//       [this](size_t excess) { return trimImages(excess); });
+//   budget.setUsage(id, bytes);          // any thread, lock-free
+//   budget.enforce();                    // render thread, once per frame
+//   budget.remove(id);
+//
+// Threading:
+//   • setUsage() may be called from any thread (atomic)
+//   • add/remove/enforce lock; callbacks run inside enforce() on
+//     the calling thread and must not call add() or remove().
+//     A callback that cannot free memory on that thread should
+//     schedule the work and return the bytes it expects to free.
+//   • enforce() asks again on every call while a budget stays
+//     exceeded, so callbacks must be cheap when nothing is left
+//
+// Names must be string literals (or outlive the accountant).
+// ------------------------------------------------------------
+
+class MemoryBudget
+{
+public:
+    enum Kind
+    {
+        Host,
+        Gpu,
+        KindCount
+    };
+
+    using Id = int;
+    static constexpr Id kInvalidId = -1;
+    static constexpr int kMaxSubsystems = 32;
+
+    // Asked to release about 'excessBytes'; returns the bytes it
+    // released (or will release shortly)
+    using EvictFn = std::function<size_t(size_t excessBytes)>;
+
+    struct Usage
+    {
+        const char* name = nullptr;
+        const char* statName = nullptr;   // "mem_<name>_mb"
+        Kind   kind  = Host;
+        size_t bytes = 0;
+        size_t peakBytes = 0;
+        uint64_t evictions = 0;           // callback invocations
+    };
+
+public:
+    static MemoryBudget& instance();
+
+    MemoryBudget() = default;
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    // 0 = unlimited
+    void setBudget(Kind kind, size_t bytes);
+    size_t getBudget(Kind kind) const { return m_budget[kind].load(std::memory_order_relaxed); }
+
+    // kInvalidId when all slots are taken (usage then goes untracked).
+    // Higher priority is evicted first.
+    Id add(const char* name, Kind kind, EvictFn evict = EvictFn(), int priority = 0);
+    void remove(Id id);
+
+    void setUsage(Id id, size_t bytes);
+
+    size_t getUsage(Id id) const;
+    size_t getTotal(Kind kind) const;
+
+    // Evicts while a budget is exceeded; returns callbacks invoked
+    int enforce();
+
+    uint64_t getEvictionCount() const { return m_evictionCount.load(std::memory_order_relaxed); }
+
+    // Registered subsystems; returns how many were written
+    int snapshot(Usage* out, int capacity) const;
+
+private:
+    struct Slot
+    {
+        std::atomic<bool>   used{false};
+        std::atomic<size_t> bytes{0};
+        std::atomic<size_t> peakBytes{0};
+        const char* name = nullptr;
+        char        statName[48] = {};
+        Kind        kind = Host;
+        int         priority = 0;
+        uint64_t    evictions = 0;
+        EvictFn     evict;
+    };
+
+    mutable std::mutex  m_mutex;   // add/remove/enforce/snapshot
+    Slot                m_slots[kMaxSubsystems];
+    std::atomic<size_t> m_budget[KindCount] = {};
+    std::atomic<uint64_t> m_evictionCount{0};
+    bool                m_overBudget[KindCount] = {};   // for log rate limiting
+};
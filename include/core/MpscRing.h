@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// ------------------------------------------------------------
+// MpscRing
+// ------------------------------------------------------------
+// Bounded lock-free queue for any number of producer threads and
+// exactly one consumer thread.
+//
+//   producers: tryPush(fill)    fill(T&) writes the slot in place
+//   consumer:  front() / pop()
+//
+// Every slot carries a sequence number (Vyukov's bounded queue):
+// producers claim a slot with one CAS on the tail, fill it, then
+// publish it by bumping its sequence. The consumer never races
+// with another consumer, so it needs no atomic RMW at all.
+//
+// Filling in place lets large fixed-size records (log lines) be
+// written straight into the ring without an intermediate copy.
+// Capacity is rounded up to a power of two; storage is allocated
+// once in the constructor.
+// ------------------------------------------------------------
+
+template <typename T>
+class MpscRing
+{
+public:
+    explicit MpscRing(size_t capacity)
+    {
+        size_t cap = 2;
+        while (cap < capacity)
+            cap <<= 1;
+
+        m_slots.reset(new Slot[cap]);
+        m_capacity = cap;
+        m_mask = cap - 1;
+
+        for (size_t i = 0; i < cap; ++i)
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    size_t capacity() const { return m_capacity; }
+
+    // ---------------- producer side ----------------
+
+    // Claims a slot and calls fill(T&) on it. False when full.
+    template <typename Fill>
+    bool tryPush(Fill&& fill)
+    {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+
+        while (true)
+        {
+            slot = &m_slots[pos & m_mask];
+            const size_t seq = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                return false;   // full: the consumer has not freed this slot yet
+            }
+            else
+            {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        fill(slot->value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ---------------- consumer side ----------------
+
+    // Oldest published element, or nullptr. Valid until pop().
+    T* front()
+    {
+        Slot& slot = m_slots[m_head & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != m_head + 1)
+            return nullptr;
+
+        return &slot.value;
+    }
+
+    // Release the element returned by front() back to producers
+    void pop()
+    {
+        Slot& slot = m_slots[m_head & m_mask];
+        slot.sequence.store(m_head + m_capacity, std::memory_order_release);
+        ++m_head;
+    }
+
+    // Consumer side; approximate while producers are pushing
+    size_t sizeApprox() const
+    {
+        return m_tail.load(std::memory_order_relaxed) - m_head;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence{0};
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_capacity = 0;
+    size_t m_mask = 0;
+
+    // Producer-shared
+    alignas(64) std::atomic<size_t> m_tail{0};
+
+    // Consumer-owned
+    alignas(64) size_t m_head = 0;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// ------------------------------------------------------------
+// PlaybackClock
+// ------------------------------------------------------------
+// Wall-clock driven playback position for a frame sequence.
+//
+// The frame to show is derived from elapsed time, not from how
+// many times the render loop ran:
+//
+//   frame = anchorFrame + floor(elapsed * baseRate * speed)
+//
+// so playback runs at the sensor rate (KITTI: 10 Hz) regardless
+// of display refresh. When loading or rendering falls behind, the
+// next target simply lies several frames ahead and the frames in
+// between are skipped (counted as dropped) instead of stretching
+// playback time.
+//
+// Responsibilities:
+//   ✓ Play / pause / seek, speed multiplier
+//   ✓ Target frame from a steady clock
+//   ✓ Dropped-frame accounting
+//
+// Changing speed or seeking re-anchors the clock, so the current
+// frame never jumps.
+// ------------------------------------------------------------
+
+class PlaybackClock
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+public:
+    explicit PlaybackClock(double baseRateHz = 10.0);
+    ~PlaybackClock() = default;
+
+    void play(int fromFrame);
+    void pause();
+    void toggle(int currentFrame);
+    bool isPlaying() const { return m_playing; }
+
+    // Jump to a frame; keeps playing if playing
+    void seek(int frame);
+
+    // Multiplier on the base rate (clamped to [0.1, 16])
+    void setSpeed(double speed);
+    double getSpeed() const { return m_speed; }
+    double getBaseRate() const { return m_baseRate; }
+
+    // Loop to frame 0 at the end instead of pausing
+    void setLooping(bool loop) { m_looping = loop; }
+
+    // Frame that should be on screen now. Call once per loop
+    // iteration while playing; frames skipped since the previous
+    // call are added to the dropped count.
+    int update(int totalFrames);
+    int update(int totalFrames, Clock::time_point now);
+
+    // Time until the target frame changes (for sleeping between
+    // frames); a large value when paused
+    double secondsUntilNextFrame() const;
+
+    // Frames skipped since the last call (for per-interval stats)
+    uint32_t consumeDroppedFrames();
+    uint64_t getTotalDroppedFrames() const { return m_totalDropped; }
+
+private:
+    void anchor(int frame, Clock::time_point now);
+
+private:
+    double m_baseRate;
+    double m_speed   = 1.0;
+    bool   m_playing = false;
+    bool   m_looping = false;
+
+    Clock::time_point m_anchorTime;
+    int m_anchorFrame = 0;
+    int m_lastFrame   = 0;
+
+    uint32_t m_dropped      = 0;
+    uint64_t m_totalDropped = 0;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+
+// ------------------------------------------------------------
+// PointBudgetController
+// ------------------------------------------------------------
+// Adjusts how many points are drawn per frame so that the frame
+// time settles at a target (e.g. 16.6 ms for 60 Hz).
+//
+// Each frame it is fed the CPU time (loop work up to the buffer
+// swap, excluding vsync waits) and the GPU time of the frame; the
+// slower of the two drives the budget:
+//
+//   smoothed = ema(max(cpu, gpu))
+//   budget  *= clamp(target / smoothed, shrinkLimit, growLimit)
+//
+// A dead band around the target keeps the budget from twitching,
+// and growth is slower than shrinking so a hitch is corrected
+// quickly while recovery is gradual.
+//
+// The renderer draws a prefix of a pre-shuffled point buffer, so
+// any budget gives an even spatial subsample.
+// ------------------------------------------------------------
+
+class PointBudgetController
+{
+public:
+    struct Params
+    {
+        double targetMs    = 16.6;
+        size_t minPoints   = 10000;
+        double smoothing   = 0.2;    // EMA weight of the newest sample
+        double deadBand    = 0.08;   // ±fraction of target left alone
+        double growLimit   = 1.10;   // max increase per frame
+        double shrinkLimit = 0.70;   // max decrease per frame
+    };
+
+public:
+    PointBudgetController();
+    explicit PointBudgetController(const Params& params);
+
+    // Feed one frame; returns the budget for the next frame,
+    // never more than availablePoints.
+    size_t update(double cpuMs, double gpuMs, size_t availablePoints);
+
+    size_t getBudget() const { return static_cast<size_t>(m_budget); }
+    double getSmoothedMs() const { return m_smoothedMs; }
+    const Params& getParams() const { return m_params; }
+
+    // Start again from "draw everything"
+    void reset();
+
+private:
+    Params m_params;
+    double m_budget     = 0.0;   // 0 = not initialised yet
+    double m_smoothedMs = 0.0;
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#ifdef KITTI_TRACK_ALLOCS
+#include "AllocCounter.h"
+#endif
+
+// ------------------------------------------------------------
+// Profiler
+// ------------------------------------------------------------
+// Scoped CPU profiler. Instrument code with
+//
+//   PROFILE_SCOPE("PointCloudRenderer::render");
+//
+// and, while a capture is running, every scope records a complete
+// event (start + duration, nanoseconds) into a buffer owned by the
+// calling thread. Nested scopes form the hierarchy per thread.
+//
+// Responsibilities:
+//   ✓ Thread-local, fixed-size event buffers, allocated when the
+//     thread registers (no locks, no allocation while recording)
+//   ✓ Capture on demand: startCapture() / stopCapture()
+//   ✓ Export as Chrome trace JSON (chrome://tracing, Perfetto)
+//   ✓ External events (e.g. GPU timings) via recordEvent()
+//
+// Cost when no capture runs: one relaxed atomic load per scope.
+// Build with KITTI_PROFILING=0 to compile the scopes out entirely.
+// In KITTI_TRACK_ALLOCS builds every PROFILE_SCOPE also opens an
+// AllocCounter::Scope, so heap allocations are attributed to it
+// (independent of KITTI_PROFILING).
+//
+// Scope names must be string literals (only the pointer is kept).
+// Export after stopCapture(); scopes still open on other threads at
+// that moment are not included.
+// ------------------------------------------------------------
+
+#ifndef KITTI_PROFILING
+#define KITTI_PROFILING 1
+#endif
+
+namespace Profiler
+{
+    // Per-thread event capacity; further events of a capture are dropped
+    constexpr uint32_t kEventsPerThread = 1u << 16;
+
+    // Nanoseconds since the profiler epoch (steady clock)
+    uint64_t nowNs();
+
+    void startCapture();
+    void stopCapture();
+
+    inline bool isCapturing();
+
+    // Name shown for the calling thread in the trace ("main", "loader", ...).
+    // Also allocates the thread's event buffer, which otherwise happens
+    // on its first event of a capture: call it when the thread starts.
+    void setThreadName(const char* name);
+
+    // Create a virtual track up front (recordEvent() creates unknown
+    // ones, allocating, on first use)
+    void addTrack(const char* track);
+
+    // Record an event on a named virtual track (e.g. "GPU"); times in ns
+    void recordEvent(const char* name, uint64_t startNs, uint64_t durationNs,
+                     const char* track = nullptr);
+
+    // Writes the last capture; false if nothing was captured or the
+    // file cannot be written
+    bool writeChromeTrace(const std::string& path);
+
+    // Events dropped in the last capture (thread buffers full)
+    uint64_t getDroppedCount();
+
+    // ------------------------------------------------------------
+    // RAII scope (use PROFILE_SCOPE)
+    // ------------------------------------------------------------
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name)
+        {
+            if (isCapturing())
+            {
+                m_name  = name;
+                m_start = nowNs();
+            }
+        }
+
+        ~Scope()
+        {
+            if (m_name)
+                end();
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        void end();
+
+        const char* m_name  = nullptr;
+        uint64_t    m_start = 0;
+    };
+
+    namespace detail
+    {
+        extern std::atomic<bool> g_capturing;
+    }
+
+    inline bool isCapturing()
+    {
+        return detail::g_capturing.load(std::memory_order_relaxed);
+    }
+}
+
+#define KITTI_PROFILE_CONCAT_(a, b) a##b
+#define KITTI_PROFILE_CONCAT(a, b) KITTI_PROFILE_CONCAT_(a, b)
+
+#ifdef KITTI_TRACK_ALLOCS
+#define KITTI_ALLOC_SCOPE(name) \
+    ::AllocCounter::Scope KITTI_PROFILE_CONCAT(kittiAllocScope_, __LINE__)(name)
+#else
+#define KITTI_ALLOC_SCOPE(name) do {} while (0)
+#endif
+
+#if KITTI_PROFILING
+#define PROFILE_SCOPE(name) \
+    ::Profiler::Scope KITTI_PROFILE_CONCAT(kittiProfileScope_, __LINE__)(name); \
+    KITTI_ALLOC_SCOPE(name)
+#else
+#define PROFILE_SCOPE(name) KITTI_ALLOC_SCOPE(name)
+#endif
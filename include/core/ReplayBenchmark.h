@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ------------------------------------------------------------
+// ReplayBenchmark
+// ------------------------------------------------------------
+// Measurements of a headless end-to-end replay: every frame of a
+// range goes through the full pipeline (load → prepare → upload →
+// draw → swap) as fast as it can, and this collects:
+//   ✓ Sustained FPS over the measured frames
+//   ✓ Frame latency p50 / p95 / p99 / max (request → GPU finished)
+//   ✓ Time spent waiting for the loader (p50 / p95 / p99)
+//   ✓ Peak RSS, bytes read / written through the OS, bytes uploaded
+//
+// The first warmupFrames are rendered but not measured (shader
+// compilation, first-touch of buffers, cold page cache).
+//
+// With 'seeks' every step jumps to a pseudo-random frame of the
+// range instead (same sequence on every run), so frame latency is
+// seek-to-display latency with read-ahead of no help.
+//
+// Results go to the log and, optionally, to a JSON file meant to
+// be compared across releases:
+//
+//   kitti_visualizer --benchmark --frames 500 --json replay.json
+//   kitti_visualizer --benchmark --seeks --frames 200
+//
+// Sample storage is reserved up front; addFrame() never allocates.
+// ------------------------------------------------------------
+
+class ReplayBenchmark
+{
+public:
+    struct Options
+    {
+        int firstFrame   = 0;
+        int frames       = 0;    // measured frames, 0 = to the end
+        int warmupFrames = 10;
+        bool seeks       = false;   // random access instead of in order
+        std::string jsonPath;    // empty = log only
+        std::string label;       // free text stored in the JSON
+    };
+
+    struct Summary
+    {
+        int    frames  = 0;
+        double seconds = 0.0;
+        double fps     = 0.0;
+
+        double frameP50Ms = 0.0, frameP95Ms = 0.0, frameP99Ms = 0.0;
+        double frameMaxMs = 0.0, frameMeanMs = 0.0;
+        double waitP50Ms  = 0.0, waitP95Ms  = 0.0, waitP99Ms  = 0.0;
+
+        uint64_t peakRssBytes  = 0;
+        uint64_t ioReadBytes   = 0;   // during the measured frames
+        uint64_t ioWriteBytes  = 0;
+        uint64_t uploadBytes   = 0;
+        uint64_t pointsDrawn   = 0;
+    };
+
+public:
+    explicit ReplayBenchmark(const Options& options);
+
+    const Options& getOptions() const { return m_options; }
+
+    // Frame range to replay for a sequence of totalFrames frames
+    // (warm-up included); returns false if it is empty
+    bool frameRange(int totalFrames, int& first, int& end) const;
+
+    // Frame shown at replay step 'step' (0 = first warm-up frame)
+    int frameAt(int step, int first, int end) const;
+
+    // Start of the measured part: clocks and I/O counters
+    void begin();
+    bool hasBegun() const { return m_begun; }
+
+    void addFrame(double frameMs, double waitMs, size_t pointsDrawn, size_t uploadBytes);
+
+    // Stop the clock and compute the summary
+    void end();
+
+    const Summary& getSummary() const { return m_summary; }
+
+    // "412 frames, 57.3 fps | frame p50 ..."
+    std::string describe() const;
+
+    // device: GPU / driver description stored with the results
+    bool writeJson(const std::string& path, const std::string& device) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Options m_options;
+    Summary m_summary;
+
+    std::vector<double> m_frameMs;
+    std::vector<double> m_waitMs;
+
+    bool     m_begun = false;
+    Clock::time_point m_start;
+    uint64_t m_ioReadAtStart  = 0;
+    uint64_t m_ioWriteAtStart = 0;
+};
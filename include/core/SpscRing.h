@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// ------------------------------------------------------------
+// SpscRing
+// ------------------------------------------------------------
+// Bounded lock-free queue for exactly one producer thread and one
+// consumer thread.
+//
+//   producer: tryPush()
+//   consumer: front() / pop() / tryPop()
+//
+// Head and tail live on separate cache lines; each side keeps a
+// cached copy of the other side's index and only reloads it when
+// the ring looks full (producer) or empty (consumer), so the
+// common case touches no shared cache line.
+//
+// Capacity is rounded up to a power of two. All storage is
+// allocated in the constructor; push/pop never allocate.
+// ------------------------------------------------------------
+
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity)
+    {
+        size_t cap = 2;
+        while (cap < capacity)
+            cap <<= 1;
+
+        m_slots.resize(cap);
+        m_mask = cap - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return m_slots.size(); }
+
+    // ---------------- producer side ----------------
+
+    bool tryPush(const T& value)
+    {
+        T copy(value);
+        return tryPush(std::move(copy));
+    }
+
+    bool tryPush(T&& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_cachedHead == m_slots.size())
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == m_slots.size())
+                return false;   // full
+        }
+
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ---------------- consumer side ----------------
+
+    // Oldest element, or nullptr when empty. Valid until pop().
+    T* front()
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+                return nullptr;   // empty
+        }
+
+        return &m_slots[head & m_mask];
+    }
+
+    // Drop the element returned by front()
+    void pop()
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    bool tryPop(T& out)
+    {
+        T* value = front();
+        if (!value)
+            return false;
+
+        out = std::move(*value);
+        pop();
+        return true;
+    }
+
+    // Approximate when called concurrently with the other side
+    size_t sizeApprox() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    bool emptyApprox() const { return sizeApprox() == 0; }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+
+    // Consumer-owned
+    alignas(64) std::atomic<size_t> m_head{0};
+    size_t m_cachedTail = 0;
+
+    // Producer-owned
+    alignas(64) std::atomic<size_t> m_tail{0};
+    size_t m_cachedHead = 0;
+};
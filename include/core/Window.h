@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <memory>
 
@@ -9,35 +10,68 @@ struct GLFWwindow;
 class Window
 {
 public:
-    Window();
+    // Input callbacks forwarded from GLFW (all run on the main thread,
+    // inside pollEvents / waitEvents)
+    struct EventCallbacks
+    {
+        std::function<void(int key, int action)>    onKey;
+        std::function<void(int button, int action)> onMouseButton;
+        std::function<void(double x, double y)>     onCursorPos;
+        std::function<void(double dx, double dy)>   onScroll;
+        std::function<void(int width, int height)>  onResize;
+    };
+
+public:
+    Window(int width, int height, const std::string& title);
     ~Window();
 
     // Creates the GLFW window and initializes OpenGL context
-    bool create(int width, int height, const std::string& title);
+    bool initialize();
+
+    // Destroys the window and terminates GLFW (also on destruction)
+    void shutdown();
+
+    // Before create: hidden windows still get a full GL context
+    // (headless benchmarks); vsync off lets swaps run unthrottled
+    void setVisible(bool visible) { m_visible = visible; }
+    void setVSync(bool vsync) { m_vsync = vsync; }
 
     // Process pending OS events
     void pollEvents();
 
+    // Sleep until an event arrives or timeoutSeconds pass
+    void waitEvents(double timeoutSeconds);
+
+    // Wake a waitEvents() call; safe to call from any thread
+    void postEmptyEvent();
+
+    // Install GLFW input callbacks that forward to these
+    void setEventCallbacks(const EventCallbacks& callbacks);
+
     // Swap buffers after rendering a frame
     void swapBuffers();
 
+    // Swap, then poll events (continuous rendering)
+    void update();
+
     // Check if the user requested to close the window
     bool shouldClose() const;
 
     // Access raw GLFW window pointer
-    GLFWwindow* getGLFWwindow() const { return m_window; }
+    GLFWwindow* getNativeHandle() const;
 
-    // Update title dynamically (fps, frameID, etc.)
-    void setTitle(const std::string& title);
+    // Current framebuffer size (tracks resizes)
+    int getWidth() const;
+    int getHeight() const;
 
 private:
-    bool initGLFW();
-    bool initGLAD();
-
-private:
-    GLFWwindow* m_window = nullptr;
-
     int m_width  = 1280;
     int m_height = 720;
     std::string m_title = "KITTI Visualizer";
+    GLFWwindow* m_window = nullptr;
+
+    EventCallbacks m_callbacks;
+
+    bool m_visible = true;
+    bool m_vsync   = true;
 };
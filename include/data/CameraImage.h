@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+// ------------------------------------------------------------
+// CameraImage
+// ------------------------------------------------------------
+// One decoded camera image of a frame: RGB8, tightly packed rows,
+// top row first. KITTI has four cameras per sequence:
+//   0, 1  grayscale stereo pair (image_0, image_1; expanded to RGB)
+//   2, 3  colour stereo pair    (image_2, image_3)
+//
+// Pooled with FrameData; the pixel buffer keeps its capacity.
+// ------------------------------------------------------------
+
+struct CameraImage
+{
+    static constexpr int kCameraCount = 4;
+
+    int camera = 2;   // KITTI camera index (image_<camera>)
+    std::vector<unsigned char> pixels;
+    int width  = 0;
+    int height = 0;
+
+    bool valid() const { return width > 0 && height > 0 && !pixels.empty(); }
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "CameraImage.h"
+#include "PointCloud.h"
+
+// ------------------------------------------------------------
+// FrameData
+// ------------------------------------------------------------
+// Everything the render thread needs for one KITTI frame, fully
+// prepared by the loader thread (see FramePipeline):
+//   • pose, point cloud, camera images (one per enabled camera)
+//   • derived per-point data (packed normals, when enabled)
+//   • load timings for FrameStats
+//
+// Instances are pooled and recycled; the cloud, image and normal
+// buffers keep their capacity between frames.
+// ------------------------------------------------------------
+
+struct FrameData
+{
+    // Named timing of one prepare stage (name must be a literal,
+    // it is forwarded to FrameStats on the render thread)
+    struct StageTiming
+    {
+        const char* name = nullptr;
+        double ms = 0.0;
+    };
+    static constexpr int kMaxStages = 4;
+    static constexpr int kMaxImages = CameraImage::kCameraCount;
+
+    int      frameIndex = -1;
+    uint32_t generation = 0;        // FramePipeline seek generation
+    int      stream     = 0;        // FramePipeline stream (sequence)
+    uint64_t loadId     = 0;        // unique per completed load (0 = none)
+
+    glm::mat4 pose{1.0f};
+    bool      hasPose = false;      // false: not estimated yet at load time
+    PointCloud cloud;
+
+    // In FramePipeline::Params::cameras order; an image that failed
+    // to load stays in its slot with valid() == false
+    CameraImage images[kMaxImages];
+    int imageCount = 0;
+
+    // Optional, filled by the prepare step
+    std::vector<uint32_t> normals;
+    bool hasNormals = false;
+
+    // Derived stats (ms)
+    double loadMs    = 0.0;   // cloud + images
+    double prepareMs = 0.0;   // deskew, normals, ...
+
+    StageTiming stages[kMaxStages];
+    int stageCount = 0;
+
+    void addStage(const char* name, double ms)
+    {
+        if (stageCount < kMaxStages)
+            stages[stageCount++] = StageTiming{ name, ms };
+    }
+};
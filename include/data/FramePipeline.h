@@ -0,0 +1,267 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FrameData.h"
+#include "core/JobSystem.h"
+#include "core/SpscRing.h"
+
+class IKittiLoader;
+
+// ------------------------------------------------------------
+// FramePipeline
+// ------------------------------------------------------------
+// Loads frames on a dedicated loader thread and hands them to the
+// render thread through lock-free SPSC rings:
+//
+//   loader ──[ready ring per stream]──▶ render      prepared FrameData*
+//   loader ◀──[free ring]────────────── render      buffers to reuse
+//
+// A fixed pool of FrameData buffers circulates between the two, so
+// the handoff never locks or allocates; the buffers are pre-sized and
+// loaders fill them in place. When every buffer is in
+// flight the loader waits for the render thread to release one
+// (backpressure), which also bounds read-ahead. With nothing to load
+// it sleeps until request(), seek(), release() or stop() wakes it.
+//
+// Streams: each open sequence (IKittiLoader) is one stream with its
+// own requested frame, read-ahead and ready ring. All streams share
+// the loader thread, the JobSystem decode jobs, the buffer pool and
+// its MemoryBudget entries, so opening another sequence costs only
+// its loader (the manifest). The loader serves streams round-robin
+// and caps each at an equal share of the pool, so a stream that
+// reads ahead cannot starve the others.
+//
+// Frame selection (per stream):
+//   • request(frame) tells the loader which frame is wanted now;
+//     it reads ahead sequentially from there
+//   • if the wanted frame overtakes the loader (fast playback),
+//     the loader jumps forward instead of loading stale frames; the
+//     load in progress still completes, so a loader slower than
+//     playback keeps delivering (acquire() shows the newest)
+//   • seek(frame), or a request that jumps backwards, starts a new
+//     generation; buffers of the old generation are discarded by
+//     acquire()
+//   • a load of an old generation is cancelled between its stages;
+//     decode jobs that have not started are skipped, and the loader
+//     does not wait for running ones: their buffer is parked until
+//     they finish, so the sought frame starts loading at once
+//
+// Memory: the pool's clouds/normals and images are reported to
+// MemoryBudget ("frame_clouds", "frame_images"). Buffers that grew
+// past their reservation keep that size; on eviction the loader
+// shrinks each one back to the reservation the next time it
+// takes it from the free ring.
+//
+// Threading: addStream() before the first start(). request/acquire/
+// release belong to the render thread. While running, the
+// IKittiLoaders are used only by the loader thread.
+// ------------------------------------------------------------
+
+class FramePipeline
+{
+public:
+    using StreamId = int;
+
+    struct Params
+    {
+        // Frames in flight (display + read-ahead), shared by all
+        // streams; raised to two per stream if lower
+        int bufferCount = 4;
+
+        // Buffers are sized for a typical KITTI frame up front and
+        // touched once, so steady-state loading neither allocates nor
+        // page-faults. Larger frames grow a buffer once, then it stays.
+        size_t reservePoints     = 131072;
+        size_t reserveImageBytes = 1242 * 376 * 3;   // per camera
+
+        // KITTI cameras loaded per frame (0-3, at most
+        // FrameData::kMaxImages), decoded in parallel
+        std::vector<int> cameras{ 2 };
+    };
+
+    // Extra per-frame work on the loader thread (deskew, normals, ...)
+    using PrepareFn = std::function<void(FrameData&)>;
+
+public:
+    // No stream yet: add them with addStream()
+    explicit FramePipeline(const Params& params);
+    // One stream (id 0) for 'loader'
+    explicit FramePipeline(IKittiLoader& loader);
+    FramePipeline(IKittiLoader& loader, const Params& params);
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    // Before the first start(); returns -1 afterwards. The loader
+    // must outlive the pipeline.
+    StreamId addStream(IKittiLoader& loader);
+    int getStreamCount() const { return static_cast<int>(m_streams.size()); }
+    IKittiLoader& getLoader(StreamId stream) const { return *m_streams[stream]->loader; }
+
+    // Must be set before start()
+    void setPrepare(PrepareFn prepare) { m_prepare = std::move(prepare); }
+
+    // Called on the loader thread after each frame is queued (e.g. to
+    // wake an idle event loop). Must be set before start().
+    void setReadyCallback(std::function<void()> callback) { m_onReady = std::move(callback); }
+
+    // Every stream starts at firstFrame
+    void start(int firstFrame = 0);
+    void stop();
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    // Render thread: frame that should be shown now
+    void request(int frame, StreamId stream = 0);
+
+    // Render thread: jump to 'frame' (timeline, random access). Loads
+    // and read-ahead for the old position are dropped, so the first
+    // frame acquire() returns afterwards is 'frame' itself.
+    void seek(int frame, StreamId stream = 0);
+
+    // Render thread: the newest ready frame at or before 'frame'
+    // (the frame itself once the loader keeps up), else nullptr.
+    // Older and stale buffers met on the way are recycled.
+    FrameData* acquire(int frame, StreamId stream = 0);
+
+    // Render thread: hand a buffer back once it is no longer displayed
+    // (FrameData::stream says which stream it counts against)
+    void release(FrameData* frame);
+
+    // Frames loaded but never displayed (overtaken or seeked over)
+    uint64_t getDiscardedCount(StreamId stream = 0) const { return m_streams[stream]->discarded; }
+
+    int getBufferCount() const { return m_params.bufferCount; }
+
+    // Render thread: prepared frames waiting in the stream's ready ring
+    size_t getQueuedCount(StreamId stream = 0) const;
+
+    // Render thread: share of displayed frames that were already
+    // loaded when first requested (1 = the loader always kept up)
+    double getReadyHitRate(StreamId stream = 0) const;
+
+    // Frames the loader skipped without loading
+    uint64_t getSkippedCount(StreamId stream = 0) const
+    {
+        return m_streams[stream]->skipped.load(std::memory_order_relaxed);
+    }
+
+    // Loads abandoned part way because a seek made them pointless
+    uint64_t getCancelledCount(StreamId stream = 0) const
+    {
+        return m_streams[stream]->cancelled.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Stream
+    {
+        IKittiLoader* loader = nullptr;
+        std::unique_ptr<SpscRing<FrameData*>> ready;   // loader → render
+
+        // Written by the render thread, read by the loader
+        std::atomic<int>      requested{0};
+        std::atomic<uint32_t> generation{0};
+
+        // Buffers taken for this stream and not yet released
+        // (loader increments, render thread decrements)
+        std::atomic<int> inFlight{0};
+
+        // Loader-thread state
+        int      cursor = 0;
+        uint32_t loadedGeneration = 0;
+
+        // Render-thread state
+        int      lastRequested  = 0;
+        uint64_t discarded      = 0;
+        int      lookupFrame    = -1;
+        bool     lookupResolved = false;
+        uint64_t readyHits      = 0;
+        uint64_t readyMisses    = 0;
+
+        std::atomic<uint64_t> skipped{0};
+        std::atomic<uint64_t> cancelled{0};
+    };
+
+    void addBuffer();
+    void loaderLoop();
+    // Render thread (and stop): something the loader may be waiting
+    // for changed
+    void wakeLoader();
+    // Loader thread: sleep until wakeLoader() runs after 'epoch' was read
+    void waitForWork(uint32_t epoch);
+    // Loader thread: a buffer to load into, or nullptr if all are in
+    // flight (parked buffers first, once their decodes are done)
+    FrameData* takeBuffer();
+    // Loader thread: next frame the stream wants, or -1 if it has
+    // nothing to load (end of sequence, or its share of the pool is
+    // in flight)
+    int nextFrameFor(Stream& stream, int share);
+    // False if the load was cancelled; the frame is then unusable
+    // until every job in imageJobs has finished
+    bool loadFrame(FrameData& frame, Stream& stream, int index,
+                   JobSystem::TaskHandle (&imageJobs)[FrameData::kMaxImages]);
+    // Loader thread and its decode jobs: has a seek made loads of
+    // 'generation' pointless? (Playback moving on does not.)
+    static bool isStale(const Stream& stream, uint32_t generation);
+    int  getCameraCount() const;
+
+    // Loader thread (or before start): buffer capacities → MemoryBudget;
+    // images of parked buffers are not read (decodes may still run)
+    void reportMemory();
+    void shrinkToReservation(FrameData& frame);
+    size_t requestShrink(size_t excessBytes);   // eviction callback
+
+private:
+    Params        m_params;
+    PrepareFn     m_prepare;
+    std::function<void()> m_onReady;
+
+    std::vector<std::unique_ptr<Stream>> m_streams;
+
+    // Shared by all streams. The rings are sized for the whole pool
+    // on the first start(), once the stream count is known.
+    std::vector<std::unique_ptr<FrameData>> m_pool;
+    std::unique_ptr<SpscRing<FrameData*>> m_free;    // render → loader
+
+    // Loader thread: buffers of cancelled loads, with the decode jobs
+    // that may still write to them (reserved to the pool size)
+    struct Parked
+    {
+        FrameData* frame = nullptr;
+        JobSystem::TaskHandle jobs[FrameData::kMaxImages];
+    };
+    std::vector<Parked> m_parked;
+
+    // Loader thread: image capacities last measured per pool buffer
+    // (reported as is while the buffer is parked)
+    struct MeasuredImages
+    {
+        size_t bytes = 0;
+        size_t slack = 0;
+    };
+    std::vector<MeasuredImages> m_measuredImages;
+
+    std::thread       m_thread;
+    std::atomic<bool> m_running{false};
+
+    // Idle loader. The render thread bumps m_wakeEpoch on every change
+    // and takes the mutex only while the loader is waiting.
+    std::mutex              m_wakeMutex;
+    std::condition_variable m_wake;
+    std::atomic<uint32_t>   m_wakeEpoch{0};
+    std::atomic<bool>       m_loaderWaiting{false};
+
+    // MemoryBudget ids and the bytes above the reservations
+    int m_cloudMemoryId = -1;
+    int m_imageMemoryId = -1;
+    std::atomic<size_t> m_slackBytes{0};
+    std::atomic<int>    m_shrinkPending{0};   // buffers still to shrink
+};
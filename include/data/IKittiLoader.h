@@ -4,7 +4,7 @@
 #include <vector>
 #include <glm/glm.hpp>
 
-class PointCloud;
+#include "PointCloud.h"
 
 // ------------------------------------------------------------
 // IKittiLoader Interface
@@ -27,15 +27,73 @@ public:
     // Load LiDAR point cloud for the given frame index
     virtual PointCloud loadPointCloud(int frameID) = 0;
 
+    // Load into a recycled cloud, reusing its storage. Loaders that
+    // can parse in place override this; the default copies. Must be
+    // safe to call from a background job (ThumbnailStrip) while the
+    // loader thread uses the loader.
+    virtual bool loadPointCloudInto(int frameID, PointCloud& cloud);
+
     // Load camera image for given frame index (RGB raw pixel array)
     virtual bool loadImage(int frameID, int& width, int& height, std::vector<unsigned char>& data) = 0;
 
+    // Image of one KITTI camera (0-3, image_<camera>) as RGB. Must be
+    // safe to call for several cameras of a frame concurrently. The
+    // default only knows the loadImage() camera (2).
+    virtual bool loadCameraImage(int frameID, int camera, int& width, int& height,
+                                 std::vector<unsigned char>& data);
+
     // Load vehicle pose for given frame index (4x4 transformation)
     virtual glm::mat4 loadPose(int frameID) = 0;
 
+    // Pose of the frame if it is known without estimating anything:
+    // always with a pose file, once registered for estimated poses.
+    // Never blocks; safe to call from the loader and render threads.
+    virtual bool tryGetPose(int frameID, glm::mat4& pose);
+
+    // Loader thread: loadPointCloudInto() has just parsed the scan of
+    // frameID into 'cloud'. Loaders that estimate poses register from
+    // it instead of reading the file again. Must not block.
+    virtual void onScanLoaded(int /*frameID*/, const PointCloud& /*cloud*/) {}
+
+    // True when poses are read from a file rather than estimated on
+    // demand: loadPose() is then cheap for any frame and safe to call
+    // alongside the loader thread (Trajectory is built from it once)
+    virtual bool hasPoseFile() const { return true; }
+
+    // Estimated poses (no pose file) already known from frame 'first'
+    // on, appended to 'out' in frame order. Never estimates, so it is
+    // safe to call from the render thread while the loader thread
+    // registers further frames. The default knows none.
+    virtual void getKnownPoses(int /*first*/, std::vector<glm::mat4>& /*out*/) const {}
+
+    // LiDAR → camera 0 extrinsics, the frame poses are expressed in
+    // (identity when unknown)
+    virtual glm::mat4 getVeloToCam() const { return glm::mat4(1.0f); }
+
     // Total number of frames in the KITTI sequence
     virtual int getTotalFrames() const = 0;
 
     // Base directory for KITTI sequence
     virtual std::string getSequencePath() const = 0;
 };
+
+inline bool IKittiLoader::loadPointCloudInto(int frameID, PointCloud& cloud)
+{
+    cloud = loadPointCloud(frameID);
+    return !cloud.empty();
+}
+
+inline bool IKittiLoader::tryGetPose(int frameID, glm::mat4& pose)
+{
+    if (!hasPoseFile())
+        return false;
+
+    pose = loadPose(frameID);
+    return true;
+}
+
+inline bool IKittiLoader::loadCameraImage(int frameID, int camera, int& width, int& height,
+                                          std::vector<unsigned char>& data)
+{
+    return camera == 2 && loadImage(frameID, width, height, data);
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "KdTree.h"
+
+class PointCloud;
+
+// ------------------------------------------------------------
+// IcpOdometry
+// ------------------------------------------------------------
+// Scan-to-scan LiDAR odometry for sequences without poses.txt
+// (KITTI test sequences 11–21).
+//
+// Each new scan is registered against the previous one with
+// point-to-plane ICP:
+//   • source = new scan, voxel-downsampled
+//   • target = previous scan, voxel-downsampled, with PCA normals
+//     and a KdTree for nearest-neighbour correspondences
+//   • initial guess = last relative motion (constant velocity)
+//
+// Correspondence search and normal-equation accumulation are
+// split across the JobSystem in fixed chunks (one partial sum per
+// chunk); the 6x6 system is solved on the calling thread.
+//
+// Poses are in the LiDAR frame of scan 0 (x forward, z up).
+// KittiDataLoader converts them to the camera frame used by
+// poses.txt when calib.txt is available.
+// ------------------------------------------------------------
+
+class IcpOdometry
+{
+public:
+    struct Params
+    {
+        float sourceVoxelSize  = 1.0f;   // metres
+        float targetVoxelSize  = 0.75f;  // metres
+        float minRange         = 3.0f;   // drop ego-vehicle returns
+        float maxRange         = 80.0f;
+        float normalRadius     = 1.5f;   // PCA neighbourhood on target
+        float maxCorrespondenceDist = 2.0f;
+        int   maxIterations    = 25;
+        float convergenceEps   = 1e-4f;  // |update| to stop iterating
+    };
+
+public:
+    IcpOdometry();
+    explicit IcpOdometry(const Params& params);
+    ~IcpOdometry() = default;
+
+    // Register the next scan; returns its pose (scan 0 = identity)
+    glm::mat4 addScan(const PointCloud& cloud);
+
+    // Poses estimated so far (one per added scan)
+    const std::vector<glm::mat4>& getPoses() const { return m_poses; }
+    int getPoseCount() const { return static_cast<int>(m_poses.size()); }
+
+    // Forget all scans and poses
+    void reset();
+
+private:
+    struct Accumulator
+    {
+        double H[6][6];
+        double b[6];
+        double error;
+        int    count;
+    };
+
+    void voxelDownsample(const PointCloud& cloud, float voxelSize,
+                         std::vector<glm::vec3>& out);
+    void setTarget(const std::vector<glm::vec3>& points);
+    void computeTargetNormals(size_t begin, size_t end);
+
+    glm::mat4 align(const glm::mat4& initial);
+    void accumulate(const glm::mat4& T, size_t begin, size_t end, Accumulator& acc) const;
+
+    static bool solve6x6(double H[6][6], double b[6], double x[6]);
+
+private:
+    Params m_params;
+
+    std::vector<glm::mat4> m_poses;
+    glm::mat4 m_lastDelta{1.0f};
+
+    // Target (previous scan)
+    KdTree                 m_targetTree;
+    std::vector<glm::vec3> m_targetNormals;
+    std::vector<uint8_t>   m_targetNormalValid;
+
+    // Scratch
+    std::vector<glm::vec3> m_source;
+    std::vector<glm::vec3> m_nextTarget;
+    std::vector<Accumulator> m_partials;   // one per parallelFor chunk
+    std::unordered_map<int64_t, glm::vec4> m_voxels;   // xyz sum + count
+};
@@ -23,18 +23,14 @@ public:
     // Loads an image file into memory:
     //  - filepath: full path to image
     //  - width, height: output dimensions
-    //  - channels: output channels count (3 for RGB, 4 for RGBA)
-    //  - data: raw pixel buffer (RGB8 or RGBA8)
+    //  - data: raw pixel buffer, always RGB8 (grayscale is expanded),
+    //    top row first
     //
     // Returns: true on success, false on failure
     bool loadImage(
         const std::string& filepath,
         int& width,
         int& height,
-        int& channels,
         std::vector<unsigned char>& data
     );
-
-    // Frees the loaded image buffer (if needed)
-    void freeImage(unsigned char* data);
 };
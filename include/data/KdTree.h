@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class PointCloud;
+
+// ------------------------------------------------------------
+// KdTree
+// ------------------------------------------------------------
+// Static 3D kd-tree over the points of one PointCloud.
+//
+// Used for:
+//   ✓ Mouse-ray picking (front-most point inside a pick cone)
+//   ✓ Radius queries around a world position
+//   ✓ Nearest-neighbour correspondences (ICP odometry)
+//
+// Layout:
+//   - Nodes stored in a flat array, children of node i are
+//     referenced by index; leaves own a range of m_indices.
+//   - Every node keeps its AABB so ray queries can prune.
+//   - Positions are copied at build time, so the tree stays
+//     valid after the source cloud is released and can be
+//     built on a worker thread.
+// ------------------------------------------------------------
+
+class KdTree
+{
+public:
+    struct PickResult
+    {
+        int   index          = -1;    // point index in the source cloud
+        float distanceAlong  = 0.0f;  // distance from ray origin
+        float distanceToRay  = 0.0f;  // perpendicular distance
+    };
+
+public:
+    KdTree() = default;
+    ~KdTree() = default;
+
+    // Build from a cloud; leafSize = max points per leaf
+    void build(const PointCloud& cloud, int leafSize = 16);
+
+    // Build from bare positions (intensity reads as 0)
+    void build(const std::vector<glm::vec3>& positions, int leafSize = 16);
+
+    // Front-most point within a cone of half-angle tanHalfAngle
+    // (as a tangent) around the ray. dir must be normalized.
+    bool pick(const glm::vec3& origin,
+              const glm::vec3& dir,
+              float tanHalfAngle,
+              PickResult& out) const;
+
+    // All points within radius of center (indices appended to out)
+    void radiusSearch(const glm::vec3& center,
+                      float radius,
+                      std::vector<int>& out) const;
+
+    // Closest point within maxDistance; -1 if none.
+    // outDist2 receives the squared distance.
+    int nearest(const glm::vec3& query,
+                float maxDistance,
+                float& outDist2) const;
+
+    const glm::vec3& position(int index) const { return m_positions[index]; }
+    float intensity(int index) const { return m_intensities[index]; }
+
+    size_t size() const { return m_positions.size(); }
+    bool empty() const { return m_positions.empty(); }
+
+    // Heap bytes held (capacity, so buffers kept for reuse count too)
+    size_t memoryBytes() const
+    {
+        return m_nodes.capacity() * sizeof(Node) + m_indices.capacity() * sizeof(uint32_t)
+             + m_positions.capacity() * sizeof(glm::vec3) + m_intensities.capacity() * sizeof(float);
+    }
+
+private:
+    struct Node
+    {
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        int32_t   left  = -1;    // -1 → leaf
+        int32_t   right = -1;
+        uint32_t  begin = 0;     // leaf range in m_indices
+        uint32_t  end   = 0;
+    };
+
+    void buildFromPositions(int leafSize);
+    int32_t buildNode(uint32_t begin, uint32_t end, int leafSize);
+
+    static bool rayBoxEntry(const glm::vec3& origin,
+                            const glm::vec3& invDir,
+                            const glm::vec3& bmin,
+                            const glm::vec3& bmax,
+                            float& tEntry);
+
+private:
+    std::vector<Node>      m_nodes;
+    std::vector<uint32_t>  m_indices;
+    std::vector<glm::vec3> m_positions;
+    std::vector<float>     m_intensities;
+};
@@ -1,72 +1,137 @@
 #pragma once
 
 #include "IKittiLoader.h"
+#include "IcpOdometry.h"
+#include "PointCloud.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <glm/glm.hpp>
 
-class PointCloud;
-class PointCloudParser;
-class PoseLoader;
-class ImageLoader;
-
 // ------------------------------------------------------------
 // KittiDataLoader
 // ------------------------------------------------------------
 // Implements IKittiLoader interface to load:
 //   - LiDAR .bin files
-//   - Camera images (PNG/JPEG)
+//   - Camera images (PNG/JPEG), any of image_0 .. image_3
 //   - Vehicle poses
 //
-// This class owns:
+// Uses (per call, so calls can overlap):
 //   • PointCloudParser
-//   • PoseLoader
+//   • PoseLoader (once, at initialize)
 //   • ImageLoader
 //
 // Responsibilities:
+//   - Scan the sequence folder (velodyne/, image_<n>/, poses.txt,
+//     calib.txt)
 //   - Build file paths for each frame
 //   - Load LiDAR → PointCloud
 //   - Load Image → raw pixel data
 //   - Load Poses → glm::mat4
+//   - Estimate poses with ICP odometry when poses.txt is
+//     missing (optional fallback, see enableOdometryFallback)
+//
+// Odometry stage: its own thread registers scans in frame order up
+// to the newest frame the loader thread has parsed. It takes those
+// scans from onScanLoaded() (up to kHandedScans waiting) and reads
+// only the ones it was not handed, e.g. while catching up after a
+// seek ahead. A catch-up run stops as soon as the loader moves back
+// to frames already registered, and never blocks the loader:
+// frames whose pose is not registered yet load without one
+// (tryGetPose() is false) and get it once the stage catches up.
 // ------------------------------------------------------------
 
 class KittiDataLoader : public IKittiLoader
 {
 public:
-    KittiDataLoader(const std::string& basePath, const std::string& sequence);
-    ~KittiDataLoader() = default;
+    // sequencePath: e.g. "data/kitti/sequences/00"
+    explicit KittiDataLoader(const std::string& sequencePath);
+    ~KittiDataLoader() override;
+
+    // Scan the sequence; false if it has no LiDAR frames
+    bool initialize();
 
     // IKittiLoader overrides
     PointCloud loadPointCloud(int frameID) override;
+    bool loadPointCloudInto(int frameID, PointCloud& cloud) override;
     bool loadImage(int frameID, int& width, int& height,
                    std::vector<unsigned char>& data) override;
+    bool loadCameraImage(int frameID, int camera, int& width, int& height,
+                         std::vector<unsigned char>& data) override;
+    // With odometry, waits until the frame is registered
     glm::mat4 loadPose(int frameID) override;
+    bool tryGetPose(int frameID, glm::mat4& pose) override;
+    void onScanLoaded(int frameID, const PointCloud& cloud) override;
+    bool hasPoseFile() const override { return !m_poses.empty(); }
+    void getKnownPoses(int first, std::vector<glm::mat4>& out) const override;
+    // From calib.txt ("Tr:"); identity without one
+    glm::mat4 getVeloToCam() const override { return m_veloToCam; }
+
+    // When the sequence has no poses.txt, estimate poses by
+    // scan-to-scan ICP on the odometry thread (started here). No-op
+    // if ground truth exists.
+    void enableOdometryFallback(const IcpOdometry::Params& params);
+
 
     int getTotalFrames() const override { return m_totalFrames; }
     std::string getSequencePath() const override { return m_sequencePath; }
 
 private:
-    // helpers to build file paths
-    std::string buildPointCloudPath(int frameID) const;
-    std::string buildImagePath(int frameID) const;
-    std::string buildPoseFilePath() const;
-
     // initialization helpers
-    void scanSequence();
-    void loadPoses();
+    void loadFrameCount();
+    void loadPosesFile();
+    void loadCalibration();
+    void scanCameras();
+    // Odometry thread
+    void odometryLoop();
+    void publishPoses();
 
 private:
-    std::string m_basePath;       // e.g., "data/kitti/"
-    std::string m_sequenceName;   // e.g., "00"
-    std::string m_sequencePath;   // basePath + "sequences/00/"
+    std::string m_sequencePath;   // e.g. "data/kitti/sequences/00"
+    std::string m_velodynePath;   // m_sequencePath + "/velodyne"
 
     int m_totalFrames = 0;
 
-    // Data loaders / parsers
-    std::unique_ptr<PointCloudParser> m_pointCloudParser;
-    std::unique_ptr<PoseLoader>       m_poseLoader;
-    std::unique_ptr<ImageLoader>      m_imageLoader;
-
-    // Cached poses
+    // Ground-truth poses (poses.txt), empty without one
     std::vector<glm::mat4> m_poses;
+
+    // Odometry fallback (no ground truth); m_odometry and
+    // m_odometryScan belong to the odometry thread
+    std::unique_ptr<IcpOdometry> m_odometry;
+    PointCloud                   m_odometryScan;   // scan being registered
+    std::thread                  m_odometryThread;
+
+    // Scans parsed by the loader thread, waiting to be registered
+    // (frame -1 = free slot)
+    static constexpr int kHandedScans = 4;
+    struct HandedScan
+    {
+        int        frame = -1;
+        PointCloud cloud;
+    };
+
+    // Guarded by m_odometryMutex
+    std::mutex              m_odometryMutex;
+    std::condition_variable m_odometryWake;   // target raised, stop
+    HandedScan m_handedScans[kHandedScans];
+    int  m_odometryTarget = -1;   // newest frame the loader parsed
+    int  m_waitTarget     = -1;   // newest frame a loadPose() call waits for
+    int  m_registered     = 0;    // scans registered so far
+    bool m_odometryStop   = false;
+
+    // Estimated poses in the camera-0 frame, one per registered scan.
+    // Written by the odometry thread, read by getKnownPoses/tryGetPose.
+    mutable std::mutex      m_knownPosesMutex;
+    std::condition_variable m_posesPublished;   // loadPose() waits on it
+    std::vector<glm::mat4>  m_knownPoses;
+
+    // image_<n> folders present (checked once with the manifest)
+    bool m_hasCamera[4] = {};
+
+    // LiDAR → camera 0 extrinsics from calib.txt ("Tr:")
+    glm::mat4 m_veloToCam{1.0f};
+    bool m_hasCalibration = false;
 };
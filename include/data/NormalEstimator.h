@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class PointCloud;
+
+// ------------------------------------------------------------
+// NormalEstimator
+// ------------------------------------------------------------
+// Estimates a surface normal for every LiDAR point.
+//
+// Method:
+//   1. Project the scan into a spherical range image
+//      (rows = laser elevation, cols = azimuth). Each pixel keeps
+//      the closest point that falls into it.
+//   2. For every pixel, gather the points in a small window
+//      that lie within maxNeighborDist of the centre point.
+//   3. PCA: the normal is the eigenvector of the smallest
+//      eigenvalue of the neighbourhood covariance, oriented
+//      towards the sensor.
+//
+// Points that share a pixel reuse that pixel's normal, so every
+// point gets a result. Rows are split across the JobSystem.
+//
+// Optional stage: the Application only runs it when lit point
+// shading is enabled.
+// ------------------------------------------------------------
+
+class NormalEstimator
+{
+public:
+    struct Params
+    {
+        int   rows            = 64;      // HDL-64E laser count
+        int   cols            = 1024;    // azimuth bins
+        float fovUpDeg        = 3.0f;
+        float fovDownDeg      = -25.0f;
+        int   windowRadius    = 2;       // 5x5 neighbourhood
+        float maxNeighborDist = 0.6f;    // metres
+        int   minNeighbors    = 4;
+    };
+
+public:
+    NormalEstimator();
+    explicit NormalEstimator(const Params& params);
+    ~NormalEstimator() = default;
+
+    // One unit normal per point; (0,0,0) where support is too sparse.
+    void estimate(const PointCloud& cloud, std::vector<glm::vec3>& outNormals);
+
+    // Same, packed as GL_INT_2_10_10_10_REV (w = 1 valid, 0 unknown).
+    void estimatePacked(const PointCloud& cloud, std::vector<uint32_t>& outPacked);
+
+    const Params& getParams() const { return m_params; }
+
+private:
+    void buildRangeImage(const PointCloud& cloud);
+    void estimateRows(const PointCloud& cloud, int rowBegin, int rowEnd);
+
+private:
+    Params m_params;
+
+    // Scratch buffers kept between frames to avoid reallocation
+    std::vector<int>       m_pixelToPoint;   // closest point index, -1 = empty
+    std::vector<float>     m_pixelRange;     // squared range of that point
+    std::vector<int>       m_pointToPixel;   // pixel of each point, -1 = dropped
+    std::vector<glm::vec3> m_pixelNormals;
+    std::vector<glm::vec3> m_normalScratch;  // used by estimatePacked
+};
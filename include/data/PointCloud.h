@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <cstdint>
+#include <glm/glm.hpp>
 
 // ------------------------------------------------------------
 // PointCloud
@@ -47,6 +48,9 @@ public:
     // Read-only access to point list
     const std::vector<Point>& getPoints() const { return m_points; }
 
+    // Mutable access for in-place processing stages (e.g. deskew)
+    std::vector<Point>& getPoints() { return m_points; }
+
     // Direct push (optional convenience)
     void addPoint(float x, float y, float z, float intensity)
     {
@@ -54,6 +58,16 @@ public:
     }
 
     size_t size() const { return m_points.size(); }
+    bool empty() const { return m_points.empty(); }
+
+    // Capacity management for recycled clouds (BufferPool, FrameData)
+    void reserve(size_t count) { m_points.reserve(count); }
+    void clear() { m_points.clear(); }   // keeps capacity
+
+    // Geometry helpers (zero vector for an empty cloud)
+    glm::vec3 computeCentroid() const;
+    glm::vec3 minBounds() const;
+    glm::vec3 maxBounds() const;
 
 private:
     std::vector<Point> m_points;
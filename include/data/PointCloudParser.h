@@ -17,6 +17,7 @@ class PointCloud;
 // Responsibilities:
 //   ✓ Read binary file
 //   ✓ Convert raw float buffer → PointCloud object
+//   ✓ Or read straight into a recycled PointCloud (parseInto)
 //   ✓ No OpenGL, no rendering here
 //
 // This follows SRP (Single Responsibility Principle).
@@ -28,7 +29,12 @@ public:
     PointCloudParser() = default;
     ~PointCloudParser() = default;
 
-    // Parses a KITTI .bin LiDAR file and returns a PointCloud object.
-    // Throws std::runtime_error on file read errors.
+    // Parses a KITTI .bin LiDAR file and returns a PointCloud object
+    // (empty on read errors).
     PointCloud parseBinFile(const std::string& filepath);
+
+    // Parses into an existing cloud, reusing its storage: once the
+    // cloud has grown to scan size, no allocation happens.
+    // Returns false (and leaves the cloud empty) on read errors.
+    bool parseInto(const std::string& filepath, PointCloud& cloud);
 };
@@ -46,6 +46,9 @@ public:
     // Number of poses
     int getPoseCount() const { return static_cast<int>(m_poses.size()); }
 
+    // All poses, index = frame
+    const std::vector<glm::mat4>& getPoses() const { return m_poses; }
+
 private:
     glm::mat4 convertToMat4(const std::vector<float>& values) const;
 
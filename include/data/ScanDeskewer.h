@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+class PointCloud;
+
+// ------------------------------------------------------------
+// ScanDeskewer
+// ------------------------------------------------------------
+// Motion compensation for a rotating LiDAR scan.
+//
+// A KITTI scan takes 100 ms. The vehicle keeps moving during
+// that time, so points captured late in the sweep are placed
+// relative to a different sensor pose than early ones. That
+// smears geometry near the scan seam at speed.
+//
+// Per point:
+//   1. Time t ∈ [0,1) is derived from azimuth. The HDL-64E spins
+//      clockwise (seen from above), and KITTI cuts the sweep at
+//      the rear, so the front (camera trigger, pose timestamp)
+//      is at t = 0.5.
+//   2. The sensor motion over the sweep is interpolated to
+//      s = t - 0.5: slerp for rotation, lerp for translation.
+//   3. The point is re-expressed in the sensor frame at t = 0.5.
+//
+// The sweep is quantized into timeBins transforms (128 bins ≈
+// 0.8 ms each) so the per-point work is a fast atan2 plus one
+// 3x4 transform, done 4-wide with SSE2 when available.
+// ------------------------------------------------------------
+
+class ScanDeskewer
+{
+public:
+    struct Params
+    {
+        int  timeBins  = 128;
+        bool clockwise = true;   // HDL-64E rotation direction
+    };
+
+public:
+    ScanDeskewer();
+    explicit ScanDeskewer(const Params& params);
+    ~ScanDeskewer() = default;
+
+    // Correct the cloud in place. scanMotion is the sensor pose at
+    // the end of the sweep expressed in the sensor frame at its start
+    // (i.e. the relative motion over one scan period).
+    void deskew(PointCloud& cloud, const glm::mat4& scanMotion);
+
+    // Relative LiDAR motion between two consecutive frame poses.
+    // Poses are in the camera-0 convention of poses.txt; veloToCam
+    // is the calib.txt Tr (identity if the poses are LiDAR poses).
+    static glm::mat4 motionFromPoses(const glm::mat4& poseA,
+                                     const glm::mat4& poseB,
+                                     const glm::mat4& veloToCam);
+
+private:
+    void buildBinTransforms(const glm::mat4& scanMotion);
+
+private:
+    Params m_params;
+
+    // Column-major 3x4 per bin, padded to 16 floats for aligned loads
+    std::vector<float> m_binTransforms;
+};
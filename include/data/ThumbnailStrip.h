@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "CameraImage.h"
+#include "FrameData.h"
+#include "PointCloud.h"
+#include "core/JobSystem.h"
+
+class IKittiLoader;
+
+// ------------------------------------------------------------
+// ThumbnailStrip
+// ------------------------------------------------------------
+// Low-resolution previews of a whole sequence for timeline
+// scrubbing: a decimated scan and downscaled camera images for
+// evenly spaced frames, generated in the background.
+//
+// Responsibilities:
+//   ✓ Slots: at most maxThumbnails, one every
+//     ceil(frames / maxThumbnails) frames
+//   ✓ Coarse-to-fine generation order (0, N/2, N/4, 3N/4, ...), so
+//     the whole timeline has coarse coverage early
+//   ✓ nearest(frame): closest finished thumbnail, shown the moment
+//     the user seeks while the full frame loads
+//   ✓ Memory reported to MemoryBudget ("thumbnails")
+//
+// Usage (render thread):
+//   ThumbnailStrip strip(loader, params);
+//   every frame:  strip.update();            // one job in flight
+//   on a seek:    if (auto* t = strip.nearest(frame)) draw t->cloud ...
+//
+// Threading: everything but the generation job belongs to the
+// render thread. Only one job runs at a time; it calls the
+// loader's loadPointCloudInto / loadCameraImage alongside the
+// FramePipeline (safe, see IKittiLoader) but never loadPose. A
+// thumbnail is published by update() once its job is done and is
+// never written again.
+// ------------------------------------------------------------
+
+class ThumbnailStrip
+{
+public:
+    struct Params
+    {
+        int maxThumbnails = 256;
+        int previewPoints = 4096;   // every n-th point of the scan
+        int imageWidth    = 160;    // px, height keeps the aspect
+
+        // Same cameras, in the same order, as the frames they stand in for
+        std::vector<int> cameras{ 2 };
+    };
+
+    struct Thumbnail
+    {
+        int frame = -1;
+        PointCloud cloud;
+        CameraImage images[FrameData::kMaxImages];
+        int imageCount = 0;
+    };
+
+public:
+    // The loader must outlive the strip
+    ThumbnailStrip(IKittiLoader& loader, const Params& params);
+    ~ThumbnailStrip();   // waits for the job in flight
+
+    ThumbnailStrip(const ThumbnailStrip&) = delete;
+    ThumbnailStrip& operator=(const ThumbnailStrip&) = delete;
+
+    // Publishes a finished thumbnail and starts the next one
+    void update();
+
+    // Closest finished thumbnail to 'frame', nullptr if none yet
+    const Thumbnail* nearest(int frame) const;
+
+    int  getSlotCount() const { return static_cast<int>(m_slots.size()); }
+    int  getSlotFrame(int slot) const { return m_slots[slot].thumbnail.frame; }
+    bool isSlotReady(int slot) const { return m_slots[slot].ready; }
+    int  getReadyCount() const { return m_readyCount; }
+    bool isComplete() const { return m_readyCount == getSlotCount(); }
+
+private:
+    struct Slot
+    {
+        Thumbnail thumbnail;
+        bool ready = false;
+    };
+
+    // Job: fills m_slots[slot] from the full-size frame
+    void generate(int slot);
+
+    static void downscale(const std::vector<unsigned char>& rgb, int width, int height,
+                          int targetWidth, CameraImage& out);
+
+private:
+    IKittiLoader& m_loader;
+    Params        m_params;
+
+    std::vector<Slot> m_slots;
+    std::vector<int>  m_order;      // slot indices, coarse to fine
+    int m_nextInOrder = 0;
+    int m_readyCount  = 0;
+
+    JobSystem::TaskHandle m_job;
+    int m_jobSlot = -1;
+
+    // Full-size scratch of the job in flight
+    PointCloud                 m_scratchCloud;
+    std::vector<unsigned char> m_scratchImage;
+
+    int    m_memoryId = -1;
+    size_t m_bytes    = 0;
+};
@@ -1,49 +1,98 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <glm/glm.hpp>
 
 // ------------------------------------------------------------
 // Trajectory
 // ------------------------------------------------------------
-// Maintains the vehicle's driven path over time.
+// The vehicle's path through a sequence, indexed by frame: point i
+// is the position at frame i. Built once from all poses when the
+// sequence is opened; the current frame selects how much of it is
+// drawn ([0, current]).
 //
 // Responsibilities:
-//   ✓ Store sequence of 3D positions
-//   ✓ Add new points each frame
-//   ✓ Provide path to renderer
-//   ✓ Clear / reset path
+//   ✓ Store one 3D position per frame
+//   ✓ Build from all poses at once, or append in frame order
+//     (poses only known once their frame is loaded); frames skipped
+//     by an append are filled in along a straight line
+//   ✓ Douglas–Peucker simplification of long paths (at least
+//     simplifyMinPoints poses) to a drawable vertex subset
+//   ✓ Map a frame to the number of drawn vertices up to it
+//
+// Drawn vertices: the full path, or the simplified one when built
+// from a long path. Either way they are in frame order, so the
+// range [0, current] is a prefix of them.
 //
 // This class contains no rendering logic (SRP).
 // ------------------------------------------------------------
 
 class Trajectory
 {
+public:
+    struct Params
+    {
+        std::size_t simplifyMinPoints = 100000;   // 0 = never simplify
+        float       simplifyTolerance = 0.05f;    // metres off the drawn line
+    };
+
 public:
     Trajectory() = default;
+    explicit Trajectory(const Params& params) : m_params(params) {}
     ~Trajectory() = default;
 
-    // Add a new 3D point to the trajectory
-    void addPoint(const glm::vec3& p)
-    {
-        m_points.push_back(p);
-    }
+    // Replace the path with one position per frame (current frame
+    // resets to none)
+    void build(std::vector<glm::vec3> positions);
+
+    // Add the position of 'frame'; ignored for frames already on the
+    // path. Frames between the last one and 'frame' are interpolated,
+    // so the path stays one position per frame.
+    bool append(int frame, const glm::vec3& p);
 
     // Clear entire path
-    void clear()
-    {
-        m_points.clear();
-    }
+    void clear();
 
-    // Retrieve full path
-    const std::vector<glm::vec3>& getPath() const
-    {
-        return m_points;
-    }
+    // Frame the vehicle is at (-1 = none yet)
+    void setCurrentFrame(int frame) { m_currentFrame = frame; }
+    int  getCurrentFrame() const { return m_currentFrame; }
+
+    // One position per frame
+    const std::vector<glm::vec3>& getPath() const { return m_points; }
 
     // Number of stored trajectory points
     size_t size() const { return m_points.size(); }
 
+    // Vertices to draw, in frame order (the path unless simplified)
+    const std::vector<glm::vec3>& getDrawPath() const
+    {
+        return m_simplified ? m_drawPoints : m_points;
+    }
+    bool isSimplified() const { return m_simplified; }
+
+    // Drawn vertices at or before 'frame' (a prefix of getDrawPath)
+    size_t drawCountUpTo(int frame) const;
+
+    // Bumped by build() and clear(): the draw path was replaced
+    // rather than appended to (appends only grow it)
+    uint32_t getGeneration() const { return m_generation; }
+
 private:
+    // Douglas–Peucker over m_points into m_drawPoints / m_drawFrames
+    void simplify();
+
+private:
+    Params m_params;
+
     std::vector<glm::vec3> m_points;
+
+    // Simplified draw path and the frame of each of its vertices
+    bool                   m_simplified = false;
+    std::vector<glm::vec3> m_drawPoints;
+    std::vector<uint32_t>  m_drawFrames;
+
+    int      m_currentFrame = -1;
+    uint32_t m_generation   = 0;
 };
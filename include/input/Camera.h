@@ -6,16 +6,15 @@
 // ------------------------------------------------------------
 // Camera
 // ------------------------------------------------------------
-// A standard Orbit / FPS hybrid camera used for 3D navigation.
+// A free-flying (FPS-style) camera used for 3D navigation.
 //
 // Responsibilities:
 //   ✓ Maintain camera position, direction, up vectors
 //   ✓ Produce view & projection matrices
 //   ✓ Handle:
-//        • rotate
-//        • zoom
-//        • pan
-//        • movement updates
+//        • rotate (yaw / pitch from mouse deltas)
+//        • zoom (field of view)
+//        • movement along the view axes
 //   ✓ Used by Renderer and InputHandler
 //
 // No rendering or input code here — SRP.
@@ -24,50 +23,49 @@
 class Camera
 {
 public:
-    Camera();
+    // Placed at 'position', looking at 'target'
+    explicit Camera(const glm::vec3& position = glm::vec3(0.0f, 5.0f, 15.0f),
+                    const glm::vec3& target = glm::vec3(0.0f));
     ~Camera() = default;
 
-    // Updates internal vectors (called every frame or after input)
-    void update();
-
     // View matrix (lookAt)
     glm::mat4 getViewMatrix() const;
 
-    // Projection matrix
-    glm::mat4 getProjectionMatrix() const;
+    // Projection matrix for the given viewport aspect (width / height)
+    glm::mat4 getProjectionMatrix(float aspectRatio) const;
 
-    // Mouse look (orbit / rotate)
-    void rotate(float deltaX, float deltaY);
+    // Movement along the view axes, in world units
+    void moveForward(float delta);
+    void moveBackward(float delta);
+    void moveLeft(float delta);
+    void moveRight(float delta);
+    void moveUp(float delta);
+    void moveDown(float delta);
 
-    // Zoom in/out
-    void zoom(float amount);
+    // Mouse look: offsets in pixels, scaled by the sensitivity
+    void rotate(float offsetX, float offsetY);
 
-    // Pan camera
-    void pan(float deltaX, float deltaY);
+    // Zoom in/out (narrows / widens the field of view)
+    void zoom(float yOffset);
 
-    // Setters for initial camera configuration
-    void setAspectRatio(float aspect);
     void setPosition(const glm::vec3& pos);
-    void setTarget(const glm::vec3& target);
+
+    glm::vec3 getPosition() const;
+    glm::vec3 getFront() const;
+    glm::vec3 getUp() const;
 
 private:
-    // Computes direction/up/right based on yaw/pitch
-    void recalcVectors();
+    // Computes front/right/up from yaw/pitch
+    void updateDirectionVectors();
 
 private:
     glm::vec3 m_position;
-    glm::vec3 m_target;
+    glm::vec3 m_front{0.0f, 0.0f, -1.0f};
     glm::vec3 m_up;
-    glm::vec3 m_right;
-    glm::vec3 m_direction;
-
-    float m_yaw;
-    float m_pitch;
-    float m_distance;
+    glm::vec3 m_right{1.0f, 0.0f, 0.0f};
 
-    // Projection parameters
-    float m_fov = 60.0f;
-    float m_aspect = 16.0f / 9.0f;
-    float m_nearPlane = 0.1f;
-    float m_farPlane  = 1000.0f;
+    float m_yaw;           // degrees
+    float m_pitch;         // degrees
+    float m_sensitivity;   // degrees per pixel
+    float m_zoom;          // vertical field of view, degrees
 };
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
 
+struct GLFWwindow;
 class Window;
 class Camera;
 
@@ -13,6 +17,17 @@ class Camera;
 //   ✓ Mouse movement
 //   ✓ Mouse scroll (zoom)
 //   ✓ Frame navigation keys (next/prev)
+//   ✓ Playback keys (space = play/pause, [ / ] = speed)
+//   ✓ Point picking clicks (left mouse button)
+//   ✓ Timeline scrubbing (left drag along the bottom edge)
+//   ✓ Profiler trace capture (F9 starts / stops and saves)
+//   ✓ Performance overlay toggle (F1)
+//
+// Two modes:
+//   • polling (default): update() samples key/mouse state via GLFW
+//   • event-driven: GLFW callbacks append to an event queue that
+//     update() drains; nothing is sampled, and the Application can
+//     sleep in glfwWaitEventsTimeout until input arrives
 //
 // This class does NOT handle rendering or camera math.
 // It simply detects input events and forwards actions
@@ -27,19 +42,52 @@ public:
     InputHandler();
     ~InputHandler() = default;
 
-    // Connect window + initialize GLFW callbacks
-    void attachWindow(Window* window);
+    // Connect the window whose input is polled
+    void attachWindow(GLFWwindow* window);
+
+    // Switch to event-driven input: installs GLFW callbacks on the
+    // window that feed the event queue
+    void enableEventQueue(Window& window);
+    bool isEventDriven() const { return m_eventDriven; }
+
+    // Event mode: did this update() see any input?
+    bool hadActivity() const { return m_hadActivity; }
+
+    // True while held keys move the camera or step frames, i.e. the
+    // view changes without further events
+    bool wantsContinuousUpdate() const;
 
     // Connect a camera to manipulate
     void attachCamera(Camera* camera);
 
     // Called every frame — polls input and updates state
-    void processInput();
+    void update();
 
     // Query: did user request next/previous frame?
     bool nextFrameRequested() const { return m_nextFrame; }
     bool prevFrameRequested() const { return m_prevFrame; }
 
+    // Query: playback toggles (edge-triggered, true for one frame)
+    bool playToggleRequested() const { return m_playToggle; }
+    bool speedUpRequested() const { return m_speedUp; }
+    bool speedDownRequested() const { return m_speedDown; }
+    bool traceToggleRequested() const { return m_traceToggle; }
+    bool overlayToggleRequested() const { return m_overlayToggle; }
+    bool sequenceSwitchRequested() const { return m_sequenceSwitch; }
+
+    // Query: was the left mouse button clicked this frame?
+    // Position is in window pixels, origin top-left.
+    bool pickRequested() const { return m_pickRequested; }
+    glm::vec2 getPickPosition() const { return glm::vec2(m_pickX, m_pickY); }
+
+    // Timeline: a left press within the bottom 'pixels' of the window
+    // starts a scrub instead of a pick; it lasts while the button is
+    // held (0 = no timeline)
+    void setTimelineHeight(float pixels) { m_timelineHeight = pixels; }
+    bool timelineScrubbing() const { return m_scrubbing; }
+    // 0..1 across the window width, while scrubbing
+    float getTimelinePosition() const { return m_scrubPosition; }
+
     // Reset after processed
     void clearFrameRequests()
     {
@@ -48,21 +96,37 @@ public:
     }
 
 private:
-    // Key callback adapter (GLFW → InputHandler)
-    static void keyCallbackAdapter(void* handlerPtr,
-                                   int key, int scancode, int action, int mods);
+    struct InputEvent
+    {
+        enum class Type { Key, MouseButton, CursorPos, Scroll };
+
+        Type   type;
+        int    code   = 0;     // key or button
+        int    action = 0;     // GLFW_PRESS / GLFW_RELEASE / GLFW_REPEAT
+        double x = 0.0;
+        double y = 0.0;
+    };
+
+    void drainEvents();
 
-    // Mouse movement callback
-    static void mouseMoveCallbackAdapter(void* handlerPtr,
-                                         double xpos, double ypos);
+    // State queries that work in both modes
+    bool isKeyDown(int key) const;
+    bool isMouseButtonDown(int button) const;
+    void getCursor(double& x, double& y) const;
 
-    // Mouse scroll callback (zoom)
-    static void scrollCallbackAdapter(void* handlerPtr,
-                                      double xoffset, double yoffset);
+    void handleKeyboard();
+    void handleMouseMovement();
+    void handleMouseScroll();
+    void handleMouseButtons();
+    void handleTimeline();
+    void handlePlaybackKeys();
+
+    // True on the frame a key goes down
+    bool keyPressed(int key);
 
 private:
-    Window* m_window = nullptr;
-    Camera* m_camera = nullptr;
+    GLFWwindow* m_window = nullptr;
+    Camera*     m_camera = nullptr;
 
     // Mouse tracking
     bool   m_firstMouse = true;
@@ -73,6 +137,38 @@ private:
     bool m_nextFrame = false;
     bool m_prevFrame = false;
 
-    // Keyboard state
+    // Playback (edge-triggered)
+    bool m_playToggle = false;
+    bool m_speedUp    = false;
+    bool m_speedDown  = false;
+    bool m_traceToggle = false;
+    bool m_overlayToggle = false;
+    bool m_sequenceSwitch = false;
+
+    // Picking (edge-triggered on left button press)
+    bool   m_pickRequested = false;
+    bool   m_leftWasDown   = false;
+    double m_pickX = 0.0;
+    double m_pickY = 0.0;
+
+    // Timeline scrubbing
+    float m_timelineHeight = 0.0f;
+    bool  m_scrubbing      = false;
+    float m_scrubPosition  = 0.0f;
+
+    // Keyboard state (previous frame, for edge detection)
     std::unordered_map<int, bool> m_keyState;
+
+    // Event-driven mode
+    bool m_eventDriven = false;
+    bool m_hadActivity = false;
+    std::vector<InputEvent>      m_events;          // filled by callbacks
+    std::unordered_set<int>      m_keysDown;
+    std::unordered_set<int>      m_keysPressed;     // this update only
+    std::unordered_set<int>      m_buttonsDown;
+    double m_cursorX = 0.0;
+    double m_cursorY = 0.0;
+    bool   m_clickPending = false;
+    double m_clickX = 0.0;
+    double m_clickY = 0.0;
 };
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "GpuDevice.h"
+
+// ------------------------------------------------------------
+// GlDevice
+// ------------------------------------------------------------
+// GpuDevice backed by OpenGL 3.3 through glad. Every call maps to
+// the GL call(s) the renderers used to make themselves; no state
+// is cached here, so behaviour matches direct GL exactly.
+//
+// Needs a current GL context with glad loaded (Window::initialize)
+// for every call.
+// ------------------------------------------------------------
+
+class GlDevice : public GpuDevice
+{
+public:
+    std::string describe() const override;
+
+    Handle createBuffer() override;
+    void   destroyBuffer(Handle buffer) override;
+    Handle createVertexArray() override;
+    void   destroyVertexArray(Handle vao) override;
+
+    void bindVertexArray(Handle vao) override;
+    void bindBuffer(GpuBufferTarget target, Handle buffer) override;
+
+    void bufferData(GpuBufferTarget target, size_t bytes, const void* data, GpuBufferUsage usage) override;
+    void bufferSubData(GpuBufferTarget target, size_t offset, size_t bytes, const void* data) override;
+    size_t bufferSize(GpuBufferTarget target) override;
+
+    void vertexAttribPointer(unsigned int index, int components, GpuAttribType type,
+                             bool normalized, int stride, size_t offset) override;
+    void setVertexAttribEnabled(unsigned int index, bool enabled) override;
+    void vertexAttribConstant(unsigned int index, float x, float y, float z, float w) override;
+
+    Handle createTexture2D() override;
+    void   destroyTexture(Handle texture) override;
+    void   uploadTexture2D(Handle texture, int width, int height,
+                           const unsigned char* rgb, bool generateMipmaps) override;
+    void   bindTexture2D(unsigned int unit, Handle texture) override;
+
+    Handle createTextureArray() override;
+    void   allocateTextureArray(Handle texture, int width, int height, int layers) override;
+    void   uploadTextureLayer(Handle texture, int layer, int width, int height,
+                              const unsigned char* rgb) override;
+    void   bindTextureArray(unsigned int unit, Handle texture) override;
+
+    Handle createProgram(const std::string& vertexSrc, const std::string& fragmentSrc,
+                         std::string& errorLog) override;
+    void   destroyProgram(Handle program) override;
+    void   useProgram(Handle program) override;
+    int    uniformLocation(Handle program, const char* name) override;
+
+    void setUniformMat4(int location, const float* values) override;
+    void setUniformVec3(int location, const float* values) override;
+    void setUniformFloat(int location, float value) override;
+    void setUniformInt(int location, int value) override;
+
+    void setEnabled(GpuCapability capability, bool enabled) override;
+    void setAlphaBlendFunc() override;
+    void setLineWidth(float width) override;
+    void clear(float r, float g, float b, float a) override;
+
+    void drawArrays(GpuPrimitive primitive, int first, int count) override;
+    void drawIndexed(GpuPrimitive primitive, int count) override;
+
+    Handle createTimerQuery() override;
+    void   destroyTimerQuery(Handle query) override;
+    void   beginTimerQuery(Handle query) override;
+    void   endTimerQuery() override;
+    bool   timerQueryResult(Handle query, uint64_t& outNs) override;
+
+    void finish() override;
+
+private:
+    unsigned int compileShader(unsigned int type, const std::string& src, std::string& errorLog);
+};
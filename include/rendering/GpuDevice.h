@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ------------------------------------------------------------
+// GpuDevice
+// ------------------------------------------------------------
+// Thin interface over the GL calls the rendering/ classes make.
+//
+// Responsibilities:
+//   ✓ Resource lifetime (buffers, vertex arrays, textures,
+//     programs, timer queries)
+//   ✓ Uploads, bindings, fixed-function state, uniforms
+//   ✓ Draw calls
+//
+// Backends:
+//   - GlDevice:        forwards to OpenGL (needs a current context)
+//   - RecordingDevice: no GL at all; counts draw calls, state
+//                      changes and uploaded bytes, and can capture
+//                      the command stream (benchmarks, regression
+//                      checks of renderer CPU cost)
+//
+// The calls mirror GL one to one where the renderers use GL
+// directly, so GlDevice adds one virtual call per GL call and
+// nothing else. Handles are plain GL names (0 = none).
+//
+// Like a GL context, one device is "current" per process; the
+// renderers fetch it with GpuDevice::current(). Set it before
+// creating any renderer and keep it alive until they are gone.
+// ------------------------------------------------------------
+
+enum class GpuBufferTarget : uint8_t
+{
+    Vertex,     // GL_ARRAY_BUFFER
+    Index       // GL_ELEMENT_ARRAY_BUFFER
+};
+
+enum class GpuBufferUsage : uint8_t
+{
+    Static,     // GL_STATIC_DRAW
+    Dynamic     // GL_DYNAMIC_DRAW
+};
+
+enum class GpuAttribType : uint8_t
+{
+    Float,          // GL_FLOAT
+    Int2101010Rev   // GL_INT_2_10_10_10_REV
+};
+
+enum class GpuPrimitive : uint8_t
+{
+    Points,
+    Lines,
+    LineStrip,
+    Triangles
+};
+
+enum class GpuCapability : uint8_t
+{
+    DepthTest,
+    Blend,
+    ProgramPointSize
+};
+
+class GpuDevice
+{
+public:
+    using Handle = unsigned int;
+
+    virtual ~GpuDevice() = default;
+
+    // Current device (asserts one was set)
+    static GpuDevice& current();
+    static void setCurrent(GpuDevice* device);
+    static bool hasCurrent();
+
+    // "GL_RENDERER | GL_VERSION" or a backend name
+    virtual std::string describe() const = 0;
+
+    // ---- Buffers / vertex arrays ----
+    virtual Handle createBuffer() = 0;
+    virtual void   destroyBuffer(Handle buffer) = 0;
+    virtual Handle createVertexArray() = 0;
+    virtual void   destroyVertexArray(Handle vao) = 0;
+
+    virtual void bindVertexArray(Handle vao) = 0;
+    virtual void bindBuffer(GpuBufferTarget target, Handle buffer) = 0;
+
+    // Operate on the buffer bound to target
+    virtual void bufferData(GpuBufferTarget target, size_t bytes, const void* data, GpuBufferUsage usage) = 0;
+    virtual void bufferSubData(GpuBufferTarget target, size_t offset, size_t bytes, const void* data) = 0;
+    virtual size_t bufferSize(GpuBufferTarget target) = 0;
+
+    // Attribute layout of the bound vertex array (offset into the bound vertex buffer)
+    virtual void vertexAttribPointer(unsigned int index, int components, GpuAttribType type,
+                                     bool normalized, int stride, size_t offset) = 0;
+    virtual void setVertexAttribEnabled(unsigned int index, bool enabled) = 0;
+    // Value used while the attribute array is disabled
+    virtual void vertexAttribConstant(unsigned int index, float x, float y, float z, float w) = 0;
+
+    // ---- Textures (2D, RGB8) ----
+    // Clamp-to-edge, trilinear, initialised to 1x1 white
+    virtual Handle createTexture2D() = 0;
+    virtual void   destroyTexture(Handle texture) = 0;
+    // Tightly packed RGB rows; leaves no texture bound
+    virtual void uploadTexture2D(Handle texture, int width, int height,
+                                 const unsigned char* rgb, bool generateMipmaps) = 0;
+    virtual void bindTexture2D(unsigned int unit, Handle texture) = 0;
+
+    // ---- Texture arrays (2D array, RGB8, one image per layer) ----
+    // Clamp-to-edge, linear, no mipmaps, no storage until allocated;
+    // destroyed with destroyTexture()
+    virtual Handle createTextureArray() = 0;
+    // (Re)defines every layer as width x height, contents undefined
+    virtual void allocateTextureArray(Handle texture, int width, int height, int layers) = 0;
+    // Tightly packed RGB rows into the corner of one layer; leaves no
+    // texture array bound
+    virtual void uploadTextureLayer(Handle texture, int layer, int width, int height,
+                                    const unsigned char* rgb) = 0;
+    virtual void bindTextureArray(unsigned int unit, Handle texture) = 0;
+
+    // ---- Programs ----
+    // 0 on failure, with the compiler/linker log in errorLog
+    virtual Handle createProgram(const std::string& vertexSrc, const std::string& fragmentSrc,
+                                 std::string& errorLog) = 0;
+    virtual void   destroyProgram(Handle program) = 0;
+    virtual void   useProgram(Handle program) = 0;
+    virtual int    uniformLocation(Handle program, const char* name) = 0;
+
+    // Uniforms of the program in use
+    virtual void setUniformMat4(int location, const float* values) = 0;
+    virtual void setUniformVec3(int location, const float* values) = 0;
+    virtual void setUniformFloat(int location, float value) = 0;
+    virtual void setUniformInt(int location, int value) = 0;
+
+    // ---- Fixed-function state ----
+    virtual void setEnabled(GpuCapability capability, bool enabled) = 0;
+    virtual void setAlphaBlendFunc() = 0;   // SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+    virtual void setLineWidth(float width) = 0;
+    virtual void clear(float r, float g, float b, float a) = 0;   // color + depth
+
+    // ---- Draws (bound vertex array) ----
+    virtual void drawArrays(GpuPrimitive primitive, int first, int count) = 0;
+    virtual void drawIndexed(GpuPrimitive primitive, int count) = 0;   // uint32 indices
+
+    // ---- Timer queries (GL_TIME_ELAPSED) ----
+    virtual Handle createTimerQuery() = 0;
+    virtual void   destroyTimerQuery(Handle query) = 0;
+    virtual void   beginTimerQuery(Handle query) = 0;
+    virtual void   endTimerQuery() = 0;
+    // False while the result is not available yet
+    virtual bool   timerQueryResult(Handle query, uint64_t& outNs) = 0;
+
+    // Block until all submitted work has executed
+    virtual void finish() = 0;
+};
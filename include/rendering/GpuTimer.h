@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+// ------------------------------------------------------------
+// GpuTimer
+// ------------------------------------------------------------
+// Measures GPU time of a span of GL commands with a small ring of
+// GL_TIME_ELAPSED queries. Results are read back a few frames
+// later, once the GPU reports them available, so measuring never
+// stalls the pipeline.
+//
+// Usage (once per frame):
+//   timer.begin();
+//   ... draw calls ...
+//   timer.end();
+//   double ms;
+//   if (timer.latestMs(ms)) { ... }
+//
+// GL_TIME_ELAPSED queries cannot nest: only one GpuTimer may be
+// between begin() and end() at a time.
+//
+// Each query also remembers the CPU time (Profiler::nowNs) at which
+// it was begun, so results can be placed on a trace timeline.
+//
+// Queries go through GpuDevice::current() (a GL context for
+// GlDevice; RecordingDevice reports 0 ms immediately).
+// ------------------------------------------------------------
+
+class GpuTimer
+{
+public:
+    static constexpr int kRingSize = 4;
+
+public:
+    GpuTimer() = default;
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    void initialize();
+
+    void begin();
+    void end();
+
+    // Most recent finished measurement; false until one is ready.
+    // submitNs (optional): CPU time at which that query was begun.
+    bool latestMs(double& outMs, uint64_t* submitNs = nullptr);
+
+    // Last value returned by latestMs (0 before the first result)
+    double lastMs() const { return m_lastMs; }
+
+private:
+    void collect();
+
+private:
+    unsigned int m_queries[kRingSize] = {};
+    bool     m_pending[kRingSize] = {};
+    uint64_t m_submitNs[kRingSize] = {};
+    int    m_writeIndex = 0;
+    bool   m_active = false;
+    bool   m_isInitialized = false;
+
+    double   m_lastMs = 0.0;
+    uint64_t m_lastSubmitNs = 0;
+    bool     m_hasNew = false;
+};
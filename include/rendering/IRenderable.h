@@ -10,7 +10,6 @@
 // Responsibilities:
 //   ✓ Provide a common API for initialization
 //   ✓ Provide a unified render() function
-//   ✓ Allow updating of GPU buffers
 //
 // Implemented by:
 //   • PointCloudRenderer
@@ -27,11 +26,9 @@ class IRenderable
 public:
     virtual ~IRenderable() = default;
 
-    // Initialize OpenGL buffers, shaders, etc.
-    virtual bool init() = 0;
-
-    // Update GPU buffers, textures, or transforms
-    virtual void update() = 0;
+    // Create shaders and GPU buffers. Data uploads are per renderer
+    // (uploadPointCloud, updateImages, ...): their inputs differ.
+    virtual void initialize() = 0;
 
     // Render the object using view + projection matrices
     virtual void render(const glm::mat4& view,
@@ -5,6 +5,8 @@
 #include "IRenderable.h"
 #include "Shader.h"
 
+struct CameraImage;
+
 // ------------------------------------------------------------
 // ImageRenderer
 // ------------------------------------------------------------
@@ -12,11 +14,16 @@
 //   ✓ Rendering 2D camera images as textured quads
 //   ✓ Converting raw KITTI image data into OpenGL textures
 //   ✓ Handling viewport-aligned rendering
+//   ✓ Several cameras at once, tiled: 1 = full quad, 2 = side by
+//     side (stereo pair), 3-4 = 2x2 grid
 //
 // Design:
-//   - Uses a simple screen-aligned quad in NDC
-//   - Shader handles texture drawing
-//   - Texture updates happen dynamically (one per frame)
+//   - Uses a simple screen-aligned quad in NDC, one draw per tile
+//   - All images live in the layers of one texture array; the
+//     shader picks the layer per tile (u_Layer)
+//   - Texture updates happen dynamically (every layer, per frame);
+//     storage is only reallocated when the size or count changes
+//   - Texture bytes reported to MemoryBudget ("gpu_image")
 // ------------------------------------------------------------
 
 class ImageRenderer : public IRenderable
@@ -28,8 +35,11 @@ public:
     // Setup quad geometry, load shaders
     void initialize() override;
 
-    // Update texture from raw RGB pixel array
-    bool updateImageTexture(int width, int height, const std::vector<unsigned char>& data);
+    static constexpr int kMaxImages = 4;
+
+    // Upload up to kMaxImages images, one layer each, in tile order.
+    // Invalid images keep an empty tile. Returns the bytes uploaded.
+    size_t updateImages(const CameraImage* images, int count);
 
     // Render the textured quad
     void render(const glm::mat4& view,
@@ -40,12 +50,22 @@ private:
     unsigned int m_vbo = 0;
     unsigned int m_ebo = 0;
 
-    unsigned int m_textureID = 0;
+    unsigned int m_textureID = 0;   // 2D array, one layer per image
 
     Shader m_shader;
 
     bool m_hasTexture = false;
 
+    // Texture array storage and what the last update put in it
+    int m_arrayWidth  = 0;
+    int m_arrayHeight = 0;
+    int m_arrayLayers = 0;
+    int m_imageCount  = 0;
+    int m_imageWidth[kMaxImages]  = {};
+    int m_imageHeight[kMaxImages] = {};
+
+    int m_memoryId = -1;   // MemoryBudget
+
     // Internal helpers
     void createQuad();
     void createTexture();
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct GLFWwindow;
+class FrameStats;
+class ThumbnailStrip;
+
+// ------------------------------------------------------------
+// PerfOverlay
+// ------------------------------------------------------------
+// ImGui performance panel drawn over the scene:
+//   ✓ CPU / GPU frame time history graphs
+//   ✓ Loader queue depth, read-ahead hit rate, dropped frames
+//   ✓ Points uploaded / drawn, bytes uploaded per frame
+//   ✓ Latest value of every FrameStats entry (per-stage timings)
+//   ✓ Timeline bar along the bottom edge: position, thumbnail
+//     coverage, preview state (drawn even when the panel is hidden)
+//
+// Allocation-free per frame: history lives in fixed arrays, labels
+// are formatted into stack buffers, stat names are the literals
+// FrameStats already holds. (ImGui's own draw buffers stop growing
+// after the first frames.)
+//
+// Display only: the panel takes no input and installs no GLFW
+// callbacks, so camera and picking input are unaffected. Timeline
+// scrubbing is detected by InputHandler; the bar only shows it.
+// ------------------------------------------------------------
+
+class PerfOverlay
+{
+public:
+    static constexpr int kHistory = 240;   // frames shown in the graphs
+
+    // Values that do not come from FrameStats
+    struct Counters
+    {
+        size_t   queuedFrames    = 0;     // loader → render ring
+        size_t   frameBuffers    = 0;     // ring capacity (for the bar)
+        double   readyHitRate    = 1.0;   // 0..1
+        uint64_t framesSkipped   = 0;     // never loaded (playback overtook the loader)
+        uint64_t framesDiscarded = 0;     // loaded, never shown
+        size_t   pointsUploaded  = 0;
+        size_t   pointsDrawn     = 0;
+        size_t   bytesUploaded   = 0;
+    };
+
+    struct Timeline
+    {
+        int   frame       = 0;
+        int   totalFrames = 0;
+        float height      = 28.0f;   // px, same band InputHandler scrubs in
+        bool  scrubbing   = false;
+        bool  preview     = false;   // thumbnail on screen, full frame loading
+        const ThumbnailStrip* thumbnails = nullptr;   // coverage ticks
+    };
+
+public:
+    PerfOverlay() = default;
+    ~PerfOverlay();
+
+    PerfOverlay(const PerfOverlay&) = delete;
+    PerfOverlay& operator=(const PerfOverlay&) = delete;
+
+    // Creates the ImGui context and GL backend (context must be current)
+    bool initialize(GLFWwindow* window);
+    void shutdown();
+
+    void setVisible(bool visible) { m_visible = visible; }
+    bool isVisible() const { return m_visible; }
+    void toggle() { m_visible = !m_visible; }
+
+    // Once per frame, visible or not (keeps the history continuous)
+    void addSample(float cpuMs, float gpuMs);
+
+    // Draws the panel (if visible) and the timeline (if given) into
+    // the current framebuffer
+    void render(const FrameStats& stats, const Counters& counters, const Timeline* timeline = nullptr);
+
+private:
+    void drawPanel(const FrameStats& stats, const Counters& counters);
+    void drawTimeline(const Timeline& timeline);
+
+private:
+    bool  m_isInitialized = false;
+    bool  m_visible = true;
+
+    // Ring buffers, oldest sample at m_historyOffset
+    float m_cpuMs[kHistory] = {};
+    float m_gpuMs[kHistory] = {};
+    int   m_historyOffset = 0;
+};
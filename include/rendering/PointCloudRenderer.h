@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 #include "IRenderable.h"
 #include "Shader.h"
@@ -17,14 +18,28 @@ class PointCloud;
 //
 // Features:
 //   - Supports intensity-based coloring
+//   - Optional lit shading from per-point normals
+//     (packed 10:10:10:2, see NormalEstimator)
 //   - Efficient GPU buffer updates when new frames arrive
+//   - Point budget: points are uploaded in a fixed shuffled order
+//     (golden-ratio stride), so drawing any prefix gives an even
+//     subsample of the whole scan
 //   - Works directly with PointCloud objects
+//   - VBO bytes reported to MemoryBudget ("gpu_points"); on GPU
+//     eviction, normals that no longer match the cloud are freed
 //
 // SRP & Clean Architecture:
 //   - This class ONLY renders.
 //   - PointCloud parsing + loading is handled by other modules.
 // ------------------------------------------------------------
 
+// How points are coloured by the fragment stage
+enum class PointShading
+{
+    Intensity,  // heatmap from LiDAR intensity
+    Lit         // intensity albedo * Lambert term from normals
+};
+
 class PointCloudRenderer : public IRenderable
 {
 public:
@@ -37,6 +52,22 @@ public:
     // Upload new point cloud to GPU
     void uploadPointCloud(const PointCloud& cloud);
 
+    // Upload per-point normals packed as GL_INT_2_10_10_10_REV.
+    // Must match the point count of the last uploaded cloud,
+    // otherwise lit shading falls back to intensity.
+    void uploadNormals(const std::vector<uint32_t>& packedNormals);
+
+    void setShading(PointShading shading) { m_shading = shading; }
+    PointShading getShading() const { return m_shading; }
+
+    // Draw at most this many points (0 = all)
+    void setPointBudget(std::size_t budget) { m_pointBudget = budget; }
+    std::size_t getPointBudget() const { return m_pointBudget; }
+
+    // Points drawn by the last render() / uploaded in total
+    std::size_t getDrawnPointCount() const { return m_drawnCount; }
+    std::size_t getPointCount() const { return m_pointCount; }
+
     // Render points
     void render(const glm::mat4& view,
                 const glm::mat4& projection) override;
@@ -44,13 +75,30 @@ public:
 private:
     unsigned int m_vao = 0;
     unsigned int m_vbo = 0;
+    unsigned int m_normalVbo = 0;
 
     Shader m_shader;
 
     std::size_t m_pointCount = 0;
+    std::size_t m_normalCount = 0;
+
+    PointShading m_shading = PointShading::Intensity;
+
+    // Budgeted drawing over the shuffled upload order
+    std::size_t m_pointBudget   = 0;
+    std::size_t m_drawnCount    = 0;
+    std::size_t m_shuffleStride = 1;
 
     bool m_isInitialized = false;
 
+    // MemoryBudget accounting
+    int m_memoryId = -1;
+    std::size_t m_vboBytes = 0;
+    std::size_t m_normalVboBytes = 0;
+
     // internal helpers
     void createBuffers();
+    void reportMemory();
+    std::size_t releaseStaleNormals();   // eviction callback
+    static std::size_t shuffleStride(std::size_t n);
 };
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "GpuDevice.h"
+
+// ------------------------------------------------------------
+// RecordingDevice
+// ------------------------------------------------------------
+// GpuDevice that needs no GL context. It executes nothing; it
+// counts and optionally records what the renderers submit.
+//
+// Responsibilities:
+//   ✓ Counters: draw calls, vertices, state changes (and how many
+//     of them were redundant), uniform updates, uploaded bytes,
+//     buffer (re)allocations, live objects
+//   ✓ Command capture: one entry per device call with its
+//     arguments, dumpable as text and hashable, so two runs (or a
+//     run and a stored baseline) can be compared exactly
+//   ✓ Enough bookkeeping for the renderers' queries to behave:
+//     buffer sizes, uniform locations, always-ready timer queries
+//
+// Use it to benchmark renderer CPU overhead deterministically and
+// to regression-test the command stream (bench/render_bench.cpp):
+//
+//   RecordingDevice device;
+//   GpuDevice::setCurrent(&device);
+//   renderer.init();
+//   device.resetCounters();
+//   device.setCapture(true);
+//   renderer.renderFrame(...);
+//   device.counters().drawCalls; device.captureHash();
+//
+// Not thread-safe (neither is a GL context).
+// ------------------------------------------------------------
+
+class RecordingDevice : public GpuDevice
+{
+public:
+    enum class Op : uint8_t
+    {
+        CreateBuffer, DestroyBuffer, CreateVertexArray, DestroyVertexArray,
+        BindVertexArray, BindBuffer, BufferData, BufferSubData, BufferSize,
+        VertexAttribPointer, VertexAttribEnable, VertexAttribConstant,
+        CreateTexture, DestroyTexture, UploadTexture, BindTexture,
+        CreateTextureArray, AllocateTextureArray, UploadTextureLayer, BindTextureArray,
+        CreateProgram, DestroyProgram, UseProgram, UniformLocation,
+        UniformMat4, UniformVec3, UniformFloat, UniformInt,
+        SetEnabled, BlendFunc, LineWidth, Clear,
+        DrawArrays, DrawIndexed,
+        CreateQuery, DestroyQuery, BeginQuery, EndQuery, QueryResult,
+        Finish,
+        Count
+    };
+
+    // One captured call. a/b: handles, indices, counts; c: byte
+    // sizes, offsets or a hash of the values (uniforms)
+    struct Command
+    {
+        Op       op = Op::Finish;
+        uint32_t a = 0;
+        uint32_t b = 0;
+        uint64_t c = 0;
+    };
+
+    struct Counters
+    {
+        uint64_t calls = 0;              // every device call
+        uint64_t drawCalls = 0;
+        uint64_t vertices = 0;           // vertices / indices drawn
+        uint64_t stateChanges = 0;       // binds, enables, attrib setup, blend, line width
+        uint64_t redundantStateChanges = 0;   // ...that set what was already set
+        uint64_t uniformUpdates = 0;
+        uint64_t uniformLookups = 0;
+        uint64_t uploadCalls = 0;        // buffer data/sub-data, texture uploads
+        uint64_t uploadBytes = 0;
+        uint64_t bufferAllocations = 0;  // bufferData / allocateTextureArray (storage (re)specified)
+        uint64_t textureUploads = 0;
+        uint64_t objectsCreated = 0;
+        uint64_t objectsDestroyed = 0;
+    };
+
+public:
+    RecordingDevice() = default;
+
+    RecordingDevice(const RecordingDevice&) = delete;
+    RecordingDevice& operator=(const RecordingDevice&) = delete;
+
+    const Counters& counters() const { return m_counters; }
+    void resetCounters() { m_counters = Counters(); }
+
+    // Capture off by default (counting alone is cheapest)
+    void setCapture(bool enabled) { m_capture = enabled; }
+    bool isCapturing() const { return m_capture; }
+    const std::vector<Command>& commands() const { return m_commands; }
+    void clearCapture() { m_commands.clear(); }
+
+    // FNV-1a over the captured commands
+    uint64_t captureHash() const;
+
+    // One line per command ("DrawArrays 1 0 120000" style)
+    std::string captureToText() const;
+    bool writeCapture(const std::string& path) const;
+
+    static const char* opName(Op op);
+
+    // Live objects created through this device
+    size_t liveObjects() const { return static_cast<size_t>(m_counters.objectsCreated - m_counters.objectsDestroyed); }
+
+    // ---- GpuDevice ----
+    std::string describe() const override;
+
+    Handle createBuffer() override;
+    void   destroyBuffer(Handle buffer) override;
+    Handle createVertexArray() override;
+    void   destroyVertexArray(Handle vao) override;
+
+    void bindVertexArray(Handle vao) override;
+    void bindBuffer(GpuBufferTarget target, Handle buffer) override;
+
+    void bufferData(GpuBufferTarget target, size_t bytes, const void* data, GpuBufferUsage usage) override;
+    void bufferSubData(GpuBufferTarget target, size_t offset, size_t bytes, const void* data) override;
+    size_t bufferSize(GpuBufferTarget target) override;
+
+    void vertexAttribPointer(unsigned int index, int components, GpuAttribType type,
+                             bool normalized, int stride, size_t offset) override;
+    void setVertexAttribEnabled(unsigned int index, bool enabled) override;
+    void vertexAttribConstant(unsigned int index, float x, float y, float z, float w) override;
+
+    Handle createTexture2D() override;
+    void   destroyTexture(Handle texture) override;
+    void   uploadTexture2D(Handle texture, int width, int height,
+                           const unsigned char* rgb, bool generateMipmaps) override;
+    void   bindTexture2D(unsigned int unit, Handle texture) override;
+
+    Handle createTextureArray() override;
+    void   allocateTextureArray(Handle texture, int width, int height, int layers) override;
+    void   uploadTextureLayer(Handle texture, int layer, int width, int height,
+                              const unsigned char* rgb) override;
+    void   bindTextureArray(unsigned int unit, Handle texture) override;
+
+    Handle createProgram(const std::string& vertexSrc, const std::string& fragmentSrc,
+                         std::string& errorLog) override;
+    void   destroyProgram(Handle program) override;
+    void   useProgram(Handle program) override;
+    int    uniformLocation(Handle program, const char* name) override;
+
+    void setUniformMat4(int location, const float* values) override;
+    void setUniformVec3(int location, const float* values) override;
+    void setUniformFloat(int location, float value) override;
+    void setUniformInt(int location, int value) override;
+
+    void setEnabled(GpuCapability capability, bool enabled) override;
+    void setAlphaBlendFunc() override;
+    void setLineWidth(float width) override;
+    void clear(float r, float g, float b, float a) override;
+
+    void drawArrays(GpuPrimitive primitive, int first, int count) override;
+    void drawIndexed(GpuPrimitive primitive, int count) override;
+
+    Handle createTimerQuery() override;
+    void   destroyTimerQuery(Handle query) override;
+    void   beginTimerQuery(Handle query) override;
+    void   endTimerQuery() override;
+    bool   timerQueryResult(Handle query, uint64_t& outNs) override;
+
+    void finish() override;
+
+private:
+    static constexpr int kCapabilityCount = 3;
+
+    void record(Op op, uint32_t a = 0, uint32_t b = 0, uint64_t c = 0);
+    Handle newHandle();
+    void stateChange(bool redundant);
+    void uniform(Op op, int location, const void* values, size_t bytes);
+
+    Counters m_counters;
+    bool     m_capture = false;
+    std::vector<Command> m_commands;
+
+    Handle m_nextHandle = 1;
+
+    // Bound state (redundancy tracking and buffer size queries)
+    Handle m_vertexArray = 0;
+    Handle m_buffers[2] = {};            // per GpuBufferTarget
+    Handle m_program = 0;
+    Handle m_texture = 0;
+    unsigned int m_textureUnit = 0;
+    Handle m_textureArray = 0;
+    unsigned int m_textureArrayUnit = 0;
+    bool   m_enabled[kCapabilityCount] = {};
+    bool   m_blendFuncSet = false;
+    float  m_lineWidth = 1.0f;
+
+    std::unordered_map<Handle, size_t> m_bufferSizes;
+
+    // Per program: uniform name -> location, in lookup order. Lookups
+    // repeat every frame, so they compare in place (no allocation).
+    std::unordered_map<Handle, std::vector<std::pair<std::string, int>>> m_uniforms;
+};
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 #include <glm/glm.hpp>
 
+#include "PointCloudRenderer.h"
+#include "GpuTimer.h"
+
 class Camera;
 class PointCloud;
+struct CameraImage;
 class Trajectory;
 class ImageRenderer;
 class PointCloudRenderer;
@@ -20,10 +27,12 @@ class TrajectoryRenderer;
 //   ✓ Manage viewport, clearing, buffer swapping
 //   ✓ Render full frame in correct order:
 //        1. point cloud
-//        2. camera image (texture quad)
+//        2. camera images (tiled texture quads)
 //        3. steering wheel indicator
 //        4. trajectory path
 //
+//   ✓ GPU time per pass (non-blocking timer queries), also
+//     placed on the profiler's "GPU" trace track
 //   ✓ Store camera pointer
 //   ✓ Provide renderFrame() to Application
 //
@@ -35,9 +44,36 @@ class TrajectoryRenderer;
 
 class Renderer
 {
+public:
+    // Timed passes, in draw order
+    enum GpuPass
+    {
+        GpuPassPoints,
+        GpuPassImage,
+        GpuPassTrajectory,
+        GpuPassSteeringWheel,
+        GpuPassCount
+    };
+
+    // What the last renderFrame sent to the GPU
+    struct UploadStats
+    {
+        size_t points = 0;
+        size_t bytes  = 0;   // points, normals, images, trajectory
+    };
+
+    struct GpuTimings
+    {
+        double passMs[GpuPassCount] = {};
+        double totalMs = 0.0;   // sum of the passes (clear excluded)
+    };
+
+    // Stat key of a pass ("gpu_points_ms", ...)
+    static const char* gpuPassStatName(int pass);
+
 public:
     Renderer();
-    ~Renderer() = default;
+    ~Renderer();   // sub-renderers are incomplete here
 
     // Initialize OpenGL backend and render systems
     bool init();
@@ -48,16 +84,66 @@ public:
     // Clear color & depth buffers
     void clear();
 
-    // Render the full scene (called once per frame)
-    void renderFrame(const PointCloud& pointCloud,
-                     int imageWidth,
-                     int imageHeight,
-                     const std::vector<unsigned char>& imageData,
-                     const Trajectory& trajectory);
+    // Block until the GPU has executed everything submitted so far
+    // (benchmarks: makes frame latency include GPU work)
+    void finish();
+
+    // "GL_RENDERER | GL_VERSION" (e.g. to tell llvmpipe runs apart)
+    std::string getDeviceDescription() const;
+
+    // Point shading mode (intensity heatmap or lit by normals)
+    void setPointShading(PointShading shading);
+
+    // Render the full scene (called once per frame).
+    // images: imageCount camera images, shown as tiles in that order.
+    // pointNormals: optional packed normals matching pointCloud.
+    // contentId: identifies cloud, normals and images (FrameData::
+    // loadId); the same non-zero id as last time skips their upload,
+    // 0 always uploads. The point budget needs no upload (it draws
+    // a prefix of the shuffled points).
+    void renderFrame(Camera& camera,
+                     const PointCloud& pointCloud,
+                     const CameraImage* images,
+                     int imageCount,
+                     const Trajectory& trajectory,
+                     const std::vector<uint32_t>* pointNormals = nullptr,
+                     uint64_t contentId = 0);
+
+    // Steering wheel HUD angle from the vehicle pose (yaw)
+    void updateSteeringWheel(const glm::mat4& pose);
+
+    // Point budget for the point cloud pass (0 = draw all)
+    void setPointBudget(std::size_t budget);
+    std::size_t getDrawnPointCount() const;
+
+    // GPU time of a recent frame (sum of the passes); false unless
+    // new results arrived since the last call
+    bool getGpuFrameMs(double& outMs);
+
+    const UploadStats& getLastUpload() const { return m_lastUpload; }
+
+    // Latest per-pass GPU times (a few frames old)
+    const GpuTimings& getGpuTimings() const { return m_gpuTimings; }
+
+    // Matrices used by the last renderFrame (for picking)
+    const glm::mat4& getLastView() const { return m_lastView; }
+    const glm::mat4& getLastProjection() const { return m_lastProjection; }
 
 private:
     Camera* m_camera = nullptr;
 
+    glm::mat4 m_lastView{1.0f};
+    glm::mat4 m_lastProjection{1.0f};
+
+    UploadStats m_lastUpload;
+    uint64_t    m_uploadedContent = 0;   // contentId on the GPU (0 = none)
+
+    void collectGpuTimings();
+
+    GpuTimer   m_passTimers[GpuPassCount];
+    GpuTimings m_gpuTimings;
+    bool       m_gpuTimingsNew = false;
+
     // Sub-renderers
     std::unique_ptr<PointCloudRenderer>   m_pointCloudRenderer;
     std::unique_ptr<ImageRenderer>        m_imageRenderer;
@@ -17,6 +17,7 @@
 //   - RAII for program lifetime
 //   - No file loading here (FileUtils handles that)
 //   - No GL includes here (keeps header clean)
+//   - All calls go through GpuDevice::current()
 // ------------------------------------------------------------
 
 class Shader
@@ -47,6 +48,5 @@ private:
     unsigned int m_programID = 0;
 
     // Internal helpers
-    unsigned int compileShader(unsigned int type, const std::string& src);
     int getUniformLocation(const std::string& name);
 };
@@ -13,9 +13,12 @@
 //
 // Features:
 //   ✓ Efficient line rendering using VAO/VBO
-//   ✓ Updates GPU buffer when trajectory grows
+//   ✓ Uploads the draw path once per Trajectory generation; an
+//     appended path uploads only its new vertices
+//   ✓ Draws the range [0, current frame] as a prefix of the buffer
+//   ✓ Simplified paths: a two-vertex tail from the last drawn vertex
+//     to the exact current position, so the line ends at the vehicle
 //   ✓ Uses a simple colored line (configurable in shader)
-//   ✓ Works directly with Trajectory (list of glm::vec3 points)
 //
 // Notes:
 //   - Does NOT modify trajectory data.
@@ -31,10 +34,12 @@ public:
     // Create shader + buffers
     void initialize() override;
 
-    // Update GPU buffer when trajectory changes
-    void uploadTrajectory(const Trajectory& trajectory);
+    // Sync the GPU buffer and drawn range with the trajectory (call
+    // every frame; uploads only what changed). Returns the bytes
+    // uploaded.
+    std::size_t updateTrajectory(const Trajectory& trajectory);
 
-    // Draw the line-strip
+    // Draw the line-strip up to the current frame
     void render(const glm::mat4& view,
                 const glm::mat4& projection) override;
 
@@ -42,12 +47,25 @@ private:
     unsigned int m_vao = 0;
     unsigned int m_vbo = 0;
 
+    // Last drawn vertex → current position (simplified paths)
+    unsigned int m_tailVao = 0;
+    unsigned int m_tailVbo = 0;
+
     Shader m_shader;
 
-    std::size_t m_pointCount = 0;
+    // What the buffer holds: vertices of which trajectory generation
+    const Trajectory* m_uploadedFrom = nullptr;
+    uint32_t    m_uploadedGeneration = 0;
+    std::size_t m_uploadedCount = 0;
+    std::size_t m_capacity = 0;         // vertices the buffer has room for
+
+    std::size_t m_pointCount = 0;       // drawn this frame
+    int         m_tailFrame = -1;       // frame the tail ends at, -1 = no tail
 
     bool m_isInitialized = false;
 
+    int m_memoryId = -1;   // MemoryBudget ("gpu_trajectory")
+
     void createBuffers();
 };
     
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -8,14 +10,14 @@
 namespace Logger
 {
     // ------------------------------------------------------------
-    // Log severity levels
+    // Log severity levels (ascending)
     // ------------------------------------------------------------
     enum class Level
     {
+        Debug,
         Info,
         Warning,
-        Error,
-        Debug
+        Error
     };
 
     // ------------------------------------------------------------
@@ -28,6 +30,34 @@ namespace Logger
     void enableConsole(bool state);
     void setLogLevel(Level level);
 
+    // True if messages of this level pass the runtime filter
+    bool isEnabled(Level level);
+
+    // ------------------------------------------------------------
+    // Asynchronous backend
+    // ------------------------------------------------------------
+    // After startAsync(), log() only copies the message into a
+    // lock-free MPSC ring; a writer thread formats and writes in
+    // batches (one flush per batch) and sleeps while nothing is
+    // logged. Messages longer than
+    // kMaxAsyncMessage are truncated. If the ring is full, debug and
+    // info messages are dropped and counted (the writer logs how
+    // many); warnings and errors are written synchronously instead,
+    // so they are never lost.
+    //
+    // stopAsync() drains the ring, logs the number dropped since
+    // startAsync() and returns to synchronous logging. flush() waits
+    // until everything logged so far is written.
+    // ------------------------------------------------------------
+    constexpr size_t kMaxAsyncMessage = 232;
+
+    void startAsync(size_t ringCapacity = 4096);
+    void stopAsync();
+    void flush();
+
+    // Debug/info messages dropped because the ring was full (total)
+    uint64_t getDroppedCount();
+
     // ------------------------------------------------------------
     // Core logging function
     // ------------------------------------------------------------
@@ -56,3 +86,34 @@ namespace Logger
         log(Level::Debug, msg);
     }
 }
+
+// ------------------------------------------------------------
+// Level-filtered logging macros
+// ------------------------------------------------------------
+// The message expression is only evaluated when the level passes
+// both filters, so filtered-out messages never build strings:
+//   • compile time: KITTI_LOG_MIN_LEVEL (0 debug, 1 info, 2 warn,
+//     3 error); release builds default to info
+//   • run time: Logger::setLogLevel()
+//
+//   LOG_DEBUG("frame " + std::to_string(i));   // gone in release
+// ------------------------------------------------------------
+#ifndef KITTI_LOG_MIN_LEVEL
+#  ifdef NDEBUG
+#    define KITTI_LOG_MIN_LEVEL 1
+#  else
+#    define KITTI_LOG_MIN_LEVEL 0
+#  endif
+#endif
+
+#define KITTI_LOG_AT(levelValue, level, msg)                                    \
+    do                                                                          \
+    {                                                                           \
+        if ((levelValue) >= KITTI_LOG_MIN_LEVEL && Logger::isEnabled(level))    \
+            Logger::log(level, msg);                                            \
+    } while (0)
+
+#define LOG_DEBUG(msg) KITTI_LOG_AT(0, Logger::Level::Debug, msg)
+#define LOG_INFO(msg)  KITTI_LOG_AT(1, Logger::Level::Info, msg)
+#define LOG_WARN(msg)  KITTI_LOG_AT(2, Logger::Level::Warning, msg)
+#define LOG_ERROR(msg) KITTI_LOG_AT(3, Logger::Level::Error, msg)
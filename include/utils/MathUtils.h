@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
@@ -54,4 +55,28 @@ namespace MathUtils
     // Convert KITTI rotation (3x3) to yaw angle (approx.)
     // ------------------------------------------------------------
     float extractYaw(const glm::mat4& pose);
+
+    // ------------------------------------------------------------
+    // Eigenvector of the smallest eigenvalue of a symmetric 3x3
+    // matrix (e.g. a neighbourhood covariance → surface normal).
+    // Closed-form, no iteration. Returns (0,0,0) if degenerate.
+    // ------------------------------------------------------------
+    glm::vec3 smallestEigenvector(const glm::mat3& symmetric);
+
+    // ------------------------------------------------------------
+    // Pack a unit vector into GL_INT_2_10_10_10_REV layout
+    // (signed normalized x,y,z in 10 bits each, w in 2 bits).
+    // w = 1 marks a valid normal, w = 0 an unknown one.
+    // ------------------------------------------------------------
+    uint32_t packSnorm1010102(const glm::vec3& n, int w = 1);
+
+    // ------------------------------------------------------------
+    // Un-project a point in normalized device coordinates (x,y in
+    // [-1,1]) into a world-space ray. dir is normalized.
+    // ------------------------------------------------------------
+    void ndcToWorldRay(const glm::vec2& ndc,
+                       const glm::mat4& view,
+                       const glm::mat4& projection,
+                       glm::vec3& origin,
+                       glm::vec3& dir);
 }
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ProcessStats
+{
+    // ------------------------------------------------------------
+    // Peak resident set size of this process, in bytes
+    // (0 where the platform does not report it)
+    // ------------------------------------------------------------
+    uint64_t peakRssBytes();
+
+    // ------------------------------------------------------------
+    // Current resident set size, in bytes (0 if unavailable)
+    // ------------------------------------------------------------
+    uint64_t currentRssBytes();
+
+    // ------------------------------------------------------------
+    // Bytes this process has read / written through the OS so far
+    // (Linux: /proc/self/io rchar / wchar, page cache hits included;
+    // Windows: GetProcessIoCounters). False if unavailable.
+    // ------------------------------------------------------------
+    bool ioBytes(uint64_t& readBytes, uint64_t& writtenBytes);
+}
@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec2 v_TexCoord;
+
+uniform sampler2DArray u_Images;   // one camera per layer
+uniform int u_Layer;
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(texture(u_Images, vec3(v_TexCoord, float(u_Layer))).rgb, 1.0);
+}
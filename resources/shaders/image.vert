@@ -0,0 +1,17 @@
+#version 330 core
+
+layout(location = 0) in vec2 a_Position;   // unit quad in NDC
+layout(location = 1) in vec2 a_TexCoord;   // v = 1 at the top
+
+uniform mat4 u_Model;     // unit quad -> tile rectangle
+uniform vec3 u_UvScale;   // image size / layer size (xy)
+
+out vec2 v_TexCoord;
+
+void main()
+{
+    gl_Position = u_Model * vec4(a_Position, 0.0, 1.0);
+
+    // Image rows are stored top row first
+    v_TexCoord = vec2(a_TexCoord.x, 1.0 - a_TexCoord.y) * u_UvScale.xy;
+}
@@ -0,0 +1,37 @@
+#version 330 core
+
+in float v_Intensity;
+in vec3 v_NormalView;
+in float v_HasNormal;
+
+uniform int u_ShadingMode;   // 0 = intensity heatmap, 1 = lit
+uniform vec3 u_LightDir;     // view space
+
+out vec4 FragColor;
+
+// Blue -> cyan -> green -> yellow -> red
+vec3 heatmap(float t)
+{
+    t = clamp(t, 0.0, 1.0);
+    vec3 c = vec3(
+        clamp(1.5 - abs(4.0 * t - 3.0), 0.0, 1.0),
+        clamp(1.5 - abs(4.0 * t - 2.0), 0.0, 1.0),
+        clamp(1.5 - abs(4.0 * t - 1.0), 0.0, 1.0));
+    return c;
+}
+
+void main()
+{
+    vec3 albedo = heatmap(v_Intensity);
+
+    if (u_ShadingMode == 1 && v_HasNormal > 0.5)
+    {
+        vec3 n = normalize(v_NormalView);
+        vec3 l = normalize(u_LightDir);
+        // Two-sided Lambert with a small ambient floor
+        float diffuse = abs(dot(n, l));
+        albedo *= 0.25 + 0.75 * diffuse;
+    }
+
+    FragColor = vec4(albedo, 1.0);
+}
@@ -0,0 +1,23 @@
+#version 330 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in float a_Intensity;
+layout(location = 2) in vec4 a_Normal;   // 10:10:10:2 snorm, w = 1 when valid
+
+uniform mat4 u_View;
+uniform mat4 u_Projection;
+uniform float u_PointSize;
+
+out float v_Intensity;
+out vec3 v_NormalView;
+out float v_HasNormal;
+
+void main()
+{
+    gl_Position = u_Projection * u_View * vec4(a_Position, 1.0);
+    gl_PointSize = u_PointSize;
+
+    v_Intensity = a_Intensity;
+    v_NormalView = mat3(u_View) * a_Normal.xyz;
+    v_HasNormal = a_Normal.w;
+}
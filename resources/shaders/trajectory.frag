@@ -0,0 +1,10 @@
+#version 330 core
+
+uniform vec3 u_Color;
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(u_Color, 1.0);
+}
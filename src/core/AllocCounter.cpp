@@ -0,0 +1,269 @@
+#include "AllocCounter.h"
+
+// Plain PODs: thread_local initialisation must not allocate
+thread_local const char* AllocCounter::detail::t_scope      = nullptr;
+thread_local int         AllocCounter::detail::t_allowDepth = 0;
+
+#ifdef KITTI_TRACK_ALLOCS
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    thread_local uint64_t t_allocations = 0;
+    thread_local uint64_t t_frees       = 0;
+    thread_local uint64_t t_bytes       = 0;
+
+    // No-allocation region of this thread
+    thread_local bool                    t_regionActive = false;
+    thread_local bool                    t_regionAbort  = false;
+    thread_local AllocCounter::Violation t_violation;
+
+    std::atomic<uint64_t> g_allocations{0};
+    std::atomic<uint64_t> g_frees{0};
+    std::atomic<uint64_t> g_bytes{0};
+
+    // ------------------------------------------------------------
+    // Per-scope totals: open-addressed table keyed by the name
+    // pointer, slots claimed with a CAS and never released
+    // ------------------------------------------------------------
+    constexpr int kScopeSlotBits = 9;
+    constexpr int kScopeSlots    = 1 << kScopeSlotBits;
+
+    struct ScopeSlot
+    {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t>    allocations{0};
+        std::atomic<uint64_t>    bytes{0};
+    };
+
+    ScopeSlot g_scopes[kScopeSlots];
+    ScopeSlot g_unscoped;     // allocations outside any scope
+    ScopeSlot g_overflow;     // table full
+
+    ScopeSlot& scopeSlot(const char* name)
+    {
+        if (!name)
+            return g_unscoped;
+
+        const uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(name));
+        const uint32_t start = static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - kScopeSlotBits));
+
+        for (int probe = 0; probe < kScopeSlots; ++probe)
+        {
+            ScopeSlot& slot = g_scopes[(start + probe) & (kScopeSlots - 1)];
+            const char* current = slot.name.load(std::memory_order_acquire);
+            if (current == name)
+                return slot;
+            if (!current)
+            {
+                if (slot.name.compare_exchange_strong(current, name, std::memory_order_acq_rel) ||
+                    current == name)
+                    return slot;
+            }
+        }
+        return g_overflow;
+    }
+
+    void trapAlloc(std::size_t size)
+    {
+        AllocCounter::Violation& v = t_violation;
+        if (v.allocations == 0)
+        {
+            v.firstScope = AllocCounter::detail::t_scope;
+            v.firstBytes = size;
+        }
+        ++v.allocations;
+        v.bytes += size;
+
+        if (t_regionAbort)
+        {
+            // stderr is unbuffered: printing does not allocate
+            t_regionActive = false;
+            std::fprintf(stderr, "AllocCounter: %zu-byte allocation in a no-allocation region (scope %s)\n",
+                         size, v.firstScope ? v.firstScope : "<none>");
+            std::abort();
+        }
+    }
+
+    inline void countAlloc(std::size_t size)
+    {
+        ++t_allocations;
+        t_bytes += size;
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(size, std::memory_order_relaxed);
+
+        ScopeSlot& scope = scopeSlot(AllocCounter::detail::t_scope);
+        scope.allocations.fetch_add(1, std::memory_order_relaxed);
+        scope.bytes.fetch_add(size, std::memory_order_relaxed);
+
+        if (t_regionActive && AllocCounter::detail::t_allowDepth == 0)
+            trapAlloc(size);
+    }
+
+    inline void countFree()
+    {
+        ++t_frees;
+        g_frees.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void* allocOrThrow(std::size_t size)
+    {
+        countAlloc(size);
+        if (size == 0)
+            size = 1;
+
+        while (true)
+        {
+            if (void* p = std::malloc(size))
+                return p;
+
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void* alignedAllocOrThrow(std::size_t size, std::size_t alignment)
+    {
+        countAlloc(size);
+        if (size == 0)
+            size = 1;
+
+        void* p = nullptr;
+        if (posix_memalign(&p, alignment < sizeof(void*) ? sizeof(void*) : alignment, size) != 0)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    inline void freeCounted(void* p)
+    {
+        if (!p)
+            return;
+        countFree();
+        std::free(p);
+    }
+}
+
+// ------------------------------------------------------------
+// Global operator new / delete replacements
+// ------------------------------------------------------------
+void* operator new(std::size_t size) { return allocOrThrow(size); }
+void* operator new[](std::size_t size) { return allocOrThrow(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return allocOrThrow(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return allocOrThrow(size); } catch (...) { return nullptr; }
+}
+
+void* operator new(std::size_t size, std::align_val_t al)
+{
+    return alignedAllocOrThrow(size, static_cast<std::size_t>(al));
+}
+void* operator new[](std::size_t size, std::align_val_t al)
+{
+    return alignedAllocOrThrow(size, static_cast<std::size_t>(al));
+}
+
+void operator delete(void* p) noexcept { freeCounted(p); }
+void operator delete[](void* p) noexcept { freeCounted(p); }
+void operator delete(void* p, std::size_t) noexcept { freeCounted(p); }
+void operator delete[](void* p, std::size_t) noexcept { freeCounted(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { freeCounted(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { freeCounted(p); }
+void operator delete(void* p, std::align_val_t) noexcept { freeCounted(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { freeCounted(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { freeCounted(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { freeCounted(p); }
+
+bool AllocCounter::isEnabled() { return true; }
+
+AllocCounter::Counts AllocCounter::thisThread()
+{
+    Counts c;
+    c.allocations = t_allocations;
+    c.frees       = t_frees;
+    c.bytes       = t_bytes;
+    return c;
+}
+
+AllocCounter::Counts AllocCounter::global()
+{
+    Counts c;
+    c.allocations = g_allocations.load(std::memory_order_relaxed);
+    c.frees       = g_frees.load(std::memory_order_relaxed);
+    c.bytes       = g_bytes.load(std::memory_order_relaxed);
+    return c;
+}
+
+int AllocCounter::scopeSnapshot(ScopeCounts* out, int capacity)
+{
+    if (capacity <= 0)
+        return 0;
+
+    // Keeps the 'capacity' largest, sorted (insertion; no allocation)
+    int count = 0;
+    auto consider = [&](const ScopeSlot& slot, const char* name)
+    {
+        ScopeCounts c;
+        c.name = name;
+        c.allocations = slot.allocations.load(std::memory_order_relaxed);
+        c.bytes = slot.bytes.load(std::memory_order_relaxed);
+        if (c.allocations == 0)
+            return;
+        if (count == capacity && out[count - 1].allocations >= c.allocations)
+            return;
+
+        int i = count < capacity ? count++ : count - 1;
+        for (; i > 0 && out[i - 1].allocations < c.allocations; --i)
+            out[i] = out[i - 1];
+        out[i] = c;
+    };
+
+    for (const ScopeSlot& slot : g_scopes)
+    {
+        if (const char* name = slot.name.load(std::memory_order_acquire))
+            consider(slot, name);
+    }
+    consider(g_unscoped, nullptr);
+    consider(g_overflow, "<other scopes>");
+    return count;
+}
+
+const char* AllocCounter::currentScope()
+{
+    return detail::t_scope;
+}
+
+void AllocCounter::beginNoAllocRegion(bool abortOnAlloc)
+{
+    t_violation = Violation();
+    t_regionAbort = abortOnAlloc;
+    t_regionActive = true;
+}
+
+AllocCounter::Violation AllocCounter::endNoAllocRegion()
+{
+    t_regionActive = false;
+    return t_violation;
+}
+
+#else
+
+bool AllocCounter::isEnabled() { return false; }
+AllocCounter::Counts AllocCounter::thisThread() { return Counts(); }
+AllocCounter::Counts AllocCounter::global() { return Counts(); }
+int AllocCounter::scopeSnapshot(ScopeCounts*, int) { return 0; }
+const char* AllocCounter::currentScope() { return detail::t_scope; }
+void AllocCounter::beginNoAllocRegion(bool) {}
+AllocCounter::Violation AllocCounter::endNoAllocRegion() { return Violation(); }
+
+#endif
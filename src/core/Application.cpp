@@ -2,6 +2,36 @@
 #include "Logger.h"
 #include "FileUtils.h"
 #include "Config.h"
+#include "Window.h"
+#include "InputHandler.h"
+#include "Camera.h"
+#include "JobSystem.h"
+#include "FrameArena.h"
+#include "MemoryBudget.h"
+#include "Profiler.h"
+#include "AllocCounter.h"
+#include "NormalEstimator.h"
+#include "KittiDataLoader.h"
+#include "ScanDeskewer.h"
+#include "Trajectory.h"
+#include "FramePipeline.h"
+#include "Renderer.h"
+#include "GlDevice.h"
+#include "PerfOverlay.h"
+#include "FrameStats.h"
+#include "PlaybackClock.h"
+#include "PointBudgetController.h"
+#include "KdTree.h"
+#include "PointCloud.h"
+#include "MathUtils.h"
+#include "ReplayBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
 
 #include <GLFW/glfw3.h>
 
@@ -34,6 +64,47 @@ bool Application::initialize(const std::string& configPath)
         Logger::warn("Using default configuration values.");
     }
 
+    for (const auto& setting : m_settingOverrides)
+        m_config->set(setting.first, setting.second);
+
+    // Headless replay: nothing on screen, nothing waits for input
+    if (m_benchmark)
+    {
+        m_config->set("event_driven", "false");
+        m_config->set("perf_overlay", "false");
+        m_config->set("autoplay", "false");
+        m_config->set("compare_sequences", "");
+        m_config->set("timeline", "false");
+        m_currentFrame = m_benchmark->getOptions().firstFrame;
+    }
+
+    // Log lines are written by a background thread from here on
+    if (m_config->getBool("async_logging", true))
+        Logger::startAsync(static_cast<size_t>(m_config->getInt("log_ring_size", 4096)));
+
+    // ------------------------------------------------------------
+    // Per-frame scratch memory (render thread)
+    // ------------------------------------------------------------
+    size_t arenaBytes = static_cast<size_t>(std::max(1, m_config->getInt("frame_arena_mb", 16))) << 20;
+    if (!FrameArena::mainThread().configure(arenaBytes, m_config->getBool("frame_arena_huge_pages", true)))
+        Logger::warn("Frame arena allocation failed; transient buffers fall back to the heap.");
+
+    // ------------------------------------------------------------
+    // Memory budgets for large buffers (0 = unlimited)
+    // ------------------------------------------------------------
+    MemoryBudget& memory = MemoryBudget::instance();
+    memory.setBudget(MemoryBudget::Host,
+                     static_cast<size_t>(std::max(0, m_config->getInt("host_memory_budget_mb", 0))) << 20);
+    memory.setBudget(MemoryBudget::Gpu,
+                     static_cast<size_t>(std::max(0, m_config->getInt("gpu_memory_budget_mb", 0))) << 20);
+
+    // ------------------------------------------------------------
+    // Worker pool (shared by loading, normals, ICP, index builds)
+    // ------------------------------------------------------------
+    JobSystem::instance().start(m_config->getInt("worker_threads", 0));
+    Logger::info("JobSystem: " + std::to_string(JobSystem::instance().getWorkerCount()) +
+                 " worker thread(s)");
+
     // ------------------------------------------------------------
     // Window creation
     // ------------------------------------------------------------
@@ -43,6 +114,8 @@ bool Application::initialize(const std::string& configPath)
     std::string title = m_config->getString("window_title", "KITTI Visualizer");
 
     m_window = std::make_unique<Window>(width, height, title);
+    m_window->setVisible(!m_benchmark);
+    m_window->setVSync(!m_benchmark && m_config->getBool("vsync", true));
     if (!m_window->initialize())
         return false;
 
@@ -68,28 +141,235 @@ bool Application::initialize(const std::string& configPath)
 
     Logger::info("Using KITTI sequence: " + seqPath);
 
-    m_loader = std::make_unique<KittiDataLoader>(seqPath);
-    if (!m_loader->initialize())
+    auto kittiLoader = std::make_unique<KittiDataLoader>(seqPath);
+    if (!kittiLoader->initialize())
     {
         Logger::error("Failed to load KITTI sequence.");
         return false;
     }
 
+    // Sequences without poses.txt (e.g. test 11–21): ICP odometry
+    if (m_config->getBool("odometry_fallback", true))
+    {
+        IcpOdometry::Params odo;
+        odo.sourceVoxelSize = m_config->getFloat("odometry_voxel_size", odo.sourceVoxelSize);
+        kittiLoader->enableOdometryFallback(odo);
+    }
+    m_loader = std::move(kittiLoader);
+
+    // Further sequences for side-by-side comparison (Tab cycles). Each
+    // costs its manifest only: frames, decode jobs and buffers come
+    // from the shared pipeline below.
+    std::stringstream compareList(m_config->getString("compare_sequences", ""));
+    std::string comparePath;
+    while (std::getline(compareList, comparePath, ','))
+    {
+        comparePath.erase(0, comparePath.find_first_not_of(" \t"));
+        comparePath.erase(comparePath.find_last_not_of(" \t") + 1);
+        if (comparePath.empty())
+            continue;
+
+        auto loader = std::make_unique<KittiDataLoader>(comparePath);
+        if (!loader->initialize())
+        {
+            Logger::warn("Skipping comparison sequence: " + comparePath);
+            continue;
+        }
+        if (m_config->getBool("odometry_fallback", true))
+        {
+            IcpOdometry::Params odo;
+            odo.sourceVoxelSize = m_config->getFloat("odometry_voxel_size", odo.sourceVoxelSize);
+            loader->enableOdometryFallback(odo);
+        }
+        Logger::info("Comparison sequence: " + comparePath);
+        m_compareLoaders.push_back(std::move(loader));
+    }
+
     // ------------------------------------------------------------
     // Trajectory
     // ------------------------------------------------------------
-    m_trajectory = std::make_unique<Trajectory>();
+    Trajectory::Params trajectory;
+    trajectory.simplifyMinPoints = static_cast<size_t>(
+        std::max(0, m_config->getInt("trajectory_simplify_poses", 100000)));
+    trajectory.simplifyTolerance = m_config->getFloat("trajectory_simplify_tolerance", trajectory.simplifyTolerance);
+    m_trajectory = std::make_unique<Trajectory>(trajectory);
+    buildTrajectory(*m_loader);
 
     // ------------------------------------------------------------
     // Renderer
     // ------------------------------------------------------------
+    m_gpuDevice = std::make_unique<GlDevice>();
+    GpuDevice::setCurrent(m_gpuDevice.get());
+
     m_renderer = std::make_unique<Renderer>();
-    if (!m_renderer->initialize())
+    if (!m_renderer->init())
     {
         Logger::error("Renderer failed to initialize.");
         return false;
     }
 
+    // ------------------------------------------------------------
+    // Point shading (optional normal estimation stage)
+    // ------------------------------------------------------------
+    std::string shading = m_config->getString("point_shading", "intensity");
+    if (shading == "lit")
+    {
+        m_normalEstimator = std::make_unique<NormalEstimator>();
+        m_renderer->setPointShading(PointShading::Lit);
+        Logger::info("Point shading: lit (normal estimation enabled)");
+    }
+
+    // ------------------------------------------------------------
+    // Motion compensation (optional)
+    // ------------------------------------------------------------
+    if (m_config->getBool("deskew", false))
+    {
+        m_deskewer = std::make_unique<ScanDeskewer>();
+        Logger::info("Scan deskew enabled.");
+    }
+
+    // ------------------------------------------------------------
+    // Loader thread → render thread handoff
+    // ------------------------------------------------------------
+    FramePipeline::Params pipeline;
+    pipeline.bufferCount   = m_config->getInt("frame_buffers", 4);
+    pipeline.reservePoints = static_cast<size_t>(m_config->getInt("reserve_points", 131072));
+
+    // Camera streams shown as tiles (image_0 .. image_3), decoded in parallel
+    pipeline.cameras.clear();
+    std::stringstream cameraList(m_config->getString("cameras", "2"));
+    std::string camera;
+    while (std::getline(cameraList, camera, ','))
+    {
+        char* end = nullptr;
+        const long index = std::strtol(camera.c_str(), &end, 10);
+        if (end == camera.c_str() || *end != '\0' || index < 0 || index > 3 ||
+            std::find(pipeline.cameras.begin(), pipeline.cameras.end(), index) != pipeline.cameras.end())
+        {
+            Logger::warn("cameras: ignoring '" + camera + "' (expected distinct indices 0-3)");
+            continue;
+        }
+        pipeline.cameras.push_back(static_cast<int>(index));
+    }
+    m_pipeline = std::make_unique<FramePipeline>(*m_loader, pipeline);
+    for (const auto& loader : m_compareLoaders)
+        m_pipeline->addStream(*loader);
+    m_streamFrames.assign(m_pipeline->getStreamCount(), nullptr);
+    m_pipeline->setPrepare([this](FrameData& frame) { prepareFrame(frame); });
+
+    // Timeline scrubbing with background thumbnails (one strip per
+    // stream; only the displayed one is generated)
+    if (m_config->getBool("timeline", true))
+    {
+        ThumbnailStrip::Params thumbnails;
+        thumbnails.maxThumbnails = m_config->getInt("timeline_thumbnails", thumbnails.maxThumbnails);
+        thumbnails.previewPoints = m_config->getInt("timeline_preview_points", thumbnails.previewPoints);
+        thumbnails.imageWidth    = m_config->getInt("timeline_thumbnail_width", thumbnails.imageWidth);
+        thumbnails.cameras       = pipeline.cameras;
+        for (int stream = 0; stream < m_pipeline->getStreamCount(); ++stream)
+            m_thumbnails.push_back(std::make_unique<ThumbnailStrip>(m_pipeline->getLoader(stream), thumbnails));
+
+        m_timelineHeight = m_config->getFloat("timeline_height", 28.0f);
+        m_seekTargetMs   = m_config->getFloat("seek_target_ms", 50.0f);
+        m_inputHandler->setTimelineHeight(m_timelineHeight);
+    }
+
+    // Idle-aware loop: input via callbacks, sleep while nothing changes
+    m_eventDriven = m_config->getBool("event_driven", false);
+    m_idleTimeout = m_config->getFloat("idle_timeout", 0.5f);
+    if (m_eventDriven)
+    {
+        m_inputHandler->enableEventQueue(*m_window);
+
+        Window* window = m_window.get();
+        m_pipeline->setReadyCallback([window]() { window->postEmptyEvent(); });
+        Logger::info("Event-driven main loop enabled.");
+    }
+    m_pipeline->start(m_currentFrame);
+
+    // ------------------------------------------------------------
+    // Playback clock (KITTI LiDAR runs at 10 Hz)
+    // ------------------------------------------------------------
+    m_playback = std::make_unique<PlaybackClock>(m_config->getFloat("playback_rate_hz", 10.0f));
+    m_playback->setSpeed(m_config->getFloat("playback_speed", 1.0f));
+    m_playback->setLooping(m_config->getBool("playback_loop", false));
+    if (m_config->getBool("autoplay", false))
+        m_playback->play(m_currentFrame);
+
+    // ------------------------------------------------------------
+    // Adaptive point budget (0 = always draw every point)
+    // ------------------------------------------------------------
+    float targetFrameMs = m_config->getFloat("target_frame_ms", 0.0f);
+    if (targetFrameMs > 0.0f)
+    {
+        PointBudgetController::Params budget;
+        budget.targetMs  = targetFrameMs;
+        budget.minPoints = static_cast<size_t>(m_config->getInt("min_point_budget", 10000));
+        m_pointBudget = std::make_unique<PointBudgetController>(budget);
+        Logger::info("Point budget: targeting " + std::to_string(targetFrameMs) + " ms per frame");
+    }
+
+    // ------------------------------------------------------------
+    // Picking + stats
+    // ------------------------------------------------------------
+    m_pickRadiusPx    = m_config->getFloat("pick_radius_px", 6.0f);
+    m_pickQueryRadius = m_config->getFloat("pick_query_radius", 1.0f);
+
+    // One tree on display + one building; one snapshot per build
+    size_t reservePoints = pipeline.reservePoints;
+    m_kdTreePool   = std::make_unique<BufferPool<KdTree>>(2);
+    m_snapshotPool = std::make_unique<BufferPool<PointCloud>>(1, [reservePoints](PointCloud& cloud)
+    {
+        cloud.reserve(reservePoints);
+    });
+
+    // Idle trees and snapshots are the cheapest memory to give back:
+    // a miss on the next build just allocates again
+    m_kdTreePool->setSizeFn([](const KdTree& tree) { return tree.memoryBytes(); });
+    m_snapshotPool->setSizeFn([](const PointCloud& cloud)
+    {
+        return cloud.getPoints().capacity() * sizeof(PointCloud::Point);
+    });
+    m_kdTreeMemoryId = memory.add("kd_trees", MemoryBudget::Host,
+                                  [this](size_t) { return m_kdTreePool->trim(); }, 1);
+    m_snapshotMemoryId = memory.add("pick_snapshots", MemoryBudget::Host,
+                                    [this](size_t) { return m_snapshotPool->trim(); }, 1);
+    m_statsInterval   = m_config->getFloat("stats_interval", 1.0f);
+    m_tracePath       = m_config->getString("trace_path", "kitti_trace.json");
+    if (m_config->getBool("trace_on_start", false))
+        Profiler::startCapture();
+
+    const std::string allocCheck = m_config->getString("alloc_check", "off");
+    if (allocCheck == "warn" || allocCheck == "assert")
+    {
+        if (AllocCounter::isEnabled())
+        {
+            m_allocCheck = true;
+            m_allocCheckAbort = allocCheck == "assert";
+            m_allocCheckWarmup = std::max(0, m_config->getInt("alloc_check_warmup_frames", 300));
+        }
+        else
+        {
+            Logger::warn("alloc_check needs a build with KITTI_TRACK_ALLOCS; check disabled.");
+        }
+    }
+    else if (allocCheck != "off")
+    {
+        Logger::warn("Unknown alloc_check '" + allocCheck + "'; expected off, warn or assert.");
+    }
+
+    // Created last: the window's input callbacks are already in place.
+    // Also draws the timeline, so it exists when only that is on.
+    const bool perfPanel = m_config->getBool("perf_overlay", true);
+    if (perfPanel || !m_thumbnails.empty())
+    {
+        m_overlay = std::make_unique<PerfOverlay>();
+        m_overlay->setVisible(perfPanel);
+        if (!m_overlay->initialize(m_window->getNativeHandle()))
+            m_overlay.reset();
+    }
+    m_stats = std::make_unique<FrameStats>();
+
     Logger::info("Application initialized successfully.");
     return true;
 }
@@ -97,72 +377,917 @@ bool Application::initialize(const std::string& configPath)
 void Application::run()
 {
     Logger::info("Starting main loop...");
+    Profiler::setThreadName("main");
+
+    using Clock = std::chrono::steady_clock;
 
     while (!m_window->shouldClose())
     {
+        // Event-driven mode: sleep until input, playback or the loader
+        // has something new
+        if (m_eventDriven)
+            waitForWork();
+
+        PROFILE_SCOPE("Application::frame");
+
+        auto frameStart = Clock::now();
+        const AllocCounter::Counts allocsAtStart = AllocCounter::thisThread();
+        beginAllocCheck();
+
         // -------------------------------
         // Handle input
         // -------------------------------
         m_inputHandler->update();
+        if (m_inputHandler->hadActivity() || m_inputHandler->wantsContinuousUpdate())
+            m_dirty = true;
 
-        // Frame navigation
-        if (m_inputHandler->nextFrameRequested())
-            nextFrame();
-        else if (m_inputHandler->prevFrameRequested())
-            prevFrame();
+        if (m_inputHandler->traceToggleRequested())
+        {
+            AllocCounter::AllowAllocs userAction;
+            toggleTraceCapture();
+        }
+
+        if (m_overlay && m_inputHandler->overlayToggleRequested())
+        {
+            m_overlay->toggle();
+            m_dirty = true;
+        }
+
+        if (m_inputHandler->sequenceSwitchRequested())
+            switchSequence();
+
+        // Frame navigation (manual stepping, timed playback, timeline)
+        updatePlayback();
+        updateTimeline();
 
         // -------------------------------
-        // Load data for current frame
+        // Take the current frame from the loader thread
         // -------------------------------
-        glm::mat4 pose = m_loader->loadPose(m_currentFrame);
-        PointCloud cloud = m_loader->loadPointCloud(m_currentFrame);
+        m_pipeline->request(m_currentFrame, m_activeStream);
+        if (FrameData* ready = m_pipeline->acquire(m_currentFrame, m_activeStream))
+        {
+            m_pipeline->release(m_displayed);
+            m_displayed = ready;
+            onFrameArrived(*m_displayed);
+            m_dirty = true;
+
+            // The full frame replaces any preview
+            m_preview = nullptr;
+            m_seekLanded = m_seekPending && ready->frameIndex == m_seekFrame;
+            m_seekPending = false;
+        }
+        updateHiddenStreams();
+
+        if (m_displayed && !m_preview)
+        {
+            // Pick index follows the displayed frame
+            updatePickIndex(*m_displayed);
+            if (m_inputHandler->pickRequested())
+            {
+                AllocCounter::AllowAllocs userAction;
+                pickPoint();
+            }
+        }
+
+        // GL uploads queued by background jobs
+        JobSystem::instance().runMainThreadJobs();
+
+        // Nothing changed: keep the last image on screen. The end of
+        // frame bookkeeping still runs, so the arena is reset and the
+        // stats report keeps its interval while idle.
+        if (m_eventDriven && !m_dirty)
+        {
+            endFrameMemory(allocsAtStart);
+            endAllocCheck();
+            reportStats(false);
+            continue;
+        }
 
-        int imgW, imgH;
-        std::vector<unsigned char> imageData;
-        m_loader->loadImage(m_currentFrame, imgW, imgH, imageData);
+        if (m_preview)
+        {
+            // Seek in progress: the nearest thumbnail until the frame lands
+            m_renderer->renderFrame(
+                *m_camera,
+                m_preview->cloud,
+                m_preview->images, m_preview->imageCount,
+                *m_trajectory,
+                nullptr
+            );
+        }
+        else if (m_displayed)
+        {
+            // -------------------------------
+            // Render everything
+            // -------------------------------
+            m_renderer->renderFrame(
+                *m_camera,
+                m_displayed->cloud,
+                m_displayed->images, m_displayed->imageCount,
+                *m_trajectory,
+                m_displayed->hasNormals ? &m_displayed->normals : nullptr,
+                m_displayed->loadId
+            );
+        }
 
-        // Update trajectory
-        glm::vec3 pos = MathUtils::extractTranslation(pose);
-        m_trajectory->addPoint(pos);
+        renderOverlay();
 
-        // Update steering wheel orientation
-        m_renderer->updateSteeringWheel(pose);
+        // CPU side of the frame, before the swap can block on vsync
+        updatePointBudget(std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
 
         // -------------------------------
-        // Render everything
+        // Swap buffers
         // -------------------------------
+        {
+            PROFILE_SCOPE("Window::swapBuffers");
+            if (m_eventDriven)
+            {
+                m_window->swapBuffers();
+                m_dirty = false;
+            }
+            else
+            {
+                m_window->update();
+            }
+        }
+
+        endSeek();
+        endFrameMemory(allocsAtStart);
+        endAllocCheck();
+        reportStats();
+    }
+}
+
+void Application::overrideSetting(const std::string& key, const std::string& value)
+{
+    m_settingOverrides.emplace_back(key, value);
+}
+
+void Application::enableBenchmark(const ReplayBenchmark::Options& options)
+{
+    m_benchmark = std::make_unique<ReplayBenchmark>(options);
+}
+
+bool Application::runBenchmark()
+{
+    if (!m_benchmark)
+        return false;
+
+    Profiler::setThreadName("main");
+
+    using Clock = std::chrono::steady_clock;
+
+    int first = 0, end = 0;
+    if (!m_benchmark->frameRange(m_loader->getTotalFrames(), first, end))
+    {
+        Logger::error("Benchmark: sequence too short for the warm-up plus one measured frame.");
+        return false;
+    }
+
+    const int warmupEnd = first + m_benchmark->getOptions().warmupFrames;
+    Logger::info("Benchmark: replaying frames " + std::to_string(first) + ".." + std::to_string(end - 1) +
+                 " (" + std::to_string(warmupEnd - first) + " warm-up)");
+
+    for (int step = 0; first + step < end && !m_window->shouldClose(); ++step)
+    {
+        if (first + step == warmupEnd)
+            m_benchmark->begin();
+        const int frame = m_benchmark->frameAt(step, first, end);
+
+        PROFILE_SCOPE("Application::benchmarkFrame");
+
+        auto frameStart = Clock::now();
+        const AllocCounter::Counts allocsAtStart = AllocCounter::thisThread();
+
+        // Wait for the loader instead of skipping (in order, or a seek)
+        m_currentFrame = frame;
+        if (m_benchmark->getOptions().seeks)
+            m_pipeline->seek(frame);
+        else
+            m_pipeline->request(frame);
+        FrameData* ready = nullptr;
+        const bool onScreen = m_displayed && m_displayed->frameIndex == frame;   // a seek may repeat
+        while (!onScreen && !(ready && ready->frameIndex == frame))
+        {
+            // acquire() may hand out an older frame first; the
+            // benchmark times the requested one
+            m_pipeline->release(ready);
+            if (!(ready = m_pipeline->acquire(frame)))
+            {
+                JobSystem::instance().runMainThreadJobs();
+                std::this_thread::yield();
+            }
+        }
+        const double waitMs = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+
+        if (ready)
+        {
+            m_pipeline->release(m_displayed);
+            m_displayed = ready;
+            onFrameArrived(*m_displayed);
+        }
+        updatePickIndex(*m_displayed);
+        JobSystem::instance().runMainThreadJobs();
+
         m_renderer->renderFrame(
             *m_camera,
-            cloud,
-            imageData, imgW, imgH,
-            *m_trajectory
+            m_displayed->cloud,
+            m_displayed->images, m_displayed->imageCount,
+            *m_trajectory,
+            m_displayed->hasNormals ? &m_displayed->normals : nullptr,
+            m_displayed->loadId
         );
 
-        // -------------------------------
-        // Swap buffers
-        // -------------------------------
-        m_window->update();
+        updatePointBudget(std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
+
+        // Latency ends when the GPU is done with the frame
+        m_window->swapBuffers();
+        m_window->pollEvents();
+        m_renderer->finish();
+
+        const double frameMs = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+        if (m_benchmark->hasBegun())
+            m_benchmark->addFrame(frameMs, waitMs, m_renderer->getDrawnPointCount(),
+                                  m_renderer->getLastUpload().bytes);
+
+        endFrameMemory(allocsAtStart);
+        reportStats();
+    }
+
+    if (!m_benchmark->hasBegun())
+    {
+        Logger::error("Benchmark: window closed during warm-up.");
+        return false;
     }
+
+    m_benchmark->end();
+    Logger::info("Benchmark: " + m_benchmark->describe());
+
+    const std::string& jsonPath = m_benchmark->getOptions().jsonPath;
+    if (!jsonPath.empty())
+    {
+        if (!m_benchmark->writeJson(jsonPath, m_renderer->getDeviceDescription()))
+        {
+            Logger::error("Benchmark: could not write " + jsonPath);
+            return false;
+        }
+        Logger::info("Benchmark: results written to " + jsonPath);
+    }
+    return true;
+}
+
+void Application::waitForWork()
+{
+    // Already dirty (or keys held): just pick up pending events
+    if (m_dirty || m_inputHandler->wantsContinuousUpdate())
+    {
+        m_window->pollEvents();
+        return;
+    }
+
+    // Wake for the next playback frame, new input, a loaded frame
+    // (the loader posts an empty event) or the idle timeout
+    double timeout = m_idleTimeout;
+    if (m_playback->isPlaying())
+        timeout = std::min(timeout, m_playback->secondsUntilNextFrame());
+
+    // Thumbnails are started from the loop, so keep it turning
+    if (!m_thumbnails.empty() && !m_thumbnails[m_activeStream]->isComplete())
+        timeout = std::min(timeout, 0.05);
+
+    m_window->waitEvents(timeout);
+}
+
+void Application::prepareFrame(FrameData& frame)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Runs on the loader thread: only touches the frame itself and
+    // stages used nowhere else.
+    PROFILE_SCOPE("Application::prepareFrame");
+
+    if (m_deskewer)
+    {
+        auto t0 = Clock::now();
+        deskewCloud(frame);
+        frame.addStage("deskew_ms", std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+    }
+
+    if (m_normalEstimator)
+    {
+        auto t0 = Clock::now();
+        m_normalEstimator->estimatePacked(frame.cloud, frame.normals);
+        frame.hasNormals = true;
+        frame.addStage("normals_ms", std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+    }
+}
+
+void Application::onFrameArrived(const FrameData& frame)
+{
+    PROFILE_SCOPE("Application::onFrameArrived");
+
+    m_stats->record("frame_load_ms", frame.loadMs);
+    m_stats->record("frame_prepare_ms", frame.prepareMs);
+    for (int i = 0; i < frame.stageCount; ++i)
+        m_stats->record(frame.stages[i].name, frame.stages[i].ms);
+
+    m_lastPointCount = frame.cloud.size();
+
+    // The path is drawn up to this frame. Estimated poses join it in
+    // frame order, including those of frames playback skipped past;
+    // append() interpolates any the loader does not know.
+    IKittiLoader& loader = activeLoader();
+    if (!loader.hasPoseFile())
+    {
+        const int first = static_cast<int>(m_trajectory->size());
+        m_knownPoses.clear();
+        loader.getKnownPoses(first, m_knownPoses);
+        for (size_t i = 0; i < m_knownPoses.size(); ++i)
+            m_trajectory->append(first + static_cast<int>(i),
+                                 MathUtils::extractTranslation(m_knownPoses[i]));
+    }
+    m_trajectory->setCurrentFrame(frame.frameIndex);
+
+    // An estimated pose may have been registered since the load
+    glm::mat4 pose = frame.pose;
+    if (!frame.hasPose && !loader.tryGetPose(frame.frameIndex, pose))
+        return;
+
+    m_trajectory->append(frame.frameIndex, MathUtils::extractTranslation(pose));
+
+    // Update steering wheel orientation
+    m_renderer->updateSteeringWheel(pose);
+}
+
+void Application::buildTrajectory(IKittiLoader& loader)
+{
+    PROFILE_SCOPE("Application::buildTrajectory");
+
+    // Odometry poses cost a registration each and belong to the
+    // odometry thread: onFrameArrived appends them from getKnownPoses
+    if (!loader.hasPoseFile())
+    {
+        m_trajectory->clear();
+        return;
+    }
+
+    std::vector<glm::vec3> positions(static_cast<size_t>(std::max(0, loader.getTotalFrames())));
+    for (size_t i = 0; i < positions.size(); ++i)
+        positions[i] = MathUtils::extractTranslation(loader.loadPose(static_cast<int>(i)));
+    m_trajectory->build(std::move(positions));
+}
+
+IKittiLoader& Application::activeLoader() const
+{
+    return m_pipeline->getLoader(m_activeStream);
+}
+
+void Application::updateHiddenStreams()
+{
+    // Hidden sequences follow the displayed frame index, so switching
+    // to one shows the same moment without waiting for a load
+    for (int stream = 0; stream < m_pipeline->getStreamCount(); ++stream)
+    {
+        if (stream == m_activeStream)
+            continue;
+
+        const int frame = std::min(m_currentFrame, m_pipeline->getLoader(stream).getTotalFrames() - 1);
+        m_pipeline->request(frame, stream);
+        if (FrameData* ready = m_pipeline->acquire(frame, stream))
+        {
+            m_pipeline->release(m_streamFrames[stream]);
+            m_streamFrames[stream] = ready;
+        }
+    }
+}
+
+void Application::switchSequence()
+{
+    const int count = m_pipeline->getStreamCount();
+    if (count < 2)
+        return;
+
+    // The outgoing frame stays held for its stream
+    m_streamFrames[m_activeStream] = m_displayed;
+    m_activeStream = (m_activeStream + 1) % count;
+    m_droppedReported = m_pipeline->getSkippedCount(m_activeStream) +
+                        m_pipeline->getDiscardedCount(m_activeStream);
+    m_displayed = m_streamFrames[m_activeStream];
+    m_streamFrames[m_activeStream] = nullptr;
+
+    m_currentFrame = std::min(m_currentFrame, activeLoader().getTotalFrames() - 1);
+
+    // A preview belongs to the outgoing sequence's strip
+    m_preview = nullptr;
+    m_seekPending = false;
+
+    // The trajectory is per sequence
+    buildTrajectory(activeLoader());
+    if (m_displayed)
+        onFrameArrived(*m_displayed);
+    m_dirty = true;
+
+    Logger::info("Showing sequence " + std::to_string(m_activeStream + 1) + "/" + std::to_string(count) +
+                 ": " + activeLoader().getSequencePath());
+}
+
+void Application::updatePlayback()
+{
+    PROFILE_SCOPE("Application::updatePlayback");
+
+    if (m_inputHandler->playToggleRequested())
+    {
+        m_playback->toggle(m_currentFrame);
+        Logger::info(m_playback->isPlaying() ? "Playback: play" : "Playback: pause");
+    }
+
+    if (m_inputHandler->speedUpRequested() || m_inputHandler->speedDownRequested())
+    {
+        double factor = m_inputHandler->speedUpRequested() ? 2.0 : 0.5;
+        m_playback->setSpeed(m_playback->getSpeed() * factor);
+        Logger::info("Playback speed: x" + std::to_string(m_playback->getSpeed()));
+    }
+
+    // Manual stepping takes over from the clock
+    if (m_inputHandler->nextFrameRequested() || m_inputHandler->prevFrameRequested())
+    {
+        m_playback->pause();
+
+        if (m_inputHandler->nextFrameRequested())
+            nextFrame();
+        else
+            prevFrame();
+        return;
+    }
+
+    if (m_playback->isPlaying())
+    {
+        // Wall-clock target: slow frames skip ahead instead of slowing playback
+        m_currentFrame = m_playback->update(activeLoader().getTotalFrames());
+        if (!m_playback->isPlaying())
+            Logger::info("Playback: reached end of sequence");
+    }
+}
+
+void Application::updateTimeline()
+{
+    if (m_thumbnails.empty())
+        return;
+
+    // Background previews; paused while a seek loads so its decode
+    // jobs have the workers
+    ThumbnailStrip& strip = *m_thumbnails[m_activeStream];
+    if (!m_seekPending)
+        strip.update();
+
+    if (!m_inputHandler->timelineScrubbing())
+        return;
+
+    const int total = activeLoader().getTotalFrames();
+    if (total <= 0)
+        return;
+
+    const float position = m_inputHandler->getTimelinePosition();
+    const int frame = std::min(static_cast<int>(position * (total - 1) + 0.5f), total - 1);
+    if (frame != m_currentFrame)
+        seekTo(frame);
+}
+
+void Application::seekTo(int frame)
+{
+    PROFILE_SCOPE("Application::seekTo");
+
+    // The pipeline cancels whatever it was loading for the old
+    // position and starts on this frame (hidden sequences follow)
+    m_playback->pause();
+    m_currentFrame = frame;
+    for (int stream = 0; stream < m_pipeline->getStreamCount(); ++stream)
+        m_pipeline->seek(std::min(frame, m_pipeline->getLoader(stream).getTotalFrames() - 1), stream);
+
+    m_seekPending = true;
+    m_seekFrame = frame;
+    m_seekStart = std::chrono::steady_clock::now();
+
+    // Something close is on screen this frame; the full one follows
+    m_preview = m_thumbnails[m_activeStream]->nearest(frame);
+    m_dirty = true;
+}
+
+void Application::endSeek()
+{
+    if (!m_seekLanded)
+        return;
+    m_seekLanded = false;
+
+    // Seek → seeked frame swapped to the screen
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_seekStart).count();
+    m_stats->record("seek_ms", ms);
+    if (ms > m_seekTargetMs)
+        m_stats->record("seeks_slow", static_cast<double>(++m_slowSeeks));
+}
+
+void Application::endFrameMemory(const AllocCounter::Counts& atFrameStart)
+{
+    FrameArena& arena = FrameArena::mainThread();
+    m_stats->record("arena_kb", arena.getUsed() / 1024.0);
+    if (arena.getOverflowCount() > 0)
+        m_stats->record("arena_overflows", static_cast<double>(arena.getOverflowCount()));
+    arena.reset();
+
+    // Heap allocations made by the render thread this frame
+    if (AllocCounter::isEnabled())
+    {
+        AllocCounter::Counts now = AllocCounter::thisThread();
+        m_stats->record("frame_allocs", static_cast<double>(now.allocations - atFrameStart.allocations));
+        m_stats->record("frame_alloc_kb", (now.bytes - atFrameStart.bytes) / 1024.0);
+    }
+
+    // Pools only grow on a miss; a rising count means they are undersized
+    if (m_kdTreePool)
+        m_stats->record("pool_misses", static_cast<double>(m_kdTreePool->getMisses() +
+                                                           m_snapshotPool->getMisses()));
+
+    updateMemoryBudget();
+}
+
+void Application::updateMemoryBudget()
+{
+    MemoryBudget& memory = MemoryBudget::instance();
+    if (m_kdTreePool)
+    {
+        memory.setUsage(m_kdTreeMemoryId, m_kdTreePool->getBytes());
+        memory.setUsage(m_snapshotMemoryId, m_snapshotPool->getBytes());
+    }
+
+    memory.enforce();
+
+    // Per subsystem ("mem_frame_images_mb", ...) and totals
+    MemoryBudget::Usage usage[MemoryBudget::kMaxSubsystems];
+    int count = memory.snapshot(usage, MemoryBudget::kMaxSubsystems);
+    for (int i = 0; i < count; ++i)
+        m_stats->record(usage[i].statName, usage[i].bytes / (1024.0 * 1024.0));
+
+    m_stats->record("mem_host_mb", memory.getTotal(MemoryBudget::Host) / (1024.0 * 1024.0));
+    m_stats->record("mem_gpu_mb", memory.getTotal(MemoryBudget::Gpu) / (1024.0 * 1024.0));
+    if (memory.getEvictionCount() > 0)
+        m_stats->record("mem_evictions", static_cast<double>(memory.getEvictionCount()));
+}
+
+void Application::beginAllocCheck()
+{
+    if (!m_allocCheck)
+        return;
+
+    // Startup, first uploads and pool growth happen during the warm-up
+    if (m_allocCheckWarmup > 0)
+    {
+        if (--m_allocCheckWarmup == 0)
+            Logger::info("alloc_check: warm-up done, render thread frames must not allocate from now on");
+        return;
+    }
+
+    AllocCounter::beginNoAllocRegion(m_allocCheckAbort);
+    m_allocCheckArmed = true;
+}
+
+void Application::endAllocCheck()
+{
+    if (!m_allocCheckArmed)
+        return;
+    m_allocCheckArmed = false;
+
+    const AllocCounter::Violation v = AllocCounter::endNoAllocRegion();
+    if (v.allocations == 0)
+        return;
+
+    // The first few are logged; the stat keeps counting after that
+    constexpr uint64_t kLoggedViolations = 10;
+    if (++m_allocViolations <= kLoggedViolations)
+    {
+        Logger::error("alloc_check: frame made " + std::to_string(v.allocations) + " heap allocations (" +
+                      std::to_string(v.bytes) + " bytes); first: " + std::to_string(v.firstBytes) +
+                      " bytes in " + (v.firstScope ? v.firstScope : "<no scope>"));
+        if (m_allocViolations == kLoggedViolations)
+            Logger::warn("alloc_check: further violations are only counted (alloc_violations)");
+    }
+    m_stats->record("alloc_violations", static_cast<double>(m_allocViolations));
+}
+
+void Application::logAllocScopes()
+{
+    if (!AllocCounter::isEnabled())
+        return;
+
+    constexpr int kTopScopes = 10;
+    AllocCounter::ScopeCounts scopes[kTopScopes];
+    const int count = AllocCounter::scopeSnapshot(scopes, kTopScopes);
+    if (count == 0)
+        return;
+
+    const AllocCounter::Counts total = AllocCounter::global();
+    Logger::info("Heap allocations: " + std::to_string(total.allocations) + " (" +
+                 std::to_string(total.bytes / (1024 * 1024)) + " MB requested); top scopes:");
+    for (int i = 0; i < count; ++i)
+    {
+        Logger::info("  " + std::string(scopes[i].name ? scopes[i].name : "<no scope>") + ": " +
+                     std::to_string(scopes[i].allocations) + " allocations, " +
+                     std::to_string(scopes[i].bytes / 1024) + " KB");
+    }
+}
+
+void Application::updatePointBudget(double cpuFrameMs)
+{
+    m_stats->record("cpu_frame_ms", cpuFrameMs);
+
+    // GPU results arrive a few frames late; reuse the last one meanwhile
+    double gpuMs = 0.0;
+    if (m_renderer->getGpuFrameMs(gpuMs))
+        m_lastGpuFrameMs = gpuMs;
+    m_stats->record("gpu_frame_ms", m_lastGpuFrameMs);
+
+    const Renderer::GpuTimings& gpu = m_renderer->getGpuTimings();
+    for (int pass = 0; pass < Renderer::GpuPassCount; ++pass)
+        m_stats->record(Renderer::gpuPassStatName(pass), gpu.passMs[pass]);
+
+    m_stats->record("upload_kb", m_renderer->getLastUpload().bytes / 1024.0);
+
+    if (m_overlay)
+        m_overlay->addSample(static_cast<float>(cpuFrameMs), static_cast<float>(m_lastGpuFrameMs));
+
+    if (!m_pointBudget)
+        return;
+
+    size_t budget = m_pointBudget->update(cpuFrameMs, m_lastGpuFrameMs, m_lastPointCount);
+    m_renderer->setPointBudget(budget);
+    m_stats->record("points_drawn", static_cast<double>(m_renderer->getDrawnPointCount()));
+}
+
+void Application::updatePickIndex(const FrameData& frame)
+{
+    PROFILE_SCOPE("Application::updatePickIndex");
+
+    using Clock = std::chrono::steady_clock;
+
+    // Collect a finished build
+    if (m_kdTreeJob.valid() && m_kdTreeJob.isDone())
+    {
+        m_kdTree = std::move(m_kdTreeBuild->tree);   // previous tree goes back to the pool
+        m_kdTreeFrame = m_kdTreeBuild->frame;
+        m_kdTreeStream = m_kdTreeBuild->stream;
+        m_stats->record("kdtree_build_ms", m_kdTreeBuild->buildMs);
+
+        m_kdTreeJob = JobSystem::TaskHandle();
+        m_kdTreeBuild.reset();
+    }
+
+    // One build in flight at a time; a stale result is replaced by
+    // the next build as soon as it lands.
+    const bool current = m_kdTreeFrame == frame.frameIndex && m_kdTreeStream == frame.stream;
+    if (!current && !m_kdTreeJob.valid())
+    {
+        // The frame buffer may be recycled while the job runs, so the
+        // build works on a snapshot (assignment reuses its capacity)
+        auto build = std::make_shared<KdTreeBuild>();
+        build->frame    = frame.frameIndex;
+        build->stream   = frame.stream;
+        build->tree     = m_kdTreePool->acquire();
+        build->snapshot = m_snapshotPool->acquire();
+        build->snapshot->getPoints() = frame.cloud.getPoints();
+        m_kdTreeBuild = build;
+
+        KdTreeBuild* job = build.get();
+        m_kdTreeJob = JobSystem::instance().submit([job]()
+        {
+            auto t0 = Clock::now();
+
+            job->tree->build(*job->snapshot);
+            job->snapshot.reset();
+            job->buildMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        });
+    }
+}
+
+void Application::pickPoint()
+{
+    PROFILE_SCOPE("Application::pickPoint");
+
+    using Clock = std::chrono::steady_clock;
+
+    if (!m_kdTree || m_kdTreeFrame != m_displayed->frameIndex || m_kdTreeStream != m_displayed->stream)
+    {
+        Logger::info("Pick: index for this frame is still building.");
+        return;
+    }
+
+    const glm::mat4& view = m_renderer->getLastView();
+    const glm::mat4& proj = m_renderer->getLastProjection();
+
+    float w = static_cast<float>(m_window->getWidth());
+    float h = static_cast<float>(m_window->getHeight());
+    glm::vec2 cursor = m_inputHandler->getPickPosition();
+    glm::vec2 ndc(2.0f * cursor.x / w - 1.0f, 1.0f - 2.0f * cursor.y / h);
+
+    glm::vec3 origin, dir;
+    MathUtils::ndcToWorldRay(ndc, view, proj, origin, dir);
+
+    // proj[1][1] = 1 / tan(fovY / 2): convert the pixel radius to a cone
+    float tanHalfAngle = (m_pickRadiusPx / (0.5f * h)) / proj[1][1];
+
+    auto t0 = Clock::now();
+    KdTree::PickResult hit;
+    bool found = m_kdTree->pick(origin, dir, tanHalfAngle, hit);
+    m_stats->record("pick_query_ms",
+                    std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+
+    if (!found)
+    {
+        Logger::info("Pick: no point under cursor.");
+        return;
+    }
+
+    glm::vec3 p = m_kdTree->position(hit.index);
+
+    t0 = Clock::now();
+    std::vector<int> neighbours;
+    m_kdTree->radiusSearch(p, m_pickQueryRadius, neighbours);
+    m_stats->record("radius_query_ms",
+                    std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+
+    char buf[256];
+    std::snprintf(buf, sizeof(buf),
+                  "Pick: point #%d at (%.3f, %.3f, %.3f) range %.2f m intensity %.3f, "
+                  "%zu points within %.2f m",
+                  hit.index, p.x, p.y, p.z, glm::length(p),
+                  m_kdTree->intensity(hit.index),
+                  neighbours.size(), m_pickQueryRadius);
+    Logger::info(buf);
+}
+
+void Application::deskewCloud(FrameData& frame)
+{
+    // Loader thread: the frame's own sequence, not the displayed one
+    IKittiLoader& loader = m_pipeline->getLoader(frame.stream);
+    const int total = loader.getTotalFrames();
+    if (total < 2)
+        return;
+
+    // Motion over this sweep ≈ motion to the next frame, else from
+    // the previous one (end of sequence, or estimated poses not
+    // registered that far yet), else over the sweep before. Never
+    // estimates: poses unknown so far leave the scan as is.
+    glm::mat4 from, to;
+    bool known = false;
+    for (int a = frame.frameIndex; a >= frame.frameIndex - 2 && !known; --a)
+    {
+        known = a >= 0 && a + 1 < total &&
+                loader.tryGetPose(a, from) && loader.tryGetPose(a + 1, to);
+    }
+    if (!known)
+        return;
+
+    glm::mat4 motion = ScanDeskewer::motionFromPoses(from, to, loader.getVeloToCam());
+
+    m_deskewer->deskew(frame.cloud, motion);
+}
+
+void Application::reportStats(bool presented)
+{
+    // Idle iterations are not frames (fps counts presented ones)
+    if (presented)
+        m_stats->endFrame();
+
+    if (m_statsInterval <= 0.0f || !m_stats->reportDue(m_statsInterval))
+        return;
+
+    const uint64_t cancelled = m_pipeline->getCancelledCount(m_activeStream);
+    if (cancelled > 0)
+        m_stats->record("loads_cancelled", static_cast<double>(cancelled));
+
+    // Frames never shown, per interval plus the running total: the
+    // loader skipped them, or they were loaded and then overtaken.
+    // Frames the playback clock stepped over land in one of the two;
+    // playback_skipped says how many of those the clock caused.
+    const uint64_t dropped = m_pipeline->getSkippedCount(m_activeStream) +
+                             m_pipeline->getDiscardedCount(m_activeStream);
+    if (dropped > 0 || m_playback->isPlaying())
+    {
+        m_stats->record("frames_dropped", static_cast<double>(dropped - m_droppedReported));
+        m_stats->record("frames_dropped_total", static_cast<double>(dropped));
+        m_stats->record("playback_skipped", m_playback->consumeDroppedFrames());
+        m_droppedReported = dropped;
+    }
+
+    Logger::info("Stats: " + m_stats->summary());
+    m_stats->resetInterval();
+}
+
+void Application::toggleTraceCapture()
+{
+    if (!Profiler::isCapturing())
+    {
+        Profiler::startCapture();
+        Logger::info("Profiler: capturing (F9 to stop and save)");
+        return;
+    }
+
+    Profiler::stopCapture();
+    if (Profiler::writeChromeTrace(m_tracePath))
+        Logger::info("Profiler: trace written to " + m_tracePath);
+    else
+        Logger::warn("Profiler: could not write trace to " + m_tracePath);
+
+    if (Profiler::getDroppedCount() > 0)
+        Logger::warn("Profiler: " + std::to_string(Profiler::getDroppedCount()) +
+                     " events dropped (thread buffers full)");
+}
+
+void Application::renderOverlay()
+{
+    if (!m_overlay || (!m_overlay->isVisible() && m_thumbnails.empty()))
+        return;
+
+    using Clock = std::chrono::steady_clock;
+    auto t0 = Clock::now();
+
+    PerfOverlay::Counters counters;
+    counters.queuedFrames   = m_pipeline->getQueuedCount(m_activeStream);
+    counters.frameBuffers   = static_cast<size_t>(m_pipeline->getBufferCount());
+    counters.readyHitRate   = m_pipeline->getReadyHitRate(m_activeStream);
+    counters.framesSkipped   = m_pipeline->getSkippedCount(m_activeStream);
+    counters.framesDiscarded = m_pipeline->getDiscardedCount(m_activeStream);
+    counters.pointsUploaded = m_renderer->getLastUpload().points;
+    counters.pointsDrawn    = m_renderer->getDrawnPointCount();
+    counters.bytesUploaded  = m_renderer->getLastUpload().bytes;
+
+    PerfOverlay::Timeline timeline;
+    if (!m_thumbnails.empty())
+    {
+        timeline.frame       = m_currentFrame;
+        timeline.totalFrames = activeLoader().getTotalFrames();
+        timeline.height      = m_timelineHeight;
+        timeline.scrubbing   = m_inputHandler->timelineScrubbing();
+        timeline.preview     = m_preview != nullptr;
+        timeline.thumbnails  = m_thumbnails[m_activeStream].get();
+    }
+
+    m_overlay->render(*m_stats, counters, m_thumbnails.empty() ? nullptr : &timeline);
+    m_stats->record("overlay_ms", std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
 }
 
 void Application::cleanup()
 {
     Logger::info("Cleaning up application...");
 
+    // Stop the loader thread before the loader and stages go away
+    if (m_pipeline)
+    {
+        m_pipeline->release(m_displayed);
+        m_displayed = nullptr;
+        for (FrameData*& frame : m_streamFrames)
+        {
+            m_pipeline->release(frame);
+            frame = nullptr;
+        }
+        m_pipeline->stop();
+        m_pipeline.reset();
+    }
+    m_preview = nullptr;
+    m_thumbnails.clear();   // waits for a thumbnail job in flight
+
+    // Drain background jobs before the objects they touch go away
+    if (m_kdTreeJob.valid())
+        JobSystem::instance().wait(m_kdTreeJob);
+    JobSystem::instance().stop();
+
+    MemoryBudget::instance().remove(m_kdTreeMemoryId);
+    MemoryBudget::instance().remove(m_snapshotMemoryId);
+
+    m_overlay.reset();   // needs the GL context
     m_renderer.reset();
+    GpuDevice::setCurrent(nullptr);
+    m_gpuDevice.reset();
     m_loader.reset();
+    m_compareLoaders.clear();
     m_inputHandler.reset();
     m_camera.reset();
     m_window.reset();
     m_trajectory.reset();
+
+    // A capture still running at exit (trace_on_start) is saved
+    if (Profiler::isCapturing())
+        toggleTraceCapture();
+
+    logAllocScopes();
+
+    // Last: everything above may still log
+    Logger::stopAsync();
 }
 
 void Application::nextFrame()
 {
-    if (m_currentFrame + 1 < m_loader->getTotalFrames())
+    if (m_currentFrame + 1 < activeLoader().getTotalFrames())
     {
         m_currentFrame++;
-        Logger::debug("Next frame: " + std::to_string(m_currentFrame));
+        LOG_DEBUG("Next frame: " + std::to_string(m_currentFrame));
     }
 }
 
@@ -171,6 +1296,6 @@ void Application::prevFrame()
     if (m_currentFrame > 0)
     {
         m_currentFrame--;
-        Logger::debug("Prev frame: " + std::to_string(m_currentFrame));
+        LOG_DEBUG("Prev frame: " + std::to_string(m_currentFrame));
     }
 }
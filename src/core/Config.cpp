@@ -109,3 +109,8 @@ bool Config::has(const std::string& key) const
 {
     return m_values.find(key) != m_values.end();
 }
+
+void Config::set(const std::string& key, const std::string& value)
+{
+    m_values[key] = value;
+}
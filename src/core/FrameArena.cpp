@@ -0,0 +1,137 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define KITTI_ARENA_MMAP 1
+#endif
+
+namespace
+{
+    constexpr size_t kHugePageSize = 2u << 20;
+
+    inline size_t alignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+FrameArena& FrameArena::mainThread()
+{
+    static FrameArena s_arena;
+    return s_arena;
+}
+
+FrameArena::~FrameArena()
+{
+    reset();
+    release();
+}
+
+void FrameArena::release()
+{
+    if (!m_base)
+        return;
+
+#ifdef KITTI_ARENA_MMAP
+    if (m_mapped)
+        munmap(m_base, m_capacity);
+    else
+#endif
+        std::free(m_base);
+
+    m_base = nullptr;
+    m_capacity = 0;
+    m_offset = 0;
+    m_mapped = false;
+    m_hugePages = false;
+}
+
+bool FrameArena::configure(size_t capacityBytes, bool useHugePages)
+{
+    reset();
+    release();
+
+    m_overflow.reserve(16);
+    m_highWater = 0;
+
+    if (capacityBytes == 0)
+        return true;
+
+#ifdef KITTI_ARENA_MMAP
+    // Whole huge pages, so the kernel can back the block with them
+    size_t size = useHugePages ? alignUp(capacityBytes, kHugePageSize) : capacityBytes;
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p != MAP_FAILED)
+    {
+        m_base = static_cast<uint8_t*>(p);
+        m_capacity = size;
+        m_mapped = true;
+
+#ifdef MADV_HUGEPAGE
+        if (useHugePages)
+            m_hugePages = madvise(p, size, MADV_HUGEPAGE) == 0;
+#endif
+        return true;
+    }
+#else
+    (void)useHugePages;
+    (void)kHugePageSize;
+#endif
+
+    m_base = static_cast<uint8_t*>(std::malloc(capacityBytes));
+    if (!m_base)
+        return false;
+
+    m_capacity = capacityBytes;
+    return true;
+}
+
+void* FrameArena::allocate(size_t bytes, size_t alignment)
+{
+    if (bytes == 0)
+        bytes = 1;
+
+    size_t offset = alignUp(m_offset, alignment);
+    if (m_base && offset + bytes <= m_capacity)
+    {
+        m_offset = offset + bytes;
+        m_highWater = std::max(m_highWater, getUsed());
+        return m_base + offset;
+    }
+
+    // Out of space: fall back to the heap until the next reset
+    void* p = nullptr;
+#if defined(_MSC_VER)
+    p = _aligned_malloc(bytes, std::max(alignment, sizeof(void*)));
+#else
+    if (posix_memalign(&p, std::max(alignment, sizeof(void*)), bytes) != 0)
+        p = nullptr;
+#endif
+    if (!p)
+        throw std::bad_alloc();
+
+    m_overflow.push_back(p);
+    m_overflowBytes += bytes;
+    m_highWater = std::max(m_highWater, getUsed());
+    return p;
+}
+
+void FrameArena::reset()
+{
+    for (void* p : m_overflow)
+    {
+#if defined(_MSC_VER)
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+
+    m_overflow.clear();
+    m_overflowBytes = 0;
+    m_offset = 0;
+}
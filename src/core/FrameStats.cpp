@@ -0,0 +1,104 @@
+#include "FrameStats.h"
+
+#include <cstdio>
+#include <cstring>
+
+FrameStats::FrameStats()
+    : m_intervalStart(Clock::now())
+{
+    m_entries.reserve(64);
+}
+
+FrameStats::Entry* FrameStats::find(const char* name)
+{
+    for (auto& e : m_entries)
+    {
+        // Fast path: same literal; slow path: same text
+        if (e.name == name || std::strcmp(e.name, name) == 0)
+            return &e;
+    }
+    return nullptr;
+}
+
+const FrameStats::Entry* FrameStats::find(const char* name) const
+{
+    return const_cast<FrameStats*>(this)->find(name);
+}
+
+void FrameStats::record(const char* name, double value)
+{
+    Entry* e = find(name);
+    if (!e)
+    {
+        m_entries.push_back(Entry{});
+        e = &m_entries.back();
+        e->name = name;
+    }
+
+    e->last = value;
+    e->sum += value;
+    if (e->samples == 0 || value > e->max)
+        e->max = value;
+    e->samples++;
+}
+
+double FrameStats::get(const char* name, double fallback) const
+{
+    const Entry* e = find(name);
+    return e ? e->last : fallback;
+}
+
+void FrameStats::endFrame()
+{
+    m_framesInInterval++;
+}
+
+bool FrameStats::reportDue(double intervalSeconds) const
+{
+    std::chrono::duration<double> elapsed = Clock::now() - m_intervalStart;
+    return elapsed.count() >= intervalSeconds;
+}
+
+double FrameStats::fps() const
+{
+    std::chrono::duration<double> elapsed = Clock::now() - m_intervalStart;
+    return elapsed.count() > 0.0 ? m_framesInInterval / elapsed.count() : 0.0;
+}
+
+std::string FrameStats::summary() const
+{
+    std::string out;
+    char buf[160];
+
+    std::snprintf(buf, sizeof(buf), "fps=%.1f", fps());
+    out += buf;
+
+    for (const auto& e : m_entries)
+    {
+        if (e.samples == 0)
+            continue;
+
+        double avg = e.sum / e.samples;
+        if (e.samples > 1)
+            std::snprintf(buf, sizeof(buf), " | %s=%.3f (avg %.3f, max %.3f)",
+                          e.name, e.last, avg, e.max);
+        else
+            std::snprintf(buf, sizeof(buf), " | %s=%.3f", e.name, e.last);
+        out += buf;
+    }
+
+    return out;
+}
+
+void FrameStats::resetInterval()
+{
+    for (auto& e : m_entries)
+    {
+        e.sum = 0.0;
+        e.max = 0.0;
+        e.samples = 0;
+    }
+
+    m_framesInInterval = 0;
+    m_intervalStart = Clock::now();
+}
@@ -0,0 +1,430 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+    // Index of the current thread in its owning pool (-1 = not a worker)
+    thread_local int t_workerIndex = -1;
+    thread_local const JobSystem* t_owner = nullptr;
+}
+
+// ------------------------------------------------------------
+// TaskHandle
+// ------------------------------------------------------------
+bool JobSystem::TaskHandle::isDone() const
+{
+    return !m_task || m_task->done.load(std::memory_order_acquire);
+}
+
+// ------------------------------------------------------------
+// Lifetime
+// ------------------------------------------------------------
+JobSystem& JobSystem::instance()
+{
+    static JobSystem s_instance;
+    return s_instance;
+}
+
+JobSystem::JobSystem()
+{
+}
+
+JobSystem::~JobSystem()
+{
+    stop();
+}
+
+void JobSystem::start(int threadCount)
+{
+    if (isRunning())
+        return;
+
+    if (threadCount <= 0)
+    {
+        unsigned int hw = std::thread::hardware_concurrency();
+        threadCount = hw > 1 ? static_cast<int>(hw) - 1 : 1;
+    }
+
+    m_stopping = false;
+
+    // One deque per worker + one injection queue for external threads
+    m_queues.clear();
+    for (int i = 0; i <= threadCount; ++i)
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+
+    // Published before any worker runs: workers read these lock-free
+    m_workerCount = threadCount;
+    m_running = true;
+
+    m_workers.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i)
+        m_workers.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+void JobSystem::stop()
+{
+    if (!isRunning())
+        return;
+
+    // From here submit() rejects work. Submits already past that
+    // check finish pushing before the queues can go away.
+    m_stopping = true;
+    while (m_submitting.load() > 0)
+        std::this_thread::yield();
+
+    wakeWorkers(true);
+
+    for (auto& t : m_workers)
+        t.join();
+
+    m_running = false;
+    m_workerCount = 0;
+    m_workers.clear();
+    m_queues.clear();
+    m_pendingJobs = 0;
+
+    // Not running: later submits execute inline
+    m_stopping = false;
+}
+
+// ------------------------------------------------------------
+// Submission / task graph
+// ------------------------------------------------------------
+JobSystem::TaskHandle JobSystem::submit(Job job)
+{
+    auto task = std::make_shared<Task>();
+    task->job = std::move(job);
+    return submitTask(std::move(task), nullptr, 0);
+}
+
+JobSystem::TaskHandle JobSystem::submit(Job job, std::initializer_list<TaskHandle> dependencies)
+{
+    auto task = std::make_shared<Task>();
+    task->job = std::move(job);
+    return submitTask(std::move(task), dependencies.begin(), dependencies.size());
+}
+
+JobSystem::TaskHandle JobSystem::submit(Job job, const std::vector<TaskHandle>& dependencies)
+{
+    auto task = std::make_shared<Task>();
+    task->job = std::move(job);
+    return submitTask(std::move(task), dependencies.data(), dependencies.size());
+}
+
+JobSystem::TaskHandle JobSystem::submitTask(TaskPtr task, const TaskHandle* deps, size_t depCount)
+{
+    // Counted before the check (both sequentially consistent), so
+    // stop() either sees this submit in flight or it sees m_stopping
+    m_submitting.fetch_add(1);
+    if (m_stopping.load())
+    {
+        m_submitting.fetch_sub(1, std::memory_order_release);
+        return TaskHandle();
+    }
+
+    // Register as a continuation of every unfinished dependency.
+    // 'done' is published under the same mutex, so a dependency
+    // either sees us in its list or we see it as done.
+    for (size_t i = 0; i < depCount; ++i)
+    {
+        const TaskPtr& dep = deps[i].m_task;
+        if (!dep)
+            continue;
+
+        std::lock_guard<std::mutex> lock(dep->continuationMutex);
+        if (!dep->done.load(std::memory_order_acquire))
+        {
+            task->remainingDeps.fetch_add(1, std::memory_order_relaxed);
+            dep->continuations.push_back(task);
+            task->dependencies.push_back(dep);
+        }
+    }
+
+    TaskHandle handle(task);
+
+    // Drop the reference held by submit(); schedules if no deps remain
+    releaseDependency(task);
+
+    m_submitting.fetch_sub(1, std::memory_order_release);
+    return handle;
+}
+
+void JobSystem::releaseDependency(const TaskPtr& task)
+{
+    if (task->remainingDeps.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        schedule(task);
+}
+
+void JobSystem::schedule(TaskPtr task)
+{
+    if (!isRunning())
+    {
+        // No workers: run inline
+        execute(task);
+        return;
+    }
+
+    // Workers push to their own deque, everyone else to the injection queue
+    size_t q = (t_owner == this && t_workerIndex >= 0)
+                   ? static_cast<size_t>(t_workerIndex)
+                   : m_queues.size() - 1;
+
+    {
+        std::lock_guard<std::mutex> lock(m_queues[q]->mutex);
+        m_queues[q]->tasks.push_back(std::move(task));
+    }
+
+    m_pendingJobs.fetch_add(1);
+    wakeWorkers(false);
+}
+
+void JobSystem::wakeWorkers(bool all)
+{
+    // Sequentially consistent with the worker's m_sleepers increment
+    // and m_pendingJobs check: with no sleeper seen, every worker
+    // about to sleep sees the new job (or m_stopping) first
+    if (m_sleepers.load() == 0)
+        return;
+
+    // Taking the lock orders the notify after a sleeper's check
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    if (all)
+        m_wake.notify_all();
+    else
+        m_wake.notify_one();
+}
+
+bool JobSystem::execute(const TaskPtr& task)
+{
+    // Queued once, but wait() may have run it inline already
+    if (task->claimed.exchange(true, std::memory_order_acq_rel))
+        return false;
+
+    if (task->job)
+    {
+        PROFILE_SCOPE("JobSystem::job");
+        task->job();
+    }
+
+    std::vector<TaskPtr> continuations;
+    {
+        std::lock_guard<std::mutex> lock(task->continuationMutex);
+        task->done.store(true, std::memory_order_release);
+        continuations.swap(task->continuations);
+        task->dependencies.clear();   // don't keep finished chains alive
+    }
+
+    for (const auto& next : continuations)
+        releaseDependency(next);
+    return true;
+}
+
+// ------------------------------------------------------------
+// Work finding
+// ------------------------------------------------------------
+JobSystem::TaskPtr JobSystem::popLocal(int workerIndex)
+{
+    WorkerQueue& q = *m_queues[workerIndex];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty())
+        return nullptr;
+
+    TaskPtr task = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    m_pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+}
+
+JobSystem::TaskPtr JobSystem::steal(int thiefIndex)
+{
+    const size_t count = m_queues.size();
+    if (count == 0)
+        return nullptr;
+
+    // Injection queue first (oldest external work), then the other
+    // workers starting at a rotating offset to spread contention.
+    const size_t injection = count - 1;
+    const size_t start = m_nextQueue.fetch_add(1, std::memory_order_relaxed);
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        size_t i = (n == 0) ? injection : (start + n) % count;
+        if (n > 0 && i == injection)
+            continue;
+        if (static_cast<int>(i) == thiefIndex)
+            continue;
+
+        WorkerQueue& q = *m_queues[i];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty())
+            continue;
+
+        TaskPtr task = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        m_pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    return nullptr;
+}
+
+JobSystem::TaskPtr JobSystem::findWork(int workerIndex)
+{
+    if (workerIndex >= 0)
+    {
+        if (TaskPtr task = popLocal(workerIndex))
+            return task;
+    }
+    return steal(workerIndex);
+}
+
+bool JobSystem::tryRunWithin(const TaskPtr& task)
+{
+    if (task->done.load(std::memory_order_acquire) || task->claimed.load(std::memory_order_acquire))
+        return false;
+
+    // Ready: it sits in some queue; run it here (the queued entry is
+    // skipped when popped)
+    if (task->remainingDeps.load(std::memory_order_acquire) == 0)
+        return execute(task);
+
+    // Blocked: help with what it waits for, and nothing else. One
+    // dependency at a time, not under the lock (a job may submit).
+    for (size_t i = 0;; ++i)
+    {
+        TaskPtr dep;
+        {
+            std::lock_guard<std::mutex> lock(task->continuationMutex);
+            if (i >= task->dependencies.size())
+                return false;
+            dep = task->dependencies[i];
+        }
+        if (tryRunWithin(dep))
+            return true;
+    }
+}
+
+void JobSystem::wait(const TaskHandle& handle)
+{
+    while (!handle.isDone())
+    {
+        if (!tryRunWithin(handle.m_task))
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::workerLoop(int workerIndex)
+{
+    t_workerIndex = workerIndex;
+    t_owner = this;
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "worker %d", workerIndex);
+    Profiler::setThreadName(name);
+
+    while (true)
+    {
+        if (TaskPtr task = findWork(workerIndex))
+        {
+            execute(task);
+            continue;
+        }
+
+        if (m_stopping.load(std::memory_order_acquire))
+            break;
+
+        // Blocks until schedule() or stop() wakes us (see wakeWorkers)
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepers.fetch_add(1);
+        m_wake.wait(lock, [this]
+        {
+            return m_stopping.load() || m_pendingJobs.load() > 0;
+        });
+        m_sleepers.fetch_sub(1);
+    }
+
+    t_workerIndex = -1;
+    t_owner = nullptr;
+}
+
+// ------------------------------------------------------------
+// Parallel for
+// ------------------------------------------------------------
+void JobSystem::parallelFor(size_t begin, size_t end, size_t grain, const RangeJob& fn)
+{
+    if (end <= begin)
+        return;
+
+    grain = std::max<size_t>(1, grain);
+    const size_t chunks = (end - begin + grain - 1) / grain;
+
+    if (chunks == 1 || !isRunning() || m_stopping.load(std::memory_order_acquire))
+    {
+        for (size_t b = begin; b < end; b += grain)
+            fn(b, std::min(end, b + grain));
+        return;
+    }
+
+    // Chunks are claimed from a shared counter, so a helper that
+    // starts late simply finds nothing left and exits.
+    std::atomic<size_t> nextChunk{0};
+
+    auto runChunks = [&nextChunk, &fn, begin, end, grain, chunks]()
+    {
+        size_t c;
+        while ((c = nextChunk.fetch_add(1, std::memory_order_relaxed)) < chunks)
+        {
+            size_t b = begin + c * grain;
+            fn(b, std::min(end, b + grain));
+        }
+    };
+
+    const int helpers = static_cast<int>(std::min<size_t>(getWorkerCount(), chunks - 1));
+
+    std::vector<TaskHandle> helperTasks;
+    helperTasks.reserve(static_cast<size_t>(helpers));
+    for (int h = 0; h < helpers; ++h)
+        helperTasks.push_back(submit(runChunks));
+
+    runChunks();
+
+    // Helpers reference this stack frame: wait until all have left.
+    // One no worker picked up yet is run (and finds nothing) here.
+    for (const TaskHandle& helper : helperTasks)
+        wait(helper);
+}
+
+// ------------------------------------------------------------
+// Main-thread queue
+// ------------------------------------------------------------
+void JobSystem::postToMainThread(Job job)
+{
+    std::lock_guard<std::mutex> lock(m_mainMutex);
+    m_mainThreadJobs.push_back(std::move(job));
+}
+
+size_t JobSystem::runMainThreadJobs(size_t maxJobs)
+{
+    size_t ran = 0;
+    while (ran < maxJobs)
+    {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(m_mainMutex);
+            if (m_mainThreadJobs.empty())
+                break;
+            job = std::move(m_mainThreadJobs.front());
+            m_mainThreadJobs.pop_front();
+        }
+
+        job();
+        ++ran;
+    }
+    return ran;
+}
@@ -0,0 +1,194 @@
+#include "MemoryBudget.h"
+#include "AllocCounter.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    const char* kindName(MemoryBudget::Kind kind)
+    {
+        return kind == MemoryBudget::Gpu ? "GPU" : "host";
+    }
+
+    std::string megabytes(size_t bytes)
+    {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.1f MB", bytes / (1024.0 * 1024.0));
+        return buf;
+    }
+}
+
+MemoryBudget& MemoryBudget::instance()
+{
+    static MemoryBudget s_instance;
+    return s_instance;
+}
+
+void MemoryBudget::setBudget(Kind kind, size_t bytes)
+{
+    m_budget[kind].store(bytes, std::memory_order_relaxed);
+}
+
+MemoryBudget::Id MemoryBudget::add(const char* name, Kind kind, EvictFn evict, int priority)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (Id id = 0; id < kMaxSubsystems; ++id)
+    {
+        Slot& slot = m_slots[id];
+        if (slot.used.load(std::memory_order_relaxed))
+            continue;
+
+        slot.name = name;
+        std::snprintf(slot.statName, sizeof(slot.statName), "mem_%s_mb", name);
+        slot.kind = kind;
+        slot.priority = priority;
+        slot.evictions = 0;
+        slot.evict = std::move(evict);
+        slot.bytes.store(0, std::memory_order_relaxed);
+        slot.peakBytes.store(0, std::memory_order_relaxed);
+        slot.used.store(true, std::memory_order_release);
+        return id;
+    }
+
+    Logger::warn(std::string("MemoryBudget: no free slot for ") + name + "; its usage is not tracked.");
+    return kInvalidId;
+}
+
+void MemoryBudget::remove(Id id)
+{
+    if (id < 0 || id >= kMaxSubsystems)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Slot& slot = m_slots[id];
+    slot.used.store(false, std::memory_order_release);
+    slot.bytes.store(0, std::memory_order_relaxed);
+    slot.evict = EvictFn();
+    // name/statName stay valid: FrameStats may still hold the pointer
+}
+
+void MemoryBudget::setUsage(Id id, size_t bytes)
+{
+    if (id < 0 || id >= kMaxSubsystems)
+        return;
+
+    Slot& slot = m_slots[id];
+    slot.bytes.store(bytes, std::memory_order_relaxed);
+
+    size_t peak = slot.peakBytes.load(std::memory_order_relaxed);
+    while (bytes > peak && !slot.peakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+    {
+    }
+}
+
+size_t MemoryBudget::getUsage(Id id) const
+{
+    if (id < 0 || id >= kMaxSubsystems)
+        return 0;
+    return m_slots[id].bytes.load(std::memory_order_relaxed);
+}
+
+size_t MemoryBudget::getTotal(Kind kind) const
+{
+    size_t total = 0;
+    for (const Slot& slot : m_slots)
+    {
+        if (slot.used.load(std::memory_order_acquire) && slot.kind == kind)
+            total += slot.bytes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+int MemoryBudget::enforce()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    int invoked = 0;
+    for (int k = 0; k < KindCount; ++k)
+    {
+        const Kind kind = static_cast<Kind>(k);
+        const size_t budget = getBudget(kind);
+        const size_t total = getTotal(kind);
+
+        // The transition messages are built on the calling thread,
+        // inside the render loop's no-allocation region
+        if (budget == 0 || total <= budget)
+        {
+            if (m_overBudget[k])
+            {
+                AllocCounter::AllowAllocs logging;
+                Logger::info(std::string("MemoryBudget: ") + kindName(kind) + " usage back within budget ("
+                             + megabytes(total) + " of " + megabytes(budget) + ")");
+            }
+            m_overBudget[k] = false;
+            continue;
+        }
+
+        if (!m_overBudget[k])
+        {
+            AllocCounter::AllowAllocs logging;
+            Logger::warn(std::string("MemoryBudget: ") + kindName(kind) + " usage " + megabytes(total)
+                         + " exceeds budget " + megabytes(budget) + "; evicting.");
+        }
+        m_overBudget[k] = true;
+
+        // Candidates of this kind, highest priority first (then
+        // largest); at most kMaxSubsystems, so no allocation
+        Slot* order[kMaxSubsystems];
+        int count = 0;
+        for (Slot& slot : m_slots)
+        {
+            if (slot.used.load(std::memory_order_relaxed) && slot.kind == kind && slot.evict)
+                order[count++] = &slot;
+        }
+        std::sort(order, order + count, [](const Slot* a, const Slot* b)
+        {
+            if (a->priority != b->priority)
+                return a->priority > b->priority;
+            return a->bytes.load(std::memory_order_relaxed) > b->bytes.load(std::memory_order_relaxed);
+        });
+
+        size_t excess = total - budget;
+        for (int i = 0; i < count && excess > 0; ++i)
+        {
+            Slot& slot = *order[i];
+            if (slot.bytes.load(std::memory_order_relaxed) == 0)
+                continue;
+
+            size_t released = slot.evict(excess);
+            slot.evictions++;
+            invoked++;
+            excess -= std::min(excess, released);
+        }
+    }
+
+    m_evictionCount.fetch_add(static_cast<uint64_t>(invoked), std::memory_order_relaxed);
+    return invoked;
+}
+
+int MemoryBudget::snapshot(Usage* out, int capacity) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    int count = 0;
+    for (const Slot& slot : m_slots)
+    {
+        if (count >= capacity)
+            break;
+        if (!slot.used.load(std::memory_order_relaxed))
+            continue;
+
+        Usage& u = out[count++];
+        u.name = slot.name;
+        u.statName = slot.statName;
+        u.kind = slot.kind;
+        u.bytes = slot.bytes.load(std::memory_order_relaxed);
+        u.peakBytes = slot.peakBytes.load(std::memory_order_relaxed);
+        u.evictions = slot.evictions;
+    }
+    return count;
+}
@@ -0,0 +1,117 @@
+#include "PlaybackClock.h"
+
+#include <algorithm>
+#include <cmath>
+
+PlaybackClock::PlaybackClock(double baseRateHz)
+    : m_baseRate(baseRateHz > 0.0 ? baseRateHz : 10.0),
+      m_anchorTime(Clock::now())
+{
+}
+
+void PlaybackClock::anchor(int frame, Clock::time_point now)
+{
+    m_anchorFrame = frame;
+    m_anchorTime  = now;
+    m_lastFrame   = frame;
+}
+
+void PlaybackClock::play(int fromFrame)
+{
+    anchor(fromFrame, Clock::now());
+    m_playing = true;
+}
+
+void PlaybackClock::pause()
+{
+    m_playing = false;
+}
+
+void PlaybackClock::toggle(int currentFrame)
+{
+    if (m_playing)
+        pause();
+    else
+        play(currentFrame);
+}
+
+void PlaybackClock::seek(int frame)
+{
+    anchor(frame, Clock::now());
+}
+
+void PlaybackClock::setSpeed(double speed)
+{
+    speed = std::min(std::max(speed, 0.1), 16.0);
+    if (speed == m_speed)
+        return;
+
+    // Re-anchor at the current position so the frame doesn't jump
+    anchor(m_lastFrame, Clock::now());
+    m_speed = speed;
+}
+
+int PlaybackClock::update(int totalFrames)
+{
+    return update(totalFrames, Clock::now());
+}
+
+int PlaybackClock::update(int totalFrames, Clock::time_point now)
+{
+    if (!m_playing || totalFrames <= 0)
+        return m_lastFrame;
+
+    std::chrono::duration<double> elapsed = now - m_anchorTime;
+    int target = m_anchorFrame +
+                 static_cast<int>(std::floor(elapsed.count() * m_baseRate * m_speed));
+
+    if (target >= totalFrames && !m_looping)
+    {
+        target = totalFrames - 1;
+        m_playing = false;
+    }
+
+    // More than one step since last time: the frames between were
+    // never shown (when looping, also those across the end)
+    int advanced = target - m_lastFrame;
+    if (advanced > 1)
+    {
+        m_dropped      += static_cast<uint32_t>(advanced - 1);
+        m_totalDropped += static_cast<uint64_t>(advanced - 1);
+    }
+
+    if (target >= totalFrames)
+    {
+        // Re-anchor at the moment frame 0 came round (not at 'now'),
+        // so looped playback keeps the fraction of a frame it is into
+        // and does not run slow. Truncating to clock ticks moves the
+        // anchor earlier, never past the frame shown.
+        const int loops = target / totalFrames;
+        const std::chrono::duration<double> toWrap(
+            (loops * totalFrames - m_anchorFrame) / (m_baseRate * m_speed));
+        m_anchorTime += std::chrono::duration_cast<Clock::duration>(toWrap);
+        m_anchorFrame = 0;
+        target %= totalFrames;
+    }
+
+    m_lastFrame = target;
+    return target;
+}
+
+double PlaybackClock::secondsUntilNextFrame() const
+{
+    if (!m_playing)
+        return 1e9;
+
+    const double rate = m_baseRate * m_speed;
+    double nextAt = (m_lastFrame - m_anchorFrame + 1) / rate;
+    std::chrono::duration<double> elapsed = Clock::now() - m_anchorTime;
+    return std::max(0.0, nextAt - elapsed.count());
+}
+
+uint32_t PlaybackClock::consumeDroppedFrames()
+{
+    uint32_t dropped = m_dropped;
+    m_dropped = 0;
+    return dropped;
+}
@@ -0,0 +1,46 @@
+#include "PointBudgetController.h"
+
+#include <algorithm>
+
+PointBudgetController::PointBudgetController()
+    : m_params()
+{
+}
+
+PointBudgetController::PointBudgetController(const Params& params)
+    : m_params(params)
+{
+}
+
+void PointBudgetController::reset()
+{
+    m_budget = 0.0;
+    m_smoothedMs = 0.0;
+}
+
+size_t PointBudgetController::update(double cpuMs, double gpuMs, size_t availablePoints)
+{
+    const double available = static_cast<double>(availablePoints);
+    const double minPoints = std::min(static_cast<double>(m_params.minPoints), available);
+
+    if (m_budget <= 0.0)
+        m_budget = available;
+
+    double frameMs = std::max(cpuMs, gpuMs);
+    if (frameMs <= 0.0 || m_params.targetMs <= 0.0)
+        return static_cast<size_t>(std::min(m_budget, available));
+
+    m_smoothedMs = (m_smoothedMs <= 0.0)
+                       ? frameMs
+                       : m_smoothedMs + m_params.smoothing * (frameMs - m_smoothedMs);
+
+    double ratio = m_params.targetMs / m_smoothedMs;
+    if (ratio < 1.0 - m_params.deadBand || ratio > 1.0 + m_params.deadBand)
+    {
+        ratio = std::min(std::max(ratio, m_params.shrinkLimit), m_params.growLimit);
+        m_budget *= ratio;
+    }
+
+    m_budget = std::min(std::max(m_budget, minPoints), available);
+    return static_cast<size_t>(m_budget);
+}
@@ -0,0 +1,238 @@
+#include "Profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Profiler
+{
+    namespace detail
+    {
+        std::atomic<bool> g_capturing{false};
+    }
+
+    namespace
+    {
+        struct Event
+        {
+            const char* name;
+            uint64_t    start;
+            uint64_t    duration;
+        };
+
+        // Events of one thread (or one virtual track). Written only by
+        // the owner; the exporter reads the published prefix.
+        struct EventBuffer
+        {
+            uint32_t    tid = 0;
+            std::string name;
+
+            std::unique_ptr<Event[]> events;   // allocated on registration
+            std::atomic<uint32_t> count{0};
+            std::atomic<uint32_t> capture{0};  // capture the events belong to
+        };
+
+        const std::chrono::steady_clock::time_point g_epoch = std::chrono::steady_clock::now();
+
+        std::mutex g_registryMutex;   // g_buffers, g_tracks, names
+        std::vector<std::unique_ptr<EventBuffer>> g_buffers;
+        std::vector<std::unique_ptr<EventBuffer>> g_tracks;
+        uint32_t g_nextTid = 1;
+
+        std::atomic<uint32_t> g_captureId{0};
+        std::atomic<uint64_t> g_dropped{0};
+
+        thread_local EventBuffer* t_buffer = nullptr;
+
+        // Storage for a full capture, allocated with the buffer so that
+        // recording never allocates. Pages are untouched until used.
+        std::unique_ptr<EventBuffer> newBuffer()
+        {
+            auto buffer = std::make_unique<EventBuffer>();
+            buffer->events.reset(new Event[kEventsPerThread]);
+            return buffer;
+        }
+
+        // Registers the calling thread on first use; threads that record
+        // in allocation-checked code call setThreadName() when they start
+        EventBuffer& localBuffer()
+        {
+            if (!t_buffer)
+            {
+                auto buffer = newBuffer();
+
+                std::lock_guard<std::mutex> lock(g_registryMutex);
+                buffer->tid = g_nextTid++;
+                t_buffer = buffer.get();
+                g_buffers.push_back(std::move(buffer));
+            }
+            return *t_buffer;
+        }
+
+        void append(EventBuffer& buffer, const char* name, uint64_t start, uint64_t duration)
+        {
+            // First event of a new capture: start over
+            const uint32_t capture = g_captureId.load(std::memory_order_acquire);
+            if (buffer.capture.load(std::memory_order_relaxed) != capture)
+            {
+                buffer.count.store(0, std::memory_order_relaxed);
+                buffer.capture.store(capture, std::memory_order_release);
+            }
+
+            const uint32_t n = buffer.count.load(std::memory_order_relaxed);
+            if (n >= kEventsPerThread)
+            {
+                g_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            buffer.events[n] = Event{ name, start, duration };
+            buffer.count.store(n + 1, std::memory_order_release);
+        }
+
+        // Registry lock held by the caller
+        EventBuffer& findTrack(const char* track)
+        {
+            for (auto& t : g_tracks)
+            {
+                if (t->name == track)
+                    return *t;
+            }
+
+            g_tracks.push_back(newBuffer());
+            EventBuffer& buffer = *g_tracks.back();
+            buffer.tid  = g_nextTid++;
+            buffer.name = track;
+            return buffer;
+        }
+
+        void writeEscaped(std::FILE* file, const char* text)
+        {
+            for (const char* c = text; *c; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                    std::fputc('\\', file);
+                std::fputc(*c, file);
+            }
+        }
+
+        // Returns the number of events written
+        size_t writeBuffer(std::FILE* file, const EventBuffer& buffer, uint32_t capture, bool& first)
+        {
+            if (buffer.capture.load(std::memory_order_acquire) != capture)
+                return 0;
+
+            const uint32_t n = buffer.count.load(std::memory_order_acquire);
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                const Event& e = buffer.events[i];
+                std::fputs(first ? "\n" : ",\n", file);
+                first = false;
+
+                std::fputs("{\"name\":\"", file);
+                writeEscaped(file, e.name);
+                std::fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                             buffer.tid, e.start / 1000.0, e.duration / 1000.0);
+            }
+
+            if (n > 0 && !buffer.name.empty())
+            {
+                std::fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                             buffer.tid);
+                writeEscaped(file, buffer.name.c_str());
+                std::fputs("\"}}", file);
+            }
+
+            return n;
+        }
+    }
+
+    uint64_t nowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - g_epoch).count());
+    }
+
+    void startCapture()
+    {
+        g_dropped.store(0, std::memory_order_relaxed);
+        g_captureId.fetch_add(1, std::memory_order_acq_rel);
+        detail::g_capturing.store(true, std::memory_order_release);
+    }
+
+    void stopCapture()
+    {
+        detail::g_capturing.store(false, std::memory_order_release);
+    }
+
+    void addTrack(const char* track)
+    {
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        findTrack(track);
+    }
+
+    void setThreadName(const char* name)
+    {
+        EventBuffer& buffer = localBuffer();
+
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        buffer.name = name;
+    }
+
+    void recordEvent(const char* name, uint64_t startNs, uint64_t durationNs, const char* track)
+    {
+        if (!isCapturing())
+            return;
+
+        if (!track)
+        {
+            append(localBuffer(), name, startNs, durationNs);
+            return;
+        }
+
+        // Virtual tracks are rare (a few events per frame): shared
+        // buffers under the registry lock
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+
+        append(findTrack(track), name, startNs, durationNs);
+    }
+
+    void Scope::end()
+    {
+        append(localBuffer(), m_name, m_start, nowNs() - m_start);
+    }
+
+    bool writeChromeTrace(const std::string& path)
+    {
+        const uint32_t capture = g_captureId.load(std::memory_order_acquire);
+        if (capture == 0)
+            return false;
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return false;
+
+        std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+
+        size_t written = 0;
+        bool first = true;
+        {
+            std::lock_guard<std::mutex> lock(g_registryMutex);
+            for (const auto& buffer : g_buffers)
+                written += writeBuffer(file, *buffer, capture, first);
+            for (const auto& track : g_tracks)
+                written += writeBuffer(file, *track, capture, first);
+        }
+
+        std::fputs("\n]}\n", file);
+        const bool ok = std::fclose(file) == 0;
+        return ok && written > 0;
+    }
+
+    uint64_t getDroppedCount()
+    {
+        return g_dropped.load(std::memory_order_relaxed);
+    }
+}
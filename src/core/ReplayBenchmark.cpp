@@ -0,0 +1,168 @@
+#include "ReplayBenchmark.h"
+#include "ProcessStats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+
+namespace
+{
+    // Nearest-rank percentile of a sorted sample
+    double percentile(const std::vector<double>& sorted, double p)
+    {
+        if (sorted.empty())
+            return 0.0;
+        size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    void writeEscaped(std::FILE* file, const std::string& text)
+    {
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                std::fputc('\\', file);
+            if (static_cast<unsigned char>(c) >= 0x20)
+                std::fputc(c, file);
+        }
+    }
+}
+
+ReplayBenchmark::ReplayBenchmark(const Options& options)
+    : m_options(options)
+{
+    m_options.warmupFrames = std::max(0, m_options.warmupFrames);
+
+    const size_t expected = m_options.frames > 0 ? static_cast<size_t>(m_options.frames) : 8192;
+    m_frameMs.reserve(expected);
+    m_waitMs.reserve(expected);
+}
+
+bool ReplayBenchmark::frameRange(int totalFrames, int& first, int& end) const
+{
+    first = std::clamp(m_options.firstFrame, 0, std::max(0, totalFrames - 1));
+    end   = totalFrames;
+    if (m_options.frames > 0)
+        end = std::min(totalFrames, first + m_options.warmupFrames + m_options.frames);
+
+    // Need at least one measured frame
+    return end - first > m_options.warmupFrames;
+}
+
+int ReplayBenchmark::frameAt(int step, int first, int end) const
+{
+    if (!m_options.seeks)
+        return first + step;
+
+    // Integer hash of the step: reproducible, no state, no clustering
+    uint32_t h = static_cast<uint32_t>(step) * 0x9E3779B1u;
+    h ^= h >> 15;
+    h *= 0x85EBCA77u;
+    h ^= h >> 13;
+    return first + static_cast<int>(h % static_cast<uint32_t>(end - first));
+}
+
+void ReplayBenchmark::begin()
+{
+    m_frameMs.clear();
+    m_waitMs.clear();
+    ProcessStats::ioBytes(m_ioReadAtStart, m_ioWriteAtStart);
+    m_summary = Summary{};
+    m_start = Clock::now();
+    m_begun = true;
+}
+
+void ReplayBenchmark::addFrame(double frameMs, double waitMs, size_t pointsDrawn, size_t uploadBytes)
+{
+    m_frameMs.push_back(frameMs);
+    m_waitMs.push_back(waitMs);
+    m_summary.pointsDrawn += pointsDrawn;
+    m_summary.uploadBytes += uploadBytes;
+}
+
+void ReplayBenchmark::end()
+{
+    if (!m_begun)
+        return;
+
+    Summary& s = m_summary;
+    s.seconds = std::chrono::duration<double>(Clock::now() - m_start).count();
+    s.frames  = static_cast<int>(m_frameMs.size());
+    s.fps     = s.seconds > 0.0 ? s.frames / s.seconds : 0.0;
+
+    double sum = 0.0;
+    for (double ms : m_frameMs)
+        sum += ms;
+    s.frameMeanMs = s.frames > 0 ? sum / s.frames : 0.0;
+
+    std::sort(m_frameMs.begin(), m_frameMs.end());
+    std::sort(m_waitMs.begin(), m_waitMs.end());
+    s.frameP50Ms = percentile(m_frameMs, 0.50);
+    s.frameP95Ms = percentile(m_frameMs, 0.95);
+    s.frameP99Ms = percentile(m_frameMs, 0.99);
+    s.frameMaxMs = m_frameMs.empty() ? 0.0 : m_frameMs.back();
+    s.waitP50Ms  = percentile(m_waitMs, 0.50);
+    s.waitP95Ms  = percentile(m_waitMs, 0.95);
+    s.waitP99Ms  = percentile(m_waitMs, 0.99);
+
+    uint64_t readBytes = 0, writeBytes = 0;
+    if (ProcessStats::ioBytes(readBytes, writeBytes))
+    {
+        s.ioReadBytes  = readBytes - m_ioReadAtStart;
+        s.ioWriteBytes = writeBytes - m_ioWriteAtStart;
+    }
+    s.peakRssBytes = ProcessStats::peakRssBytes();
+}
+
+std::string ReplayBenchmark::describe() const
+{
+    const Summary& s = m_summary;
+
+    char buf[384];
+    std::snprintf(buf, sizeof(buf),
+                  "%s%d frames in %.2f s, %.1f fps | frame p50 %.2f p95 %.2f p99 %.2f max %.2f ms | "
+                  "loader wait p95 %.2f ms | peak RSS %.1f MB | read %.1f MB | uploaded %.1f MB",
+                  m_options.seeks ? "random seeks: " : "", s.frames, s.seconds, s.fps,
+                  s.frameP50Ms, s.frameP95Ms, s.frameP99Ms, s.frameMaxMs, s.waitP95Ms,
+                  s.peakRssBytes / (1024.0 * 1024.0), s.ioReadBytes / (1024.0 * 1024.0),
+                  s.uploadBytes / (1024.0 * 1024.0));
+    return buf;
+}
+
+bool ReplayBenchmark::writeJson(const std::string& path, const std::string& device) const
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file)
+        return false;
+
+    const Summary& s = m_summary;
+
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::fputs("{\n  \"label\": \"", file);
+    writeEscaped(file, m_options.label);
+    std::fprintf(file, "\",\n  \"date\": \"%s\",\n  \"device\": \"", date);
+    writeEscaped(file, device);
+    std::fputs("\",\n", file);
+
+    std::fprintf(file,
+        "  \"mode\": \"%s\",\n  \"first_frame\": %d,\n  \"warmup_frames\": %d,\n  \"frames\": %d,\n"
+        "  \"seconds\": %.4f,\n  \"fps\": %.3f,\n"
+        "  \"frame_ms\": {\"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f, \"mean\": %.4f},\n"
+        "  \"loader_wait_ms\": {\"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f},\n"
+        "  \"peak_rss_bytes\": %llu,\n  \"io_read_bytes\": %llu,\n  \"io_write_bytes\": %llu,\n"
+        "  \"upload_bytes\": %llu,\n  \"points_drawn\": %llu\n}\n",
+        m_options.seeks ? "seeks" : "sequential", m_options.firstFrame, m_options.warmupFrames, s.frames,
+        s.seconds, s.fps,
+        s.frameP50Ms, s.frameP95Ms, s.frameP99Ms, s.frameMaxMs, s.frameMeanMs,
+        s.waitP50Ms, s.waitP95Ms, s.waitP99Ms,
+        static_cast<unsigned long long>(s.peakRssBytes),
+        static_cast<unsigned long long>(s.ioReadBytes),
+        static_cast<unsigned long long>(s.ioWriteBytes),
+        static_cast<unsigned long long>(s.uploadBytes),
+        static_cast<unsigned long long>(s.pointsDrawn));
+
+    return std::fclose(file) == 0;
+}
@@ -33,6 +33,8 @@ bool Window::initialize()
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
+    glfwWindowHint(GLFW_VISIBLE, m_visible ? GLFW_TRUE : GLFW_FALSE);
+
     m_window = glfwCreateWindow(m_width, m_height, m_title.c_str(), nullptr, nullptr);
     if (!m_window)
     {
@@ -42,6 +44,7 @@ bool Window::initialize()
     }
 
     glfwMakeContextCurrent(m_window);
+    glfwSwapInterval(m_vsync ? 1 : 0);
 
     // Load OpenGL function pointers via GLAD
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
@@ -66,6 +69,8 @@ bool Window::initialize()
                 self->m_width = w;
                 self->m_height = h;
                 glViewport(0, 0, w, h);
+                if (self->m_callbacks.onResize)
+                    self->m_callbacks.onResize(w, h);
             }
         });
 
@@ -78,6 +83,68 @@ void Window::update()
     glfwPollEvents();
 }
 
+void Window::swapBuffers()
+{
+    glfwSwapBuffers(m_window);
+}
+
+void Window::pollEvents()
+{
+    glfwPollEvents();
+}
+
+void Window::waitEvents(double timeoutSeconds)
+{
+    if (timeoutSeconds <= 0.0)
+        glfwPollEvents();
+    else
+        glfwWaitEventsTimeout(timeoutSeconds);
+}
+
+void Window::postEmptyEvent()
+{
+    glfwPostEmptyEvent();
+}
+
+void Window::setEventCallbacks(const EventCallbacks& callbacks)
+{
+    m_callbacks = callbacks;
+
+    // The window user pointer is this Window; each callback looks up
+    // its handler through it.
+    glfwSetKeyCallback(m_window,
+        [](GLFWwindow* win, int key, int /*scancode*/, int action, int /*mods*/)
+        {
+            auto* self = static_cast<Window*>(glfwGetWindowUserPointer(win));
+            if (self && self->m_callbacks.onKey)
+                self->m_callbacks.onKey(key, action);
+        });
+
+    glfwSetMouseButtonCallback(m_window,
+        [](GLFWwindow* win, int button, int action, int /*mods*/)
+        {
+            auto* self = static_cast<Window*>(glfwGetWindowUserPointer(win));
+            if (self && self->m_callbacks.onMouseButton)
+                self->m_callbacks.onMouseButton(button, action);
+        });
+
+    glfwSetCursorPosCallback(m_window,
+        [](GLFWwindow* win, double x, double y)
+        {
+            auto* self = static_cast<Window*>(glfwGetWindowUserPointer(win));
+            if (self && self->m_callbacks.onCursorPos)
+                self->m_callbacks.onCursorPos(x, y);
+        });
+
+    glfwSetScrollCallback(m_window,
+        [](GLFWwindow* win, double dx, double dy)
+        {
+            auto* self = static_cast<Window*>(glfwGetWindowUserPointer(win));
+            if (self && self->m_callbacks.onScroll)
+                self->m_callbacks.onScroll(dx, dy);
+        });
+}
+
 bool Window::shouldClose() const
 {
     return glfwWindowShouldClose(m_window);
@@ -0,0 +1,562 @@
+#include "FramePipeline.h"
+#include "IKittiLoader.h"
+#include "core/JobSystem.h"
+#include "core/MemoryBudget.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <type_traits>
+
+namespace
+{
+    // Reserve and fault in a buffer's pages now rather than on the
+    // loader thread's first fill
+    template <typename T>
+    void presize(std::vector<T>& buffer, size_t count)
+    {
+        buffer.resize(count);
+        buffer.clear();
+    }
+}
+
+FramePipeline::FramePipeline(const Params& params)
+    : m_params(params)
+{
+    m_params.bufferCount = std::max(2, m_params.bufferCount);
+
+    m_pool.reserve(m_params.bufferCount);
+    m_measuredImages.reserve(m_params.bufferCount);
+    m_parked.reserve(m_params.bufferCount);
+    for (int i = 0; i < m_params.bufferCount; ++i)
+        addBuffer();
+
+    MemoryBudget& budget = MemoryBudget::instance();
+    m_cloudMemoryId = budget.add("frame_clouds", MemoryBudget::Host,
+                                 [this](size_t excess) { return requestShrink(excess); });
+    m_imageMemoryId = budget.add("frame_images", MemoryBudget::Host);
+    reportMemory();
+}
+
+FramePipeline::FramePipeline(IKittiLoader& loader)
+    : FramePipeline(loader, Params())
+{
+}
+
+FramePipeline::FramePipeline(IKittiLoader& loader, const Params& params)
+    : FramePipeline(params)
+{
+    addStream(loader);
+}
+
+FramePipeline::~FramePipeline()
+{
+    stop();
+
+    MemoryBudget::instance().remove(m_cloudMemoryId);
+    MemoryBudget::instance().remove(m_imageMemoryId);
+}
+
+void FramePipeline::addBuffer()
+{
+    auto frame = std::make_unique<FrameData>();
+    presize(frame->cloud.getPoints(), m_params.reservePoints);
+    presize(frame->normals, m_params.reservePoints);
+    for (int i = 0; i < getCameraCount(); ++i)
+        presize(frame->images[i].pixels, m_params.reserveImageBytes);
+    m_pool.push_back(std::move(frame));
+    m_measuredImages.emplace_back();
+}
+
+FramePipeline::StreamId FramePipeline::addStream(IKittiLoader& loader)
+{
+    // The rings exist from the first start() on and cannot grow
+    if (m_free)
+        return -1;
+
+    auto stream = std::make_unique<Stream>();
+    stream->loader = &loader;
+    m_streams.push_back(std::move(stream));
+
+    // Every stream needs one buffer on screen and one loading
+    while (m_pool.size() < 2 * m_streams.size())
+        addBuffer();
+    m_params.bufferCount = static_cast<int>(m_pool.size());
+    m_parked.reserve(m_pool.size());
+    reportMemory();
+
+    return static_cast<StreamId>(m_streams.size() - 1);
+}
+
+void FramePipeline::start(int firstFrame)
+{
+    if (isRunning() || m_streams.empty())
+        return;
+
+    if (!m_free)
+    {
+        m_free = std::make_unique<SpscRing<FrameData*>>(m_pool.size());
+        for (const auto& frame : m_pool)
+            m_free->tryPush(frame.get());
+        for (const auto& stream : m_streams)
+            stream->ready = std::make_unique<SpscRing<FrameData*>>(m_pool.size());
+    }
+
+    for (const auto& stream : m_streams)
+    {
+        stream->requested = firstFrame;
+        stream->lastRequested = firstFrame;
+        stream->cursor = firstFrame;
+        stream->loadedGeneration = stream->generation.load(std::memory_order_relaxed);
+    }
+
+    m_running = true;
+    m_thread = std::thread(&FramePipeline::loaderLoop, this);
+}
+
+void FramePipeline::stop()
+{
+    if (!isRunning())
+        return;
+
+    m_running = false;
+    wakeLoader();
+    if (m_thread.joinable())
+        m_thread.join();
+
+    // Decodes of cancelled loads still write into parked buffers
+    for (const Parked& parked : m_parked)
+    {
+        for (const JobSystem::TaskHandle& job : parked.jobs)
+            JobSystem::instance().wait(job);
+    }
+}
+
+// ------------------------------------------------------------
+// Render thread
+// ------------------------------------------------------------
+void FramePipeline::request(int frame, StreamId id)
+{
+    Stream& stream = *m_streams[id];
+    if (frame == stream.lastRequested)
+        return;
+
+    stream.requested.store(frame, std::memory_order_release);
+
+    // Going backwards invalidates everything read ahead so far.
+    // Bumped after the store: a loader that sees the new generation
+    // is guaranteed to see the new frame too.
+    if (frame < stream.lastRequested)
+        stream.generation.fetch_add(1, std::memory_order_release);
+
+    stream.lastRequested = frame;
+    wakeLoader();
+}
+
+void FramePipeline::seek(int frame, StreamId id)
+{
+    Stream& stream = *m_streams[id];
+    stream.requested.store(frame, std::memory_order_release);
+    stream.generation.fetch_add(1, std::memory_order_release);
+    stream.lastRequested = frame;
+    wakeLoader();
+}
+
+FrameData* FramePipeline::acquire(int frame, StreamId id)
+{
+    Stream& stream = *m_streams[id];
+    const uint32_t generation = stream.generation.load(std::memory_order_relaxed);
+
+    // Read-ahead hit: the frame was already queued when first asked for
+    const bool firstLookup = frame != stream.lookupFrame;
+    if (firstLookup)
+    {
+        stream.lookupFrame = frame;
+        stream.lookupResolved = false;
+    }
+
+    FrameData* newest = nullptr;
+    while (FrameData** slot = stream.ready->front())
+    {
+        FrameData* data = *slot;
+
+        // From before a seek or a backwards step
+        if (data->generation != generation)
+        {
+            stream.ready->pop();
+            release(data);
+            stream.discarded++;
+            continue;
+        }
+
+        // Read-ahead beyond the wanted frame stays queued
+        if (data->frameIndex > frame)
+            break;
+
+        // At or before the wanted frame: the newest of these is shown,
+        // so a loader slower than playback still moves the picture on
+        stream.ready->pop();
+        if (newest)
+        {
+            release(newest);
+            stream.discarded++;
+        }
+        newest = data;
+    }
+
+    if (newest && newest->frameIndex == frame && !stream.lookupResolved)
+    {
+        (firstLookup ? stream.readyHits : stream.readyMisses)++;
+        stream.lookupResolved = true;
+    }
+    return newest;
+}
+
+size_t FramePipeline::getQueuedCount(StreamId id) const
+{
+    const Stream& stream = *m_streams[id];
+    return stream.ready ? stream.ready->sizeApprox() : 0;
+}
+
+double FramePipeline::getReadyHitRate(StreamId id) const
+{
+    const Stream& stream = *m_streams[id];
+    const uint64_t lookups = stream.readyHits + stream.readyMisses;
+    return lookups > 0 ? static_cast<double>(stream.readyHits) / lookups : 1.0;
+}
+
+void FramePipeline::release(FrameData* frame)
+{
+    if (!frame)
+        return;
+
+    m_streams[frame->stream]->inFlight.fetch_sub(1, std::memory_order_release);
+
+    // Cannot fail: the free ring holds the whole pool
+    m_free->tryPush(frame);
+    wakeLoader();
+}
+
+void FramePipeline::wakeLoader()
+{
+    // Sequentially consistent with waitForWork(): either the loader
+    // sees the new epoch before sleeping, or we see it waiting
+    m_wakeEpoch.fetch_add(1);
+    if (!m_loaderWaiting.load())
+        return;
+
+    // Taking the lock orders the notify after the loader's check
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+    }
+    m_wake.notify_one();
+}
+
+// ------------------------------------------------------------
+// Memory accounting
+// ------------------------------------------------------------
+size_t FramePipeline::requestShrink(size_t /*excessBytes*/)
+{
+    // Runs on the render thread; the loader owns the free buffers,
+    // so it does the shrinking as it takes them
+    const size_t slack = m_slackBytes.load(std::memory_order_relaxed);
+    if (slack == 0 || m_shrinkPending.load(std::memory_order_relaxed) > 0)
+        return 0;
+
+    m_shrinkPending.store(m_params.bufferCount, std::memory_order_relaxed);
+    return slack;
+}
+
+void FramePipeline::shrinkToReservation(FrameData& frame)
+{
+    auto shrink = [](auto& buffer, size_t reserve)
+    {
+        if (buffer.capacity() <= reserve)
+            return;
+        std::decay_t<decltype(buffer)>().swap(buffer);
+        presize(buffer, reserve);
+    };
+
+    shrink(frame.cloud.getPoints(), m_params.reservePoints);
+    shrink(frame.normals, m_params.reservePoints);
+    for (CameraImage& image : frame.images)
+        shrink(image.pixels, m_params.reserveImageBytes);
+}
+
+void FramePipeline::reportMemory()
+{
+    // Only the loader thread resizes the clouds. Images are also
+    // written by decode jobs, which may still run for parked buffers
+    // (cancelled loads): those keep their last measured size until
+    // takeBuffer() has seen their jobs finish.
+    size_t cloudBytes = 0, imageBytes = 0, slack = 0;
+    const size_t reserveCloud = m_params.reservePoints * (sizeof(PointCloud::Point) + sizeof(uint32_t));
+
+    auto isParked = [this](const FrameData* frame)
+    {
+        for (const Parked& parked : m_parked)
+        {
+            if (parked.frame == frame)
+                return true;
+        }
+        return false;
+    };
+
+    for (size_t i = 0; i < m_pool.size(); ++i)
+    {
+        const FrameData& frame = *m_pool[i];
+        const size_t cloud = frame.cloud.getPoints().capacity() * sizeof(PointCloud::Point)
+                           + frame.normals.capacity() * sizeof(uint32_t);
+        cloudBytes += cloud;
+        slack += cloud > reserveCloud ? cloud - reserveCloud : 0;
+
+        MeasuredImages& measured = m_measuredImages[i];
+        if (!isParked(&frame))
+        {
+            measured = MeasuredImages();
+            for (const CameraImage& image : frame.images)
+            {
+                const size_t bytes = image.pixels.capacity();
+                measured.bytes += bytes;
+                measured.slack += bytes > m_params.reserveImageBytes ? bytes - m_params.reserveImageBytes : 0;
+            }
+        }
+        imageBytes += measured.bytes;
+        slack += measured.slack;
+    }
+
+    MemoryBudget& budget = MemoryBudget::instance();
+    budget.setUsage(m_cloudMemoryId, cloudBytes);
+    budget.setUsage(m_imageMemoryId, imageBytes);
+    m_slackBytes.store(slack, std::memory_order_relaxed);
+}
+
+// ------------------------------------------------------------
+// Loader thread
+// ------------------------------------------------------------
+bool FramePipeline::isStale(const Stream& stream, uint32_t generation)
+{
+    return stream.generation.load(std::memory_order_acquire) != generation;
+}
+
+bool FramePipeline::loadFrame(FrameData& frame, Stream& stream, int index,
+                              JobSystem::TaskHandle (&imageJobs)[FrameData::kMaxImages])
+{
+    PROFILE_SCOPE("FramePipeline::loadFrame");
+
+    using Clock = std::chrono::steady_clock;
+
+    auto t0 = Clock::now();
+
+    IKittiLoader& loader = *stream.loader;
+    const uint32_t generation = stream.loadedGeneration;
+
+    frame.frameIndex = index;
+    frame.stageCount = 0;
+    frame.hasNormals = false;
+
+    // One PNG decode job per camera while the scan is parsed here;
+    // waiting runs queued decodes on this thread too, so extra
+    // cameras cost little more latency than one
+    frame.imageCount = getCameraCount();
+    for (int i = 0; i < frame.imageCount; ++i)
+    {
+        CameraImage& image = frame.images[i];
+        image.camera = m_params.cameras[i];
+        image.width = image.height = 0;
+        imageJobs[i] = JobSystem::instance().submit([&loader, &stream, &image, generation, index]()
+        {
+            if (isStale(stream, generation) ||
+                !loader.loadCameraImage(index, image.camera, image.width, image.height, image.pixels))
+            {
+                image.pixels.clear();
+                image.width = image.height = 0;
+            }
+        });
+    }
+
+    if (isStale(stream, generation))
+        return false;
+
+    loader.loadPointCloudInto(index, frame.cloud);
+
+    // Estimated poses are registered from this scan off this thread;
+    // until then the frame has none
+    loader.onScanLoaded(index, frame.cloud);
+    frame.hasPose = loader.tryGetPose(index, frame.pose);
+
+    // Superseded during the parse: leave the decodes to finish alone
+    if (isStale(stream, generation))
+        return false;
+
+    for (int i = 0; i < frame.imageCount; ++i)
+        JobSystem::instance().wait(imageJobs[i]);
+
+    if (isStale(stream, generation))
+        return false;
+
+    auto t1 = Clock::now();
+
+    if (m_prepare)
+        m_prepare(frame);
+
+    auto t2 = Clock::now();
+
+    frame.loadMs    = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    frame.prepareMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    return true;
+}
+
+int FramePipeline::getCameraCount() const
+{
+    return std::min(static_cast<int>(m_params.cameras.size()), static_cast<int>(FrameData::kMaxImages));
+}
+
+int FramePipeline::nextFrameFor(Stream& stream, int share)
+{
+    // Generation first (see request())
+    const uint32_t gen    = stream.generation.load(std::memory_order_acquire);
+    const int      wanted = stream.requested.load(std::memory_order_acquire);
+
+    if (gen != stream.loadedGeneration)
+    {
+        stream.loadedGeneration = gen;
+        stream.cursor = wanted;
+    }
+    else if (stream.cursor < wanted)
+    {
+        // Playback overtook us: skip frames nobody will show
+        stream.skipped.fetch_add(static_cast<uint64_t>(wanted - stream.cursor), std::memory_order_relaxed);
+        stream.cursor = wanted;
+    }
+
+    if (stream.cursor >= stream.loader->getTotalFrames())
+        return -1;
+
+    // Fair share: every buffer this stream may hold is queued or on screen
+    if (stream.inFlight.load(std::memory_order_acquire) >= share)
+        return -1;
+
+    return stream.cursor;
+}
+
+FrameData* FramePipeline::takeBuffer()
+{
+    auto jobsDone = [](const Parked& parked)
+    {
+        for (const JobSystem::TaskHandle& job : parked.jobs)
+        {
+            if (!job.isDone())
+                return false;
+        }
+        return true;
+    };
+
+    auto unpark = [this](size_t i)
+    {
+        FrameData* frame = m_parked[i].frame;
+        m_parked[i] = std::move(m_parked.back());
+        m_parked.pop_back();
+        return frame;
+    };
+
+    for (size_t i = 0; i < m_parked.size(); ++i)
+    {
+        if (jobsDone(m_parked[i]))
+            return unpark(i);
+    }
+
+    FrameData* frame = nullptr;
+    if (m_free->tryPop(frame))
+    {
+        if (m_shrinkPending.load(std::memory_order_relaxed) > 0)
+        {
+            shrinkToReservation(*frame);
+            m_shrinkPending.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return frame;
+    }
+
+    // Only parked buffers left: their decodes are the last work
+    // between us and a free buffer
+    if (m_parked.empty())
+        return nullptr;
+
+    for (const JobSystem::TaskHandle& job : m_parked.front().jobs)
+        JobSystem::instance().wait(job);
+    return unpark(0);
+}
+
+void FramePipeline::loaderLoop()
+{
+    Profiler::setThreadName("loader");
+
+    const int streamCount = static_cast<int>(m_streams.size());
+    const int share = std::max(2, static_cast<int>(m_pool.size()) / streamCount);
+    int next = 0;   // round-robin start
+    uint64_t loadId = 0;
+
+    while (m_running.load(std::memory_order_acquire))
+    {
+        // Read before looking for work: a change after this wakes us
+        const uint32_t epoch = m_wakeEpoch.load();
+
+        Stream* stream = nullptr;
+        int streamId = -1, index = -1;
+        for (int i = 0; i < streamCount && !stream; ++i)
+        {
+            const int candidate = (next + i) % streamCount;
+            index = nextFrameFor(*m_streams[candidate], share);
+            if (index >= 0)
+            {
+                stream = m_streams[candidate].get();
+                streamId = candidate;
+                next = (candidate + 1) % streamCount;
+            }
+        }
+
+        // Nothing wanted, or backpressure: every buffer is queued or on screen
+        FrameData* frame = stream ? takeBuffer() : nullptr;
+        if (!frame)
+        {
+            waitForWork(epoch);
+            continue;
+        }
+
+        frame->stream = streamId;
+        stream->inFlight.fetch_add(1, std::memory_order_relaxed);
+
+        Parked load;
+        if (!loadFrame(*frame, *stream, index, load.jobs))
+        {
+            // Superseded: park the buffer, the next pass loads what is
+            // wanted now
+            stream->inFlight.fetch_sub(1, std::memory_order_relaxed);
+            stream->cancelled.fetch_add(1, std::memory_order_relaxed);
+            load.frame = frame;
+            m_parked.push_back(std::move(load));
+            continue;
+        }
+        frame->generation = stream->loadedGeneration;
+        frame->loadId = ++loadId;
+        reportMemory();
+
+        // Cannot fail: the ready ring holds the whole pool
+        stream->ready->tryPush(std::move(frame));
+        stream->cursor++;
+
+        if (m_onReady)
+            m_onReady();
+    }
+}
+
+void FramePipeline::waitForWork(uint32_t epoch)
+{
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_loaderWaiting.store(true);
+    m_wake.wait(lock, [&]()
+    {
+        return m_wakeEpoch.load() != epoch || !m_running.load();
+    });
+    m_loaderWaiting.store(false);
+}
@@ -0,0 +1,302 @@
+#include "IcpOdometry.h"
+#include "PointCloud.h"
+#include "core/JobSystem.h"
+#include "utils/MathUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+IcpOdometry::IcpOdometry()
+    : m_params()
+{
+}
+
+IcpOdometry::IcpOdometry(const Params& params)
+    : m_params(params)
+{
+}
+
+void IcpOdometry::reset()
+{
+    m_poses.clear();
+    m_lastDelta = glm::mat4(1.0f);
+    m_targetTree = KdTree();
+    m_targetNormals.clear();
+    m_targetNormalValid.clear();
+}
+
+// ------------------------------------------------------------
+// Voxel grid: one centroid per occupied voxel
+// ------------------------------------------------------------
+void IcpOdometry::voxelDownsample(const PointCloud& cloud, float voxelSize,
+                                  std::vector<glm::vec3>& out)
+{
+    const float inv = 1.0f / voxelSize;
+    const float minR2 = m_params.minRange * m_params.minRange;
+    const float maxR2 = m_params.maxRange * m_params.maxRange;
+
+    m_voxels.clear();
+
+    for (const auto& p : cloud.getPoints())
+    {
+        float r2 = p.x * p.x + p.y * p.y + p.z * p.z;
+        if (r2 < minR2 || r2 > maxR2)
+            continue;
+
+        // 21 bits per axis is ±1M voxels — far beyond LiDAR range
+        int64_t ix = static_cast<int64_t>(std::floor(p.x * inv)) & 0x1FFFFF;
+        int64_t iy = static_cast<int64_t>(std::floor(p.y * inv)) & 0x1FFFFF;
+        int64_t iz = static_cast<int64_t>(std::floor(p.z * inv)) & 0x1FFFFF;
+        int64_t key = (ix << 42) | (iy << 21) | iz;
+
+        auto it = m_voxels.try_emplace(key, glm::vec4(0.0f)).first;
+        it->second += glm::vec4(p.x, p.y, p.z, 1.0f);
+    }
+
+    out.clear();
+    out.reserve(m_voxels.size());
+    for (const auto& kv : m_voxels)
+        out.push_back(glm::vec3(kv.second) / kv.second.w);
+}
+
+// ------------------------------------------------------------
+// Target: kd-tree + PCA normals
+// ------------------------------------------------------------
+void IcpOdometry::computeTargetNormals(size_t begin, size_t end)
+{
+    std::vector<int> neighbours;
+    neighbours.reserve(64);
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        const glm::vec3& c = m_targetTree.position(static_cast<int>(i));
+
+        neighbours.clear();
+        m_targetTree.radiusSearch(c, m_params.normalRadius, neighbours);
+
+        m_targetNormalValid[i] = 0;
+        if (neighbours.size() < 5)
+            continue;
+
+        glm::vec3 mean(0.0f);
+        for (int idx : neighbours)
+            mean += m_targetTree.position(idx);
+        mean /= static_cast<float>(neighbours.size());
+
+        glm::mat3 cov(0.0f);
+        for (int idx : neighbours)
+        {
+            glm::vec3 d = m_targetTree.position(idx) - mean;
+            cov += glm::outerProduct(d, d);
+        }
+
+        glm::vec3 n = MathUtils::smallestEigenvector(cov);
+        if (glm::dot(n, n) < 0.5f)
+            continue;
+
+        m_targetNormals[i] = n;
+        m_targetNormalValid[i] = 1;
+    }
+}
+
+void IcpOdometry::setTarget(const std::vector<glm::vec3>& points)
+{
+    m_targetTree.build(points);
+
+    const size_t n = points.size();
+    m_targetNormals.assign(n, glm::vec3(0.0f));
+    m_targetNormalValid.assign(n, 0);
+
+    JobSystem::instance().parallelFor(0, n, 512,
+        [this](size_t begin, size_t end)
+        {
+            computeTargetNormals(begin, end);
+        });
+}
+
+// ------------------------------------------------------------
+// Point-to-plane normal equations for source[begin, end)
+// ------------------------------------------------------------
+// Residual r = n · (T p - q). With a left-multiplied small update
+// (ω, v) the Jacobian is J = [ (T p) × n , n ].
+void IcpOdometry::accumulate(const glm::mat4& T, size_t begin, size_t end,
+                             Accumulator& acc) const
+{
+    std::memset(&acc, 0, sizeof(acc));
+
+    const float maxDist = m_params.maxCorrespondenceDist;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        glm::vec3 p = glm::vec3(T * glm::vec4(m_source[i], 1.0f));
+
+        float d2;
+        int idx = m_targetTree.nearest(p, maxDist, d2);
+        if (idx < 0 || !m_targetNormalValid[idx])
+            continue;
+
+        const glm::vec3& n = m_targetNormals[idx];
+        const glm::vec3& q = m_targetTree.position(idx);
+
+        double r = glm::dot(n, p - q);
+        glm::vec3 pxn = glm::cross(p, n);
+        double J[6] = { pxn.x, pxn.y, pxn.z, n.x, n.y, n.z };
+
+        for (int a = 0; a < 6; ++a)
+        {
+            acc.b[a] += J[a] * r;
+            for (int c = a; c < 6; ++c)
+                acc.H[a][c] += J[a] * J[c];
+        }
+
+        acc.error += r * r;
+        acc.count++;
+    }
+}
+
+// ------------------------------------------------------------
+// Gauss-Newton ICP; returns the source → target transform
+// ------------------------------------------------------------
+glm::mat4 IcpOdometry::align(const glm::mat4& initial)
+{
+    glm::mat4 T = initial;
+
+    // Fixed chunking: partial sums are indexed by chunk, so the
+    // reduction order (and the result) does not depend on scheduling.
+    const size_t n = m_source.size();
+    const size_t grain = 1024;
+    const size_t chunks = (n + grain - 1) / grain;
+    m_partials.resize(std::max<size_t>(1, chunks));
+
+    for (int iter = 0; iter < m_params.maxIterations; ++iter)
+    {
+        for (auto& acc : m_partials)
+            std::memset(&acc, 0, sizeof(acc));
+
+        JobSystem::instance().parallelFor(0, n, grain,
+            [this, &T, grain](size_t begin, size_t end)
+            {
+                accumulate(T, begin, end, m_partials[begin / grain]);
+            });
+
+        // Reduce
+        Accumulator total;
+        std::memset(&total, 0, sizeof(total));
+        for (const auto& acc : m_partials)
+        {
+            for (int a = 0; a < 6; ++a)
+            {
+                total.b[a] += acc.b[a];
+                for (int c = a; c < 6; ++c)
+                    total.H[a][c] += acc.H[a][c];
+            }
+            total.error += acc.error;
+            total.count += acc.count;
+        }
+
+        if (total.count < 32)
+            break; // too few correspondences to trust
+
+        for (int a = 0; a < 6; ++a)
+            for (int c = 0; c < a; ++c)
+                total.H[a][c] = total.H[c][a];
+
+        double rhs[6];
+        for (int a = 0; a < 6; ++a)
+            rhs[a] = -total.b[a];
+
+        double x[6];
+        if (!solve6x6(total.H, rhs, x))
+            break;
+
+        glm::vec3 omega(static_cast<float>(x[0]), static_cast<float>(x[1]), static_cast<float>(x[2]));
+        glm::vec3 v(static_cast<float>(x[3]), static_cast<float>(x[4]), static_cast<float>(x[5]));
+
+        glm::mat4 dT(1.0f);
+        float angle = glm::length(omega);
+        if (angle > 1e-9f)
+            dT = glm::rotate(glm::mat4(1.0f), angle, omega / angle);
+        dT[3] = glm::vec4(v, 1.0f);
+
+        T = dT * T;
+
+        if (angle + glm::length(v) < m_params.convergenceEps)
+            break;
+    }
+
+    return T;
+}
+
+// ------------------------------------------------------------
+// Gaussian elimination with partial pivoting
+// ------------------------------------------------------------
+bool IcpOdometry::solve6x6(double H[6][6], double b[6], double x[6])
+{
+    double A[6][7];
+    for (int r = 0; r < 6; ++r)
+    {
+        for (int c = 0; c < 6; ++c)
+            A[r][c] = H[r][c];
+        A[r][6] = b[r];
+    }
+
+    for (int col = 0; col < 6; ++col)
+    {
+        int pivot = col;
+        for (int r = col + 1; r < 6; ++r)
+            if (std::fabs(A[r][col]) > std::fabs(A[pivot][col]))
+                pivot = r;
+
+        if (std::fabs(A[pivot][col]) < 1e-12)
+            return false;
+
+        if (pivot != col)
+            for (int c = 0; c < 7; ++c)
+                std::swap(A[col][c], A[pivot][c]);
+
+        for (int r = col + 1; r < 6; ++r)
+        {
+            double f = A[r][col] / A[col][col];
+            for (int c = col; c < 7; ++c)
+                A[r][c] -= f * A[col][c];
+        }
+    }
+
+    for (int r = 5; r >= 0; --r)
+    {
+        double s = A[r][6];
+        for (int c = r + 1; c < 6; ++c)
+            s -= A[r][c] * x[c];
+        x[r] = s / A[r][r];
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------
+// Public API
+// ------------------------------------------------------------
+glm::mat4 IcpOdometry::addScan(const PointCloud& cloud)
+{
+    voxelDownsample(cloud, m_params.sourceVoxelSize, m_source);
+
+    glm::mat4 pose(1.0f);
+    if (!m_poses.empty() && !m_targetTree.empty())
+    {
+        // delta maps the new scan into the previous scan's frame
+        glm::mat4 delta = align(m_lastDelta);
+        pose = m_poses.back() * delta;
+        m_lastDelta = delta;
+    }
+
+    m_poses.push_back(pose);
+
+    // The new scan becomes the next target
+    voxelDownsample(cloud, m_params.targetVoxelSize, m_nextTarget);
+    setTarget(m_nextTarget);
+
+    return pose;
+}
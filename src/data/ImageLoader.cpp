@@ -1,13 +1,11 @@
 #include "ImageLoader.h"
+#include "core/Profiler.h"
 #include "utils/Logger.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
-ImageLoader::ImageLoader()
-{
-    // Nothing to initialize
-}
+#include <cstring>
 
 bool ImageLoader::loadImage(
     const std::string& path,
@@ -15,7 +13,10 @@ bool ImageLoader::loadImage(
     int& height,
     std::vector<unsigned char>& outData)
 {
-    stbi_set_flip_vertically_on_load(false);
+    PROFILE_SCOPE("ImageLoader::loadImage");
+
+    // Rows stay top-first. stb's flip flag is process-wide and camera
+    // images decode concurrently, so it is left at its default (off).
 
     int channels = 0;
     unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 3);
@@ -26,13 +27,13 @@ bool ImageLoader::loadImage(
         return false;
     }
 
-    size_t imageSize = width * height * 3;
+    size_t imageSize = static_cast<size_t>(width) * height * 3;
     outData.resize(imageSize);
     std::memcpy(outData.data(), data, imageSize);
 
     stbi_image_free(data);
 
-    LOG_INFO("Loaded image: " + path +
+    LOG_DEBUG("Loaded image: " + path +
              " (" + std::to_string(width) + "x" +
              std::to_string(height) + ")");
 
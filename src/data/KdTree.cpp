@@ -0,0 +1,309 @@
+#include "KdTree.h"
+#include "PointCloud.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// ------------------------------------------------------------
+// Build
+// ------------------------------------------------------------
+void KdTree::build(const PointCloud& cloud, int leafSize)
+{
+    const auto& pts = cloud.getPoints();
+    const size_t n = pts.size();
+
+    m_positions.resize(n);
+    m_intensities.resize(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        m_positions[i]   = glm::vec3(pts[i].x, pts[i].y, pts[i].z);
+        m_intensities[i] = pts[i].intensity;
+    }
+
+    buildFromPositions(leafSize);
+}
+
+void KdTree::build(const std::vector<glm::vec3>& positions, int leafSize)
+{
+    m_positions = positions;
+    m_intensities.assign(positions.size(), 0.0f);
+
+    buildFromPositions(leafSize);
+}
+
+void KdTree::buildFromPositions(int leafSize)
+{
+    const size_t n = m_positions.size();
+
+    m_nodes.clear();
+    m_indices.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        m_indices[i] = static_cast<uint32_t>(i);
+
+    if (n == 0)
+        return;
+
+    // A balanced tree has < 2n/leafSize nodes
+    m_nodes.reserve(2 * n / std::max(1, leafSize) + 1);
+    buildNode(0, static_cast<uint32_t>(n), std::max(1, leafSize));
+}
+
+int32_t KdTree::buildNode(uint32_t begin, uint32_t end, int leafSize)
+{
+    const int32_t nodeIndex = static_cast<int32_t>(m_nodes.size());
+    m_nodes.push_back(Node{});
+
+    glm::vec3 bmin(std::numeric_limits<float>::max());
+    glm::vec3 bmax(-std::numeric_limits<float>::max());
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        const glm::vec3& p = m_positions[m_indices[i]];
+        bmin = glm::min(bmin, p);
+        bmax = glm::max(bmax, p);
+    }
+
+    m_nodes[nodeIndex].boundsMin = bmin;
+    m_nodes[nodeIndex].boundsMax = bmax;
+
+    if (end - begin <= static_cast<uint32_t>(leafSize))
+    {
+        m_nodes[nodeIndex].begin = begin;
+        m_nodes[nodeIndex].end   = end;
+        return nodeIndex;
+    }
+
+    // Split the longest axis at the median
+    glm::vec3 extent = bmax - bmin;
+    int axis = 0;
+    if (extent.y > extent[axis]) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+
+    uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(m_indices.begin() + begin,
+                     m_indices.begin() + mid,
+                     m_indices.begin() + end,
+                     [this, axis](uint32_t a, uint32_t b)
+                     {
+                         return m_positions[a][axis] < m_positions[b][axis];
+                     });
+
+    // m_nodes may reallocate during recursion: write through the index
+    int32_t left  = buildNode(begin, mid, leafSize);
+    int32_t right = buildNode(mid, end, leafSize);
+    m_nodes[nodeIndex].left  = left;
+    m_nodes[nodeIndex].right = right;
+
+    return nodeIndex;
+}
+
+// ------------------------------------------------------------
+// Slab test; returns the entry distance (clamped to 0)
+// ------------------------------------------------------------
+bool KdTree::rayBoxEntry(const glm::vec3& origin,
+                         const glm::vec3& invDir,
+                         const glm::vec3& bmin,
+                         const glm::vec3& bmax,
+                         float& tEntry)
+{
+    glm::vec3 t0 = (bmin - origin) * invDir;
+    glm::vec3 t1 = (bmax - origin) * invDir;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar  = glm::max(t0, t1);
+
+    float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    float exit  = std::min(std::min(tFar.x, tFar.y), tFar.z);
+
+    tEntry = enter;
+    return enter <= exit;
+}
+
+// ------------------------------------------------------------
+// Ray picking
+// ------------------------------------------------------------
+bool KdTree::pick(const glm::vec3& origin,
+                  const glm::vec3& dir,
+                  float tanHalfAngle,
+                  PickResult& out) const
+{
+    out = PickResult{};
+    if (m_nodes.empty())
+        return false;
+
+    const glm::vec3 invDir(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+    float bestT = std::numeric_limits<float>::max();
+
+    // Explicit stack; depth is ~log2(n / leafSize)
+    int32_t stack[64];
+    int sp = 0;
+    stack[sp++] = 0;
+
+    while (sp > 0)
+    {
+        const Node& node = m_nodes[stack[--sp]];
+
+        // Grow the box by the widest cone radius it can contain:
+        // every point in the box is no farther than its farthest corner.
+        glm::vec3 farCorner = glm::max(glm::abs(node.boundsMin - origin),
+                                       glm::abs(node.boundsMax - origin));
+        float grow = tanHalfAngle * glm::length(farCorner);
+
+        float tEntry;
+        if (!rayBoxEntry(origin, invDir,
+                         node.boundsMin - glm::vec3(grow),
+                         node.boundsMax + glm::vec3(grow), tEntry))
+            continue;
+
+        // Nothing in this box can be in front of the current best
+        if (tEntry > bestT)
+            continue;
+
+        if (node.left < 0)
+        {
+            for (uint32_t i = node.begin; i < node.end; ++i)
+            {
+                uint32_t idx = m_indices[i];
+                glm::vec3 v = m_positions[idx] - origin;
+                float t = glm::dot(v, dir);
+                if (t <= 0.0f || t >= bestT)
+                    continue;
+
+                float perp2 = glm::dot(v, v) - t * t;
+                float r = tanHalfAngle * t;
+                if (perp2 <= r * r)
+                {
+                    bestT = t;
+                    out.index = static_cast<int>(idx);
+                    out.distanceAlong = t;
+                    out.distanceToRay = std::sqrt(std::max(perp2, 0.0f));
+                }
+            }
+            continue;
+        }
+
+        if (sp + 2 > 64)
+            continue;
+
+        // Visit the child nearer to the ray origin first
+        const Node& l = m_nodes[node.left];
+        const Node& r = m_nodes[node.right];
+        glm::vec3 lc = 0.5f * (l.boundsMin + l.boundsMax);
+        glm::vec3 rc = 0.5f * (r.boundsMin + r.boundsMax);
+        bool leftFirst = glm::dot(lc - origin, dir) <= glm::dot(rc - origin, dir);
+
+        stack[sp++] = leftFirst ? node.right : node.left;
+        stack[sp++] = leftFirst ? node.left : node.right;
+    }
+
+    return out.index >= 0;
+}
+
+// ------------------------------------------------------------
+// Radius query
+// ------------------------------------------------------------
+void KdTree::radiusSearch(const glm::vec3& center,
+                          float radius,
+                          std::vector<int>& out) const
+{
+    if (m_nodes.empty())
+        return;
+
+    const float r2 = radius * radius;
+
+    int32_t stack[64];
+    int sp = 0;
+    stack[sp++] = 0;
+
+    while (sp > 0)
+    {
+        const Node& node = m_nodes[stack[--sp]];
+
+        // Squared distance from center to the box
+        glm::vec3 d = glm::max(glm::max(node.boundsMin - center, center - node.boundsMax),
+                               glm::vec3(0.0f));
+        if (glm::dot(d, d) > r2)
+            continue;
+
+        if (node.left < 0)
+        {
+            for (uint32_t i = node.begin; i < node.end; ++i)
+            {
+                uint32_t idx = m_indices[i];
+                glm::vec3 v = m_positions[idx] - center;
+                if (glm::dot(v, v) <= r2)
+                    out.push_back(static_cast<int>(idx));
+            }
+            continue;
+        }
+
+        if (sp + 2 > 64)
+            continue;
+
+        stack[sp++] = node.left;
+        stack[sp++] = node.right;
+    }
+}
+
+// ------------------------------------------------------------
+// Nearest neighbour
+// ------------------------------------------------------------
+int KdTree::nearest(const glm::vec3& query,
+                    float maxDistance,
+                    float& outDist2) const
+{
+    int best = -1;
+    float bestD2 = maxDistance * maxDistance;
+
+    if (m_nodes.empty())
+    {
+        outDist2 = bestD2;
+        return best;
+    }
+
+    int32_t stack[64];
+    int sp = 0;
+    stack[sp++] = 0;
+
+    while (sp > 0)
+    {
+        const Node& node = m_nodes[stack[--sp]];
+
+        glm::vec3 d = glm::max(glm::max(node.boundsMin - query, query - node.boundsMax),
+                               glm::vec3(0.0f));
+        if (glm::dot(d, d) >= bestD2)
+            continue;
+
+        if (node.left < 0)
+        {
+            for (uint32_t i = node.begin; i < node.end; ++i)
+            {
+                uint32_t idx = m_indices[i];
+                glm::vec3 v = m_positions[idx] - query;
+                float d2 = glm::dot(v, v);
+                if (d2 < bestD2)
+                {
+                    bestD2 = d2;
+                    best = static_cast<int>(idx);
+                }
+            }
+            continue;
+        }
+
+        if (sp + 2 > 64)
+            continue;
+
+        // Push the farther child first so the nearer one is popped next
+        const Node& l = m_nodes[node.left];
+        const Node& r = m_nodes[node.right];
+        glm::vec3 dl = glm::max(glm::max(l.boundsMin - query, query - l.boundsMax), glm::vec3(0.0f));
+        glm::vec3 dr = glm::max(glm::max(r.boundsMin - query, query - r.boundsMax), glm::vec3(0.0f));
+        bool leftNearer = glm::dot(dl, dl) <= glm::dot(dr, dr);
+
+        stack[sp++] = leftNearer ? node.right : node.left;
+        stack[sp++] = leftNearer ? node.left : node.right;
+    }
+
+    outDist2 = bestD2;
+    return best;
+}
@@ -3,10 +3,15 @@
 #include "PointCloudParser.h"
 #include "ImageLoader.h"
 #include "PoseLoader.h"
+#include "PointCloud.h"
+#include "core/Profiler.h"
 #include "utils/Logger.h"
 #include "utils/FileUtils.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <filesystem>
+#include <fstream>
 #include <sstream>
 
 namespace fs = std::filesystem;
@@ -14,19 +19,42 @@ namespace fs = std::filesystem;
 // ------------------------------------------------------------
 // Constructor
 // ------------------------------------------------------------
-KittiDataLoader::KittiDataLoader(const std::string& basePath)
-    : sequencePath(basePath)
+KittiDataLoader::KittiDataLoader(const std::string& sequencePath)
+    : m_sequencePath(sequencePath),
+      m_velodynePath(sequencePath + "/velodyne")
 {
-    if (!fs::exists(sequencePath))
-    {
-        LOG_ERROR("KITTI sequence path does not exist: " + sequencePath);
+}
+
+KittiDataLoader::~KittiDataLoader()
+{
+    if (!m_odometryThread.joinable())
         return;
+
+    // A registration in progress is finished first
+    {
+        std::lock_guard<std::mutex> lock(m_odometryMutex);
+        m_odometryStop = true;
     }
+    m_odometryWake.notify_one();
+    m_odometryThread.join();
+}
 
-    LOG_INFO("Initializing KITTI loader at: " + sequencePath);
+bool KittiDataLoader::initialize()
+{
+    if (!fs::exists(m_sequencePath))
+    {
+        LOG_ERROR("KITTI sequence path does not exist: " + m_sequencePath);
+        return false;
+    }
+
+    LOG_INFO("Initializing KITTI loader at: " + m_sequencePath);
 
     loadFrameCount();
     loadPosesFile();
+    loadCalibration();
+    scanCameras();
+
+    return m_totalFrames > 0;
 }
 
 // ------------------------------------------------------------
@@ -34,25 +62,23 @@ KittiDataLoader::KittiDataLoader(const std::string& basePath)
 // ------------------------------------------------------------
 void KittiDataLoader::loadFrameCount()
 {
-    velodynePath = sequencePath + "/velodyne";
-
-    if (!fs::exists(velodynePath))
+    if (!fs::exists(m_velodynePath))
     {
-        LOG_ERROR("Velodyne folder not found: " + velodynePath);
+        LOG_ERROR("Velodyne folder not found: " + m_velodynePath);
         return;
     }
 
     int count = 0;
-    for (auto& entry : fs::directory_iterator(velodynePath))
+    for (auto& entry : fs::directory_iterator(m_velodynePath))
     {
         if (entry.path().extension() == ".bin")
             count++;
     }
 
-    totalFrames = count;
+    m_totalFrames = count;
 
-    LOG_INFO("Found " + std::to_string(totalFrames) +
-             " LiDAR frames in: " + velodynePath);
+    LOG_INFO("Found " + std::to_string(m_totalFrames) +
+             " LiDAR frames in: " + m_velodynePath);
 }
 
 // ------------------------------------------------------------
@@ -60,7 +86,7 @@ void KittiDataLoader::loadFrameCount()
 // ------------------------------------------------------------
 void KittiDataLoader::loadPosesFile()
 {
-    std::string posesFile = sequencePath + "/poses.txt";
+    std::string posesFile = m_sequencePath + "/poses.txt";
     if (!fs::exists(posesFile))
     {
         LOG_WARN("No poses.txt found at: " + posesFile);
@@ -68,9 +94,188 @@ void KittiDataLoader::loadPosesFile()
     }
 
     PoseLoader loader;
-    poses = loader.loadAllPoses(posesFile);
+    if (!loader.loadPoseFile(posesFile))
+        return;
+
+    m_poses = loader.getPoses();
+    LOG_INFO("Loaded " + std::to_string(m_poses.size()) + " poses from poses.txt");
+}
+
+// ------------------------------------------------------------
+// Load LiDAR → camera extrinsics (calib.txt, "Tr:" line)
+// ------------------------------------------------------------
+void KittiDataLoader::loadCalibration()
+{
+    std::string calibFile = m_sequencePath + "/calib.txt";
+    std::ifstream file(calibFile);
+    if (!file.is_open())
+        return;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.rfind("Tr:", 0) != 0)
+            continue;
+
+        std::stringstream ss(line.substr(3));
+        glm::mat4 M(1.0f);
+
+        // Row-major 3x4; glm is column-major (M[col][row])
+        for (int row = 0; row < 3; row++)
+            for (int col = 0; col < 4; col++)
+                ss >> M[col][row];
+
+        if (ss.fail())
+        {
+            LOG_WARN("Malformed Tr in: " + calibFile);
+            return;
+        }
+
+        m_veloToCam = M;
+        m_hasCalibration = true;
+        LOG_INFO("Loaded LiDAR extrinsics from calib.txt");
+        return;
+    }
+}
+
+// ------------------------------------------------------------
+// Camera folders (image_0 .. image_3)
+// ------------------------------------------------------------
+void KittiDataLoader::scanCameras()
+{
+    std::string present;
+    for (int camera = 0; camera < 4; camera++)
+    {
+        m_hasCamera[camera] = fs::is_directory(m_sequencePath + "/image_" + std::to_string(camera));
+        if (m_hasCamera[camera])
+            present += " image_" + std::to_string(camera);
+    }
+
+    LOG_INFO("Camera folders:" + (present.empty() ? std::string(" none") : present));
+}
+
+// ------------------------------------------------------------
+// Odometry fallback
+// ------------------------------------------------------------
+void KittiDataLoader::enableOdometryFallback(const IcpOdometry::Params& params)
+{
+    if (!m_poses.empty() || m_odometry)
+        return; // ground truth available, or already estimating
+
+    m_odometry = std::make_unique<IcpOdometry>(params);
+    m_odometryThread = std::thread(&KittiDataLoader::odometryLoop, this);
+    LOG_INFO("No ground-truth poses: estimating poses with ICP odometry.");
+}
+
+void KittiDataLoader::onScanLoaded(int frameID, const PointCloud& cloud)
+{
+    if (!m_odometry)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_odometryMutex);
+
+        // Lowering the target on a seek back ends a catch-up run
+        m_odometryTarget = frameID;
 
-    LOG_INFO("Loaded " + std::to_string(poses.size()) + " poses from poses.txt");
+        if (frameID >= m_registered)
+        {
+            // A free slot (or one already registered)...
+            HandedScan* slot = nullptr;
+            bool present = false;
+            for (HandedScan& scan : m_handedScans)
+            {
+                present = present || scan.frame == frameID;
+                if (scan.frame < m_registered)
+                    slot = &scan;
+            }
+
+            // ...else the one registered last, if this frame is needed
+            // sooner; otherwise the stage reads the scan itself
+            if (!slot)
+            {
+                for (HandedScan& scan : m_handedScans)
+                {
+                    if (scan.frame > frameID && (!slot || scan.frame > slot->frame))
+                        slot = &scan;
+                }
+            }
+
+            if (slot && !present)
+            {
+                slot->frame = frameID;
+                slot->cloud.getPoints().assign(cloud.getPoints().begin(), cloud.getPoints().end());
+            }
+        }
+    }
+    m_odometryWake.notify_one();
+}
+
+void KittiDataLoader::odometryLoop()
+{
+    Profiler::setThreadName("odometry");
+
+    std::unique_lock<std::mutex> lock(m_odometryMutex);
+    while (true)
+    {
+        // Checked before every registration: a catch-up run ends as
+        // soon as its frames are no longer wanted
+        const int next = m_registered;
+        m_odometryWake.wait(lock, [&]()
+        {
+            return m_odometryStop || next <= std::max(m_odometryTarget, m_waitTarget);
+        });
+        if (m_odometryStop)
+            break;
+
+        bool handed = false;
+        for (HandedScan& scan : m_handedScans)
+        {
+            if (scan.frame == next)
+            {
+                m_odometryScan.getPoints().swap(scan.cloud.getPoints());
+                handed = true;
+            }
+            if (scan.frame <= next)
+                scan.frame = -1;
+        }
+        lock.unlock();
+
+        {
+            PROFILE_SCOPE("KittiDataLoader::registerScan");
+
+            if (!handed)
+                loadPointCloudInto(next, m_odometryScan);
+            m_odometry->addScan(m_odometryScan);
+            publishPoses();
+        }
+
+        lock.lock();
+        m_registered = m_odometry->getPoseCount();
+    }
+}
+
+void KittiDataLoader::publishPoses()
+{
+    // Expressed in the camera-0 frame like poses.txt when calib.txt
+    // is available
+    const glm::mat4 camToVelo = glm::inverse(m_veloToCam);
+    {
+        std::lock_guard<std::mutex> lock(m_knownPosesMutex);
+        for (int i = static_cast<int>(m_knownPoses.size()); i < m_odometry->getPoseCount(); ++i)
+        {
+            const glm::mat4& veloPose = m_odometry->getPoses()[i];
+            m_knownPoses.push_back(m_hasCalibration ? m_veloToCam * veloPose * camToVelo : veloPose);
+        }
+    }
+    m_posesPublished.notify_all();
+}
+
+void KittiDataLoader::getKnownPoses(int first, std::vector<glm::mat4>& out) const
+{
+    std::lock_guard<std::mutex> lock(m_knownPosesMutex);
+    for (int i = std::max(0, first); i < static_cast<int>(m_knownPoses.size()); ++i)
+        out.push_back(m_knownPoses[i]);
 }
 
 // ------------------------------------------------------------
@@ -78,18 +283,29 @@ void KittiDataLoader::loadPosesFile()
 // ------------------------------------------------------------
 PointCloud KittiDataLoader::loadPointCloud(int frameID)
 {
-    if (frameID < 0 || frameID >= totalFrames)
+    PROFILE_SCOPE("KittiDataLoader::loadPointCloud");
+
+    PointCloud cloud;
+    loadPointCloudInto(frameID, cloud);
+    return cloud;
+}
+
+bool KittiDataLoader::loadPointCloudInto(int frameID, PointCloud& cloud)
+{
+    PROFILE_SCOPE("KittiDataLoader::loadPointCloudInto");
+
+    if (frameID < 0 || frameID >= m_totalFrames)
     {
         LOG_ERROR("Invalid frameID: " + std::to_string(frameID));
-        return PointCloud();
+        cloud.clear();
+        return false;
     }
 
-    std::stringstream ss;
-    ss << std::setw(6) << std::setfill('0') << frameID;
-    std::string file = velodynePath + "/" + ss.str() + ".bin";
+    char name[16];
+    std::snprintf(name, sizeof(name), "/%06d.bin", frameID);
 
     PointCloudParser parser;
-    return parser.parse(file);
+    return parser.parseInto(m_velodynePath + name, cloud);
 }
 
 // ------------------------------------------------------------
@@ -101,21 +317,27 @@ bool KittiDataLoader::loadImage(
     int& height,
     std::vector<unsigned char>& data)
 {
-    std::string imageFolder = sequencePath + "/image_2";
+    return loadCameraImage(frameID, 2, width, height, data);
+}
 
-    if (!fs::exists(imageFolder))
-    {
-        LOG_ERROR("image_2 folder not found: " + imageFolder);
-        return false;
-    }
+bool KittiDataLoader::loadCameraImage(
+    int frameID,
+    int camera,
+    int& width,
+    int& height,
+    std::vector<unsigned char>& data)
+{
+    PROFILE_SCOPE("KittiDataLoader::loadCameraImage");
 
-    std::stringstream ss;
-    ss << std::setw(6) << std::setfill('0') << frameID;
+    // Called for several cameras at once: only reads loader state
+    if (camera < 0 || camera >= 4 || !m_hasCamera[camera])
+        return false;
 
-    std::string imageFile = imageFolder + "/" + ss.str() + ".png";
+    char name[32];
+    std::snprintf(name, sizeof(name), "/image_%d/%06d.png", camera, frameID);
 
     ImageLoader loader;
-    return loader.loadImage(imageFile, width, height, data);
+    return loader.loadImage(m_sequencePath + name, width, height, data);
 }
 
 // ------------------------------------------------------------
@@ -123,24 +345,46 @@ bool KittiDataLoader::loadImage(
 // ------------------------------------------------------------
 glm::mat4 KittiDataLoader::loadPose(int frameID)
 {
-    if (frameID < 0 || frameID >= static_cast<int>(poses.size()))
+    PROFILE_SCOPE("KittiDataLoader::loadPose");
+
+    if (m_odometry && frameID >= 0 && frameID < m_totalFrames)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_odometryMutex);
+            m_waitTarget = std::max(m_waitTarget, frameID);
+        }
+        m_odometryWake.notify_one();
+
+        std::unique_lock<std::mutex> lock(m_knownPosesMutex);
+        m_posesPublished.wait(lock, [&]() { return frameID < static_cast<int>(m_knownPoses.size()); });
+        return m_knownPoses[frameID];
+    }
+
+    if (frameID < 0 || frameID >= static_cast<int>(m_poses.size()))
     {
         LOG_WARN("Pose not available for frame: " + std::to_string(frameID));
         return glm::mat4(1.0f);
     }
 
-    return poses[frameID];
+    return m_poses[frameID];
 }
 
-// ------------------------------------------------------------
-// Accessors
-// ------------------------------------------------------------
-int KittiDataLoader::getTotalFrames() const
+bool KittiDataLoader::tryGetPose(int frameID, glm::mat4& pose)
 {
-    return totalFrames;
-}
+    if (frameID < 0)
+        return false;
 
-std::string KittiDataLoader::getSequencePath() const
-{
-    return sequencePath;
+    if (!m_poses.empty())
+    {
+        if (frameID >= static_cast<int>(m_poses.size()))
+            return false;
+        pose = m_poses[frameID];
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(m_knownPosesMutex);
+    if (frameID >= static_cast<int>(m_knownPoses.size()))
+        return false;
+    pose = m_knownPoses[frameID];
+    return true;
 }
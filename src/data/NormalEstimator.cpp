@@ -0,0 +1,188 @@
+#include "NormalEstimator.h"
+#include "PointCloud.h"
+#include "core/JobSystem.h"
+#include "utils/MathUtils.h"
+
+#include <algorithm>
+#include <cmath>
+
+NormalEstimator::NormalEstimator()
+    : m_params()
+{
+}
+
+NormalEstimator::NormalEstimator(const Params& params)
+    : m_params(params)
+{
+}
+
+// ------------------------------------------------------------
+// Project points into the spherical range image
+// ------------------------------------------------------------
+void NormalEstimator::buildRangeImage(const PointCloud& cloud)
+{
+    const auto& pts = cloud.getPoints();
+    const int rows = m_params.rows;
+    const int cols = m_params.cols;
+
+    const float fovUp   = glm::radians(m_params.fovUpDeg);
+    const float fovDown = glm::radians(m_params.fovDownDeg);
+    const float fov     = fovUp - fovDown;
+    const float pi      = 3.14159265f;
+
+    m_pixelToPoint.assign(static_cast<size_t>(rows) * cols, -1);
+    m_pixelRange.assign(static_cast<size_t>(rows) * cols, 0.0f);
+    m_pointToPixel.resize(pts.size());
+
+    for (size_t i = 0; i < pts.size(); ++i)
+    {
+        const auto& p = pts[i];
+        float r2 = p.x * p.x + p.y * p.y + p.z * p.z;
+        if (r2 < 1e-6f)
+        {
+            m_pointToPixel[i] = -1;
+            continue;
+        }
+
+        float r     = std::sqrt(r2);
+        float yaw   = std::atan2(p.y, p.x);
+        float pitch = std::asin(p.z / r);
+
+        int u = static_cast<int>(0.5f * (1.0f - yaw / pi) * cols);
+        int v = static_cast<int>((1.0f - (pitch - fovDown) / fov) * rows);
+        u = MathUtils::clamp(u, 0, cols - 1);
+        v = MathUtils::clamp(v, 0, rows - 1);
+
+        int pixel = v * cols + u;
+        m_pointToPixel[i] = pixel;
+
+        int& owner = m_pixelToPoint[pixel];
+        if (owner < 0 || r2 < m_pixelRange[pixel])
+        {
+            owner = static_cast<int>(i);
+            m_pixelRange[pixel] = r2;
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// PCA normal for every occupied pixel in [rowBegin, rowEnd)
+// ------------------------------------------------------------
+void NormalEstimator::estimateRows(const PointCloud& cloud, int rowBegin, int rowEnd)
+{
+    const auto& pts = cloud.getPoints();
+    const int rows = m_params.rows;
+    const int cols = m_params.cols;
+    const int w    = m_params.windowRadius;
+    const float maxD2 = m_params.maxNeighborDist * m_params.maxNeighborDist;
+
+    for (int v = rowBegin; v < rowEnd; ++v)
+    {
+        for (int u = 0; u < cols; ++u)
+        {
+            const int pixel = v * cols + u;
+            const int centreIdx = m_pixelToPoint[pixel];
+            m_pixelNormals[pixel] = glm::vec3(0.0f);
+            if (centreIdx < 0)
+                continue;
+
+            const auto& c = pts[centreIdx];
+            const glm::vec3 centre(c.x, c.y, c.z);
+
+            // Accumulate first and second moments relative to the centre
+            // point for numerical stability.
+            glm::vec3 sum(0.0f);
+            float sxx = 0, sxy = 0, sxz = 0, syy = 0, syz = 0, szz = 0;
+            int count = 0;
+
+            for (int dv = -w; dv <= w; ++dv)
+            {
+                int vv = v + dv;
+                if (vv < 0 || vv >= rows)
+                    continue;
+
+                for (int du = -w; du <= w; ++du)
+                {
+                    // azimuth wraps around
+                    int uu = (u + du + cols) % cols;
+                    int idx = m_pixelToPoint[vv * cols + uu];
+                    if (idx < 0)
+                        continue;
+
+                    const auto& q = pts[idx];
+                    glm::vec3 d(q.x - centre.x, q.y - centre.y, q.z - centre.z);
+                    if (glm::dot(d, d) > maxD2)
+                        continue;
+
+                    sum += d;
+                    sxx += d.x * d.x; sxy += d.x * d.y; sxz += d.x * d.z;
+                    syy += d.y * d.y; syz += d.y * d.z; szz += d.z * d.z;
+                    ++count;
+                }
+            }
+
+            if (count < m_params.minNeighbors)
+                continue;
+
+            const float inv = 1.0f / static_cast<float>(count);
+            const glm::vec3 mean = sum * inv;
+
+            glm::mat3 cov;
+            cov[0][0] = sxx * inv - mean.x * mean.x;
+            cov[1][1] = syy * inv - mean.y * mean.y;
+            cov[2][2] = szz * inv - mean.z * mean.z;
+            cov[1][0] = cov[0][1] = sxy * inv - mean.x * mean.y;
+            cov[2][0] = cov[0][2] = sxz * inv - mean.x * mean.z;
+            cov[2][1] = cov[1][2] = syz * inv - mean.y * mean.z;
+
+            glm::vec3 n = MathUtils::smallestEigenvector(cov);
+
+            // Orient towards the sensor at the origin
+            if (glm::dot(n, centre) > 0.0f)
+                n = -n;
+
+            m_pixelNormals[pixel] = n;
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// Public API
+// ------------------------------------------------------------
+void NormalEstimator::estimate(const PointCloud& cloud, std::vector<glm::vec3>& outNormals)
+{
+    const size_t n = cloud.size();
+    outNormals.assign(n, glm::vec3(0.0f));
+    if (n == 0)
+        return;
+
+    buildRangeImage(cloud);
+    m_pixelNormals.resize(m_pixelToPoint.size());
+
+    // Rows are independent once the range image is built
+    JobSystem::instance().parallelFor(0, static_cast<size_t>(m_params.rows), 4,
+        [this, &cloud](size_t begin, size_t end)
+        {
+            estimateRows(cloud, static_cast<int>(begin), static_cast<int>(end));
+        });
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        int pixel = m_pointToPixel[i];
+        if (pixel >= 0)
+            outNormals[i] = m_pixelNormals[pixel];
+    }
+}
+
+void NormalEstimator::estimatePacked(const PointCloud& cloud, std::vector<uint32_t>& outPacked)
+{
+    estimate(cloud, m_normalScratch);
+
+    outPacked.resize(m_normalScratch.size());
+    for (size_t i = 0; i < m_normalScratch.size(); ++i)
+    {
+        const glm::vec3& nrm = m_normalScratch[i];
+        bool valid = (nrm.x != 0.0f || nrm.y != 0.0f || nrm.z != 0.0f);
+        outPacked[i] = MathUtils::packSnorm1010102(nrm, valid ? 1 : 0);
+    }
+}
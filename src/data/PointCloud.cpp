@@ -1,68 +1,21 @@
 #include "PointCloud.h"
 
-PointCloud::PointCloud()
-{
-}
-
-PointCloud::PointCloud(const std::vector<Point3D>& pts)
-    : m_points(pts)
-{
-}
-
-size_t PointCloud::size() const
-{
-    return m_points.size();
-}
-
-bool PointCloud::empty() const
-{
-    return m_points.empty();
-}
-
-const std::vector<PointCloud::Point3D>& PointCloud::points() const
-{
-    return m_points;
-}
-
-std::vector<PointCloud::Point3D>& PointCloud::points()
-{
-    return m_points;
-}
-
-void PointCloud::clear()
-{
-    m_points.clear();
-}
-
-void PointCloud::reserve(size_t n)
-{
-    m_points.reserve(n);
-}
-
-void PointCloud::addPoint(const Point3D& p)
-{
-    m_points.push_back(p);
-}
-
-void PointCloud::addPoint(float x, float y, float z,
-                          float r, float g, float b, float a)
-{
-    Point3D p;
-    p.position = glm::vec3(x, y, z);
-    p.color = glm::vec4(r, g, b, a);
-    m_points.push_back(p);
-}
-
 glm::vec3 PointCloud::computeCentroid() const
 {
     if (m_points.empty())
         return glm::vec3(0.0f);
 
-    glm::vec3 sum(0.0f);
+    // Accumulate in double: float sums drift over ~100k points
+    double sx = 0.0, sy = 0.0, sz = 0.0;
     for (const auto& p : m_points)
-        sum += p.position;
+    {
+        sx += p.x;
+        sy += p.y;
+        sz += p.z;
+    }
 
-    return sum / static_cast<float>(m_points.size());
+    const double inv = 1.0 / static_cast<double>(m_points.size());
+    return glm::vec3(static_cast<float>(sx * inv), static_cast<float>(sy * inv), static_cast<float>(sz * inv));
 }
 
 glm::vec3 PointCloud::minBounds() const
@@ -70,9 +23,9 @@ glm::vec3 PointCloud::minBounds() const
     if (m_points.empty())
         return glm::vec3(0.0f);
 
-    glm::vec3 minV = m_points[0].position;
+    glm::vec3 minV(m_points[0].x, m_points[0].y, m_points[0].z);
     for (const auto& p : m_points)
-        minV = glm::min(minV, p.position);
+        minV = glm::min(minV, glm::vec3(p.x, p.y, p.z));
 
     return minV;
 }
@@ -82,9 +35,9 @@ glm::vec3 PointCloud::maxBounds() const
     if (m_points.empty())
         return glm::vec3(0.0f);
 
-    glm::vec3 maxV = m_points[0].position;
+    glm::vec3 maxV(m_points[0].x, m_points[0].y, m_points[0].z);
     for (const auto& p : m_points)
-        maxV = glm::max(maxV, p.position);
+        maxV = glm::max(maxV, glm::vec3(p.x, p.y, p.z));
 
     return maxV;
 }
@@ -1,56 +1,51 @@
 #include "PointCloudParser.h"
+#include "core/Profiler.h"
 #include "PointCloud.h"
-#include <fstream>
+#include <cstdio>
 #include <iostream>
 
-PointCloud PointCloudParser::loadKittiBin(const std::string& filePath, bool applyDefaultColor)
+PointCloud PointCloudParser::parseBinFile(const std::string& filePath)
 {
+    PROFILE_SCOPE("PointCloudParser::parseBinFile");
+
     PointCloud cloud;
+    parseInto(filePath, cloud);
+    return cloud;
+}
+
+bool PointCloudParser::parseInto(const std::string& filePath, PointCloud& cloud)
+{
+    PROFILE_SCOPE("PointCloudParser::parseInto");
+
+    static_assert(sizeof(PointCloud::Point) == 4 * sizeof(float),
+                  "KITTI .bin records map 1:1 onto PointCloud::Point");
+
+    auto& points = cloud.getPoints();
+    points.clear();
 
-    std::ifstream file(filePath, std::ios::binary);
-    if (!file.is_open())
+    std::FILE* file = std::fopen(filePath.c_str(), "rb");
+    if (!file)
     {
         std::cerr << "[PointCloudParser] Failed to open .bin file: " << filePath << std::endl;
-        return cloud; // empty
+        return false;
     }
 
-    // KITTI velodyne binary format:
-    // Each point = float x, y, z, intensity   → 4 floats = 16 bytes
-    // File contains N such points.
-    struct KittiPointRaw
-    {
-        float x, y, z, intensity;
-    };
-
-    KittiPointRaw point;
+    std::fseek(file, 0, SEEK_END);
+    long fileSize = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
 
-    // Pre-allocate approximate size (optional performance improvement)
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    size_t pointCount = fileSize / sizeof(KittiPointRaw);
-    file.seekg(0, std::ios::beg);
+    size_t pointCount = fileSize > 0 ? static_cast<size_t>(fileSize) / sizeof(PointCloud::Point) : 0;
 
-    cloud.reserve(pointCount);
+    // resize() within existing capacity does not allocate
+    points.resize(pointCount);
+    size_t read = pointCount > 0 ? std::fread(points.data(), sizeof(PointCloud::Point), pointCount, file) : 0;
+    std::fclose(file);
 
-    while (file.read(reinterpret_cast<char*>(&point), sizeof(KittiPointRaw)))
+    if (read != pointCount)
     {
-        // KITTI intensity range is [0, 1] in practice but may exceed slightly
-        float I = point.intensity;
-
-        // Color encoding — grayscale mapping from intensity
-        float r = I;
-        float g = I;
-        float b = I;
-        float a = 1.0f;
-
-        if (!applyDefaultColor)
-        {
-            // Keep as grayscale; advanced color schemes may be added later
-        }
-
-        cloud.addPoint(point.x, point.y, point.z, r, g, b, a);
+        std::cerr << "[PointCloudParser] Short read on .bin file: " << filePath << std::endl;
+        points.resize(read);
     }
 
-    file.close();
-    return cloud;
+    return read > 0;
 }
@@ -1,68 +1,68 @@
 #include "PoseLoader.h"
+#include "core/Profiler.h"
+#include "utils/Logger.h"
+
 #include <fstream>
 #include <sstream>
-#include <iostream>
 
-PoseLoader::PoseLoader(const std::string& poseFile)
+bool PoseLoader::loadPoseFile(const std::string& filepath)
 {
-    loadAllPoses(poseFile);
-}
+    PROFILE_SCOPE("PoseLoader::loadPoseFile");
 
-bool PoseLoader::loadAllPoses(const std::string& poseFile)
-{
-    std::ifstream file(poseFile);
+    m_poses.clear();
+
+    std::ifstream file(filepath);
     if (!file.is_open())
     {
-        std::cerr << "[PoseLoader] Failed to open pose file: " << poseFile << std::endl;
+        LOG_ERROR("Failed to open pose file: " + filepath);
         return false;
     }
 
+    // KITTI format: each line holds 12 floats (3x4 matrix, row-major)
     std::string line;
-    poses.clear();
-
-    // KITTI format:
-    // each line contains 12 floats (3x4 matrix)
-    // we convert it to a full 4x4 matrix
+    std::vector<float> values;
+    values.reserve(12);
     while (std::getline(file, line))
     {
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+
         std::stringstream ss(line);
-        glm::mat4 M(1.0f);
+        values.clear();
+        float v = 0.0f;
+        while (values.size() < 12 && ss >> v)
+            values.push_back(v);
 
-        // Read 12 elements row-major for 3x4 matrix
-        for (int row = 0; row < 3; row++)
+        if (values.size() != 12)
         {
-            for (int col = 0; col < 4; col++)
-            {
-                float v;
-                ss >> v;
-                M[row][col] = v;
-            }
+            LOG_ERROR("Malformed pose on line " + std::to_string(m_poses.size() + 1) + " of " + filepath);
+            m_poses.clear();
+            return false;
         }
 
-        // Complete last row: [0 0 0 1]
-        M[3][0] = 0.0f;
-        M[3][1] = 0.0f;
-        M[3][2] = 0.0f;
-        M[3][3] = 1.0f;
-
-        poses.push_back(M);
+        m_poses.push_back(convertToMat4(values));
     }
 
-    file.close();
     return true;
 }
 
 glm::mat4 PoseLoader::getPose(int frameID) const
 {
-    if (frameID < 0 || frameID >= static_cast<int>(poses.size()))
+    if (frameID < 0 || frameID >= static_cast<int>(m_poses.size()))
     {
-        std::cerr << "[PoseLoader] Requested invalid pose index: " << frameID << std::endl;
+        LOG_WARN("Requested invalid pose index: " + std::to_string(frameID));
         return glm::mat4(1.0f);
     }
-    return poses[frameID];
+    return m_poses[frameID];
 }
 
-int PoseLoader::getTotalPoses() const
+glm::mat4 PoseLoader::convertToMat4(const std::vector<float>& values) const
 {
-    return static_cast<int>(poses.size());
+    // Row-major 3x4; glm is column-major (M[col][row]). The last row
+    // stays [0 0 0 1].
+    glm::mat4 M(1.0f);
+    for (int row = 0; row < 3; row++)
+        for (int col = 0; col < 4; col++)
+            M[col][row] = values[row * 4 + col];
+    return M;
 }
@@ -0,0 +1,144 @@
+#include "ScanDeskewer.h"
+#include "PointCloud.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/gtc/quaternion.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define KITTI_DESKEW_SSE 1
+#endif
+
+namespace
+{
+    constexpr float kPi = 3.14159265358979f;
+
+    // Branch-light atan2 approximation (|error| < 1e-5 rad), far
+    // below the angular width of one time bin.
+    inline float fastAtan2(float y, float x)
+    {
+        float ax = std::fabs(x);
+        float ay = std::fabs(y);
+        float mn = std::min(ax, ay);
+        float mx = std::max(ax, ay);
+        float a  = mn / (mx + 1e-30f);
+        float s  = a * a;
+        float r  = ((-0.0464964749f * s + 0.15931422f) * s - 0.327622764f) * s * a + a;
+        if (ay > ax) r = 0.5f * kPi - r;
+        if (x < 0.0f) r = kPi - r;
+        return (y < 0.0f) ? -r : r;
+    }
+}
+
+ScanDeskewer::ScanDeskewer()
+    : m_params()
+{
+}
+
+ScanDeskewer::ScanDeskewer(const Params& params)
+    : m_params(params)
+{
+}
+
+glm::mat4 ScanDeskewer::motionFromPoses(const glm::mat4& poseA,
+                                        const glm::mat4& poseB,
+                                        const glm::mat4& veloToCam)
+{
+    glm::mat4 deltaCam = glm::inverse(poseA) * poseB;
+    return glm::inverse(veloToCam) * deltaCam * veloToCam;
+}
+
+// ------------------------------------------------------------
+// One correction transform per time bin
+// ------------------------------------------------------------
+void ScanDeskewer::buildBinTransforms(const glm::mat4& scanMotion)
+{
+    const int bins = std::max(1, m_params.timeBins);
+    m_binTransforms.resize(static_cast<size_t>(bins) * 16);
+
+    const glm::quat qFull = glm::quat_cast(glm::mat3(scanMotion));
+    const glm::quat qIdentity(1.0f, 0.0f, 0.0f, 0.0f);
+    const glm::vec3 tFull(scanMotion[3]);
+
+    for (int k = 0; k < bins; ++k)
+    {
+        // Offset of the bin centre from the reference time (t = 0.5)
+        float s = (k + 0.5f) / bins - 0.5f;
+        float a = std::fabs(s);
+
+        glm::mat4 M = glm::mat4_cast(glm::slerp(qIdentity, qFull, a));
+        M[3] = glm::vec4(tFull * a, 1.0f);
+
+        // Points captured before the reference time move backwards
+        if (s < 0.0f)
+            M = glm::inverse(M);
+
+        float* dst = &m_binTransforms[static_cast<size_t>(k) * 16];
+        for (int c = 0; c < 4; ++c)
+        {
+            dst[c * 4 + 0] = M[c][0];
+            dst[c * 4 + 1] = M[c][1];
+            dst[c * 4 + 2] = M[c][2];
+            dst[c * 4 + 3] = 0.0f;   // keeps the intensity lane untouched
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// Batch correction
+// ------------------------------------------------------------
+void ScanDeskewer::deskew(PointCloud& cloud, const glm::mat4& scanMotion)
+{
+    auto& pts = cloud.getPoints();
+    if (pts.empty())
+        return;
+
+    buildBinTransforms(scanMotion);
+
+    const int   bins     = std::max(1, m_params.timeBins);
+    const float binScale = bins / (2.0f * kPi);
+    const float dirSign  = m_params.clockwise ? -1.0f : 1.0f;
+    const float* table   = m_binTransforms.data();
+
+    static_assert(sizeof(PointCloud::Point) == 4 * sizeof(float),
+                  "deskew assumes packed x,y,z,intensity points");
+
+#ifdef KITTI_DESKEW_SSE
+    const __m128 maskXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const __m128 maskW   = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+#endif
+
+    for (auto& p : pts)
+    {
+        // clockwise: t = (pi - yaw) / 2pi; counter-clockwise: (yaw + pi) / 2pi
+        float yaw = fastAtan2(p.y, p.x);
+        int bin = static_cast<int>((kPi + dirSign * yaw) * binScale);
+        bin = std::min(std::max(bin, 0), bins - 1);
+
+        const float* m = table + static_cast<size_t>(bin) * 16;
+
+#ifdef KITTI_DESKEW_SSE
+        float* pf = &p.x;
+        __m128 v  = _mm_loadu_ps(pf);
+        __m128 vx = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 vy = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 vz = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+
+        __m128 r = _mm_loadu_ps(m + 12);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 0), vx));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 4), vy));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_loadu_ps(m + 8), vz));
+
+        // xyz from the transform, intensity from the input
+        r = _mm_or_ps(_mm_and_ps(r, maskXYZ), _mm_and_ps(v, maskW));
+        _mm_storeu_ps(pf, r);
+#else
+        float x = p.x, y = p.y, z = p.z;
+        p.x = m[0] * x + m[4] * y + m[8]  * z + m[12];
+        p.y = m[1] * x + m[5] * y + m[9]  * z + m[13];
+        p.z = m[2] * x + m[6] * y + m[10] * z + m[14];
+#endif
+    }
+}
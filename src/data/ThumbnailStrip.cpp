@@ -0,0 +1,189 @@
+#include "ThumbnailStrip.h"
+#include "IKittiLoader.h"
+#include "core/MemoryBudget.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+
+ThumbnailStrip::ThumbnailStrip(IKittiLoader& loader, const Params& params)
+    : m_loader(loader),
+      m_params(params)
+{
+    m_params.maxThumbnails = std::max(1, m_params.maxThumbnails);
+    m_params.previewPoints = std::max(1, m_params.previewPoints);
+    m_params.imageWidth    = std::max(1, m_params.imageWidth);
+    if (m_params.cameras.size() > static_cast<size_t>(FrameData::kMaxImages))
+        m_params.cameras.resize(FrameData::kMaxImages);
+
+    const int frames = loader.getTotalFrames();
+    if (frames > 0)
+    {
+        const int stride = (frames + m_params.maxThumbnails - 1) / m_params.maxThumbnails;
+        const int count  = (frames + stride - 1) / stride;
+
+        m_slots.resize(count);
+        for (int i = 0; i < count; ++i)
+            m_slots[i].thumbnail.frame = i * stride;
+
+        // Coarse to fine: every 2^k-th slot before the ones in between
+        std::vector<bool> queued(count, false);
+        m_order.reserve(count);
+        int step = 1;
+        while (step * 2 <= count)
+            step *= 2;
+        for (; step >= 1; step /= 2)
+        {
+            for (int i = 0; i < count; i += step)
+            {
+                if (!queued[i])
+                {
+                    queued[i] = true;
+                    m_order.push_back(i);
+                }
+            }
+        }
+    }
+
+    m_memoryId = MemoryBudget::instance().add("thumbnails", MemoryBudget::Host);
+}
+
+ThumbnailStrip::~ThumbnailStrip()
+{
+    // The job writes into the slots and scratch buffers
+    if (m_job.valid())
+        JobSystem::instance().wait(m_job);
+
+    MemoryBudget::instance().remove(m_memoryId);
+}
+
+void ThumbnailStrip::update()
+{
+    if (m_job.valid())
+    {
+        if (!m_job.isDone())
+            return;
+
+        const Thumbnail& done = m_slots[m_jobSlot].thumbnail;
+        m_bytes += done.cloud.getPoints().capacity() * sizeof(PointCloud::Point);
+        for (int i = 0; i < done.imageCount; ++i)
+            m_bytes += done.images[i].pixels.capacity();
+        MemoryBudget::instance().setUsage(m_memoryId, m_bytes);
+
+        m_slots[m_jobSlot].ready = true;
+        m_readyCount++;
+        m_job = JobSystem::TaskHandle();
+        m_jobSlot = -1;
+    }
+
+    if (m_nextInOrder >= static_cast<int>(m_order.size()))
+        return;
+
+    // The job owns the slot until update() publishes it
+    m_jobSlot = m_order[m_nextInOrder++];
+    const int slot = m_jobSlot;
+    m_job = JobSystem::instance().submit([this, slot]() { generate(slot); });
+}
+
+const ThumbnailStrip::Thumbnail* ThumbnailStrip::nearest(int frame) const
+{
+    if (m_slots.empty())
+        return nullptr;
+
+    // Closest slot first, then alternate outwards
+    const int stride = m_slots.size() > 1 ? m_slots[1].thumbnail.frame : 1;
+    const int count  = getSlotCount();
+    const int centre = std::min(std::max(0, (frame + stride / 2) / stride), count - 1);
+
+    for (int distance = 0; distance < count; ++distance)
+    {
+        const int below = centre - distance;
+        const int above = centre + distance;
+        if (below >= 0 && m_slots[below].ready)
+            return &m_slots[below].thumbnail;
+        if (above < count && m_slots[above].ready)
+            return &m_slots[above].thumbnail;
+        if (below < 0 && above >= count)
+            break;
+    }
+    return nullptr;
+}
+
+// ------------------------------------------------------------
+// Generation job
+// ------------------------------------------------------------
+void ThumbnailStrip::generate(int slot)
+{
+    PROFILE_SCOPE("ThumbnailStrip::generate");
+
+    Thumbnail& thumbnail = m_slots[slot].thumbnail;
+
+    // Scan: every n-th point keeps the whole sweep, just sparser
+    thumbnail.cloud.clear();
+    if (m_loader.loadPointCloudInto(thumbnail.frame, m_scratchCloud))
+    {
+        const std::vector<PointCloud::Point>& points = m_scratchCloud.getPoints();
+        const size_t step = std::max<size_t>(1, (points.size() + m_params.previewPoints - 1) /
+                                                static_cast<size_t>(m_params.previewPoints));
+
+        std::vector<PointCloud::Point>& preview = thumbnail.cloud.getPoints();
+        preview.reserve((points.size() + step - 1) / step);
+        for (size_t i = 0; i < points.size(); i += step)
+            preview.push_back(points[i]);
+    }
+
+    // Images: decoded at full size, then box-filtered down
+    thumbnail.imageCount = static_cast<int>(m_params.cameras.size());
+    for (int i = 0; i < thumbnail.imageCount; ++i)
+    {
+        CameraImage& image = thumbnail.images[i];
+        image.camera = m_params.cameras[i];
+
+        int width = 0, height = 0;
+        if (m_loader.loadCameraImage(thumbnail.frame, image.camera, width, height, m_scratchImage))
+            downscale(m_scratchImage, width, height, m_params.imageWidth, image);
+    }
+}
+
+void ThumbnailStrip::downscale(const std::vector<unsigned char>& rgb, int width, int height,
+                               int targetWidth, CameraImage& out)
+{
+    if (width <= 0 || height <= 0 || rgb.size() < static_cast<size_t>(width) * height * 3)
+        return;
+
+    const int w = std::min(targetWidth, width);
+    const int h = std::max(1, (height * w + width / 2) / width);
+
+    out.width  = w;
+    out.height = h;
+    out.pixels.resize(static_cast<size_t>(w) * h * 3);
+
+    for (int y = 0; y < h; ++y)
+    {
+        const int y0 = y * height / h;
+        const int y1 = std::max(y0 + 1, (y + 1) * height / h);
+
+        for (int x = 0; x < w; ++x)
+        {
+            const int x0 = x * width / w;
+            const int x1 = std::max(x0 + 1, (x + 1) * width / w);
+
+            unsigned sum[3] = { 0, 0, 0 };
+            for (int sy = y0; sy < y1; ++sy)
+            {
+                const unsigned char* row = &rgb[(static_cast<size_t>(sy) * width + x0) * 3];
+                for (int sx = x0; sx < x1; ++sx, row += 3)
+                {
+                    sum[0] += row[0];
+                    sum[1] += row[1];
+                    sum[2] += row[2];
+                }
+            }
+
+            const unsigned area = static_cast<unsigned>((x1 - x0) * (y1 - y0));
+            unsigned char* dst = &out.pixels[(static_cast<size_t>(y) * w + x) * 3];
+            dst[0] = static_cast<unsigned char>(sum[0] / area);
+            dst[1] = static_cast<unsigned char>(sum[1] / area);
+            dst[2] = static_cast<unsigned char>(sum[2] / area);
+        }
+    }
+}
@@ -1,40 +1,151 @@
 #include "Trajectory.h"
-#include <iostream>
+#include "core/Profiler.h"
+#include "utils/Logger.h"
 
-Trajectory::Trajectory()
+#include <algorithm>
+#include <string>
+#include <utility>
+
+void Trajectory::build(std::vector<glm::vec3> positions)
 {
-    points.reserve(20000); // typical KITTI sequence size
+    PROFILE_SCOPE("Trajectory::build");
+
+    m_points = std::move(positions);
+    m_simplified = false;
+    m_drawPoints.clear();
+    m_drawFrames.clear();
+    m_currentFrame = -1;
+    m_generation++;
+
+    if (m_params.simplifyMinPoints > 0 && m_points.size() >= m_params.simplifyMinPoints)
+        simplify();
 }
 
-void Trajectory::addPoint(const glm::vec3& p)
+bool Trajectory::append(int frame, const glm::vec3& p)
 {
-    points.push_back(p);
+    const int first = static_cast<int>(m_points.size());
+    if (frame < first)
+        return false;
+
+    // Skipped frames: on the line from the last position (or at p
+    // when the path starts late)
+    const glm::vec3 from = m_points.empty() ? p : m_points.back();
+    const int steps = frame - first + 1;
+    for (int i = first; i <= frame; ++i)
+    {
+        const float t = static_cast<float>(i - first + 1) / static_cast<float>(steps);
+        const glm::vec3 q = i == frame ? p : from + (p - from) * t;
+        m_points.push_back(q);
+
+        // Appended poses are all drawn; only the built part is simplified
+        if (m_simplified)
+        {
+            m_drawPoints.push_back(q);
+            m_drawFrames.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return true;
 }
 
 void Trajectory::clear()
 {
-    points.clear();
+    m_points.clear();
+    m_simplified = false;
+    m_drawPoints.clear();
+    m_drawFrames.clear();
+    m_currentFrame = -1;
+    m_generation++;
 }
 
-const std::vector<glm::vec3>& Trajectory::getPoints() const
+size_t Trajectory::drawCountUpTo(int frame) const
 {
-    return points;
-}
+    if (frame < 0)
+        return 0;
 
-glm::vec3 Trajectory::getLastPoint() const
-{
-    if (points.empty())
-        return glm::vec3(0.0f);
+    if (!m_simplified)
+        return std::min(m_points.size(), static_cast<size_t>(frame) + 1);
 
-    return points.back();
+    return static_cast<size_t>(std::upper_bound(m_drawFrames.begin(), m_drawFrames.end(),
+                                                static_cast<uint32_t>(frame)) -
+                               m_drawFrames.begin());
 }
 
-bool Trajectory::isEmpty() const
+// ------------------------------------------------------------
+// Douglas–Peucker
+// ------------------------------------------------------------
+// Keeps the point farthest from the segment between two kept
+// points while it is more than the tolerance off, splitting there.
+// Iterative (an explicit stack), as long straight stretches make
+// the recursion as deep as the path is long. Distances are to the
+// segment, not the infinite line, so loops that return to their
+// start (closed drives, stops and reversals) keep their shape.
+// ------------------------------------------------------------
+void Trajectory::simplify()
 {
-    return points.empty();
-}
+    PROFILE_SCOPE("Trajectory::simplify");
 
-size_t Trajectory::size() const
-{
-    return points.size();
+    const size_t count = m_points.size();
+    if (count < 3)
+        return;
+
+    const float toleranceSq = m_params.simplifyTolerance * m_params.simplifyTolerance;
+
+    std::vector<bool> keep(count, false);
+    keep.front() = true;
+    keep.back()  = true;
+
+    std::vector<std::pair<size_t, size_t>> spans;
+    spans.emplace_back(0, count - 1);
+
+    while (!spans.empty())
+    {
+        const size_t first = spans.back().first;
+        const size_t last  = spans.back().second;
+        spans.pop_back();
+
+        if (last <= first + 1)
+            continue;
+
+        const glm::vec3 a  = m_points[first];
+        const glm::vec3 ab = m_points[last] - a;
+        const float lengthSq = glm::dot(ab, ab);
+
+        float  farthestSq = 0.0f;
+        size_t farthest   = first;
+        for (size_t i = first + 1; i < last; ++i)
+        {
+            const glm::vec3 ap = m_points[i] - a;
+            const float t = lengthSq > 0.0f ? glm::clamp(glm::dot(ap, ab) / lengthSq, 0.0f, 1.0f) : 0.0f;
+            const glm::vec3 offset = ap - ab * t;
+
+            const float distanceSq = glm::dot(offset, offset);
+            if (distanceSq > farthestSq)
+            {
+                farthestSq = distanceSq;
+                farthest   = i;
+            }
+        }
+
+        if (farthestSq > toleranceSq)
+        {
+            keep[farthest] = true;
+            spans.emplace_back(first, farthest);
+            spans.emplace_back(farthest, last);
+        }
+    }
+
+    const size_t kept = static_cast<size_t>(std::count(keep.begin(), keep.end(), true));
+    m_drawPoints.reserve(kept);
+    m_drawFrames.reserve(kept);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!keep[i])
+            continue;
+        m_drawPoints.push_back(m_points[i]);
+        m_drawFrames.push_back(static_cast<uint32_t>(i));
+    }
+    m_simplified = true;
+
+    Logger::info("Trajectory: " + std::to_string(count) + " poses simplified to " +
+                 std::to_string(kept) + " vertices");
 }
@@ -4,15 +4,25 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/rotate_vector.hpp>
 
+#include <cmath>
+
 Camera::Camera(const glm::vec3& position, const glm::vec3& target)
     : m_position(position),
-      m_target(target),
       m_up(0.0f, 1.0f, 0.0f),
       m_yaw(-90.0f),
       m_pitch(0.0f),
       m_sensitivity(0.1f),
       m_zoom(45.0f)
 {
+    // Start looking at the target (yaw/pitch of the direction to it)
+    const glm::vec3 toTarget = target - position;
+    if (glm::length(toTarget) > 1e-6f)
+    {
+        const glm::vec3 dir = glm::normalize(toTarget);
+        m_yaw   = glm::degrees(std::atan2(dir.z, dir.x));
+        m_pitch = MathUtils::clamp(glm::degrees(std::asin(dir.y)), -89.0f, 89.0f);
+    }
+
     updateDirectionVectors();
 }
 
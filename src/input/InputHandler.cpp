@@ -1,8 +1,12 @@
 #include "InputHandler.h"
+#include "Window.h"
+#include "Camera.h"
 #include "Logger.h"
 
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
+
 InputHandler::InputHandler()
     : m_window(nullptr),
       m_camera(nullptr),
@@ -24,24 +28,156 @@ void InputHandler::attachCamera(Camera* camera)
     m_camera = camera;
 }
 
+void InputHandler::enableEventQueue(Window& window)
+{
+    m_eventDriven = true;
+    m_events.reserve(256);
+
+    // Starting position; afterwards only cursor events update it
+    if (m_window)
+        glfwGetCursorPos(m_window, &m_cursorX, &m_cursorY);
+
+    Window::EventCallbacks callbacks;
+    callbacks.onKey = [this](int key, int action)
+    {
+        m_events.push_back({ InputEvent::Type::Key, key, action });
+    };
+    callbacks.onMouseButton = [this](int button, int action)
+    {
+        m_events.push_back({ InputEvent::Type::MouseButton, button, action });
+    };
+    callbacks.onCursorPos = [this](double x, double y)
+    {
+        m_events.push_back({ InputEvent::Type::CursorPos, 0, 0, x, y });
+    };
+    callbacks.onScroll = [this](double dx, double dy)
+    {
+        m_events.push_back({ InputEvent::Type::Scroll, 0, 0, dx, dy });
+    };
+    window.setEventCallbacks(callbacks);
+}
+
+// ------------------------------------------------------------
+// Event queue → input state
+// ------------------------------------------------------------
+void InputHandler::drainEvents()
+{
+    m_keysPressed.clear();
+    m_hadActivity = !m_events.empty();
+
+    for (const InputEvent& e : m_events)
+    {
+        switch (e.type)
+        {
+        case InputEvent::Type::Key:
+            if (e.action == GLFW_PRESS)
+            {
+                m_keysDown.insert(e.code);
+                m_keysPressed.insert(e.code);
+            }
+            else if (e.action == GLFW_RELEASE)
+            {
+                m_keysDown.erase(e.code);
+            }
+            break;
+
+        case InputEvent::Type::MouseButton:
+            if (e.action == GLFW_PRESS)
+            {
+                m_buttonsDown.insert(e.code);
+
+                // Keep the exact click position, even if the cursor
+                // moved again before this update
+                if (e.code == GLFW_MOUSE_BUTTON_LEFT)
+                {
+                    m_clickPending = true;
+                    m_clickX = m_cursorX;
+                    m_clickY = m_cursorY;
+                }
+            }
+            else if (e.action == GLFW_RELEASE)
+            {
+                m_buttonsDown.erase(e.code);
+            }
+            break;
+
+        case InputEvent::Type::CursorPos:
+            m_cursorX = e.x;
+            m_cursorY = e.y;
+            break;
+
+        case InputEvent::Type::Scroll:
+            break;
+        }
+    }
+
+    m_events.clear();
+}
+
+bool InputHandler::isKeyDown(int key) const
+{
+    if (m_eventDriven)
+        return m_keysDown.count(key) != 0;
+    return glfwGetKey(m_window, key) == GLFW_PRESS;
+}
+
+bool InputHandler::isMouseButtonDown(int button) const
+{
+    if (m_eventDriven)
+        return m_buttonsDown.count(button) != 0;
+    return glfwGetMouseButton(m_window, button) == GLFW_PRESS;
+}
+
+void InputHandler::getCursor(double& x, double& y) const
+{
+    if (m_eventDriven)
+    {
+        x = m_cursorX;
+        y = m_cursorY;
+        return;
+    }
+    glfwGetCursorPos(m_window, &x, &y);
+}
+
+bool InputHandler::wantsContinuousUpdate() const
+{
+    static const int kHeldKeys[] = {
+        GLFW_KEY_W, GLFW_KEY_A, GLFW_KEY_S, GLFW_KEY_D, GLFW_KEY_Q, GLFW_KEY_E,
+        GLFW_KEY_LEFT, GLFW_KEY_RIGHT
+    };
+
+    for (int key : kHeldKeys)
+    {
+        if (isKeyDown(key))
+            return true;
+    }
+    return false;
+}
+
 void InputHandler::update()
 {
     if (!m_window)
         return;
 
+    if (m_eventDriven)
+        drainEvents();
+
     handleKeyboard();
     handleMouseMovement();
     handleMouseScroll();
+    handleMouseButtons();
+    handleTimeline();
+    handlePlaybackKeys();
 
     // Reset navigation flags every frame
     m_nextFrame = false;
     m_prevFrame = false;
 
     // Frame navigation
-    if (glfwGetKey(m_window, GLFW_KEY_RIGHT) == GLFW_PRESS)
+    if (isKeyDown(GLFW_KEY_RIGHT))
         m_nextFrame = true;
 
-    if (glfwGetKey(m_window, GLFW_KEY_LEFT) == GLFW_PRESS)
+    if (isKeyDown(GLFW_KEY_LEFT))
         m_prevFrame = true;
 }
 
@@ -52,22 +188,22 @@ void InputHandler::handleKeyboard()
 
     float speed = 0.3f;
 
-    if (glfwGetKey(m_window, GLFW_KEY_W) == GLFW_PRESS)
+    if (isKeyDown(GLFW_KEY_W))
         m_camera->moveForward(speed);
 
-    if (glfwGetKey(m_window, GLFW_KEY_S) == GLFW_PRESS)
+    if (isKeyDown(GLFW_KEY_S))
         m_camera->moveBackward(speed);
 
-    if (glfwGetKey(m_window, GLFW_KEY_A) == GLFW_PRESS)
+    if (isKeyDown(GLFW_KEY_A))
         m_camera->moveLeft(speed);
 
-    if (glfwGetKey(m_window, GLFW_KEY_D) == GLFW_PRESS)
+    if (isKeyDown(GLFW_KEY_D))
         m_camera->moveRight(speed);
 
-    if (glfwGetKey(m_window, GLFW_KEY_Q) == GLFW_PRESS)
+    if (isKeyDown(GLFW_KEY_Q))
         m_camera->moveDown(speed);
 
-    if (glfwGetKey(m_window, GLFW_KEY_E) == GLFW_PRESS)
+    if (isKeyDown(GLFW_KEY_E))
         m_camera->moveUp(speed);
 }
 
@@ -77,7 +213,7 @@ void InputHandler::handleMouseMovement()
         return;
 
     double xpos, ypos;
-    glfwGetCursorPos(m_window, &xpos, &ypos);
+    getCursor(xpos, ypos);
 
     if (m_firstMouse)
     {
@@ -94,7 +230,7 @@ void InputHandler::handleMouseMovement()
     m_lastY = ypos;
 
     // Rotate camera
-    if (glfwGetMouseButton(m_window, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS) 
+    if (isMouseButtonDown(GLFW_MOUSE_BUTTON_RIGHT))
     {
         m_camera->rotate(offsetX, offsetY);
     }
@@ -105,12 +241,78 @@ void InputHandler::handleMouseScroll()
 
 }
 
-bool InputHandler::nextFrameRequested() const
+void InputHandler::handleMouseButtons()
+{
+    if (m_eventDriven)
+    {
+        // Every press event is a pick, even if released before update()
+        m_pickRequested = m_clickPending;
+        m_pickX = m_clickX;
+        m_pickY = m_clickY;
+        m_clickPending = false;
+        return;
+    }
+
+    bool leftDown = glfwGetMouseButton(m_window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+
+    // Fire once per press, not while held
+    m_pickRequested = leftDown && !m_leftWasDown;
+    m_leftWasDown = leftDown;
+
+    if (m_pickRequested)
+        glfwGetCursorPos(m_window, &m_pickX, &m_pickY);
+}
+
+void InputHandler::handleTimeline()
+{
+    if (m_timelineHeight <= 0.0f)
+        return;
+
+    int width = 0, height = 0;
+    glfwGetWindowSize(m_window, &width, &height);
+    if (width <= 0)
+        return;
+
+    double x = 0.0, y = 0.0;
+    if (m_pickRequested && m_pickY >= height - m_timelineHeight)
+    {
+        // Press on the timeline: a scrub, not a pick. The press
+        // position counts even if the button is already up again.
+        m_pickRequested = false;
+        m_scrubbing = true;
+        x = m_pickX;
+    }
+    else if (m_scrubbing && isMouseButtonDown(GLFW_MOUSE_BUTTON_LEFT))
+    {
+        getCursor(x, y);
+    }
+    else
+    {
+        m_scrubbing = false;
+        return;
+    }
+
+    m_scrubPosition = static_cast<float>(std::min(std::max(x / width, 0.0), 1.0));
+}
+
+bool InputHandler::keyPressed(int key)
 {
-    return m_nextFrame;
+    if (m_eventDriven)
+        return m_keysPressed.count(key) != 0;
+
+    bool down = glfwGetKey(m_window, key) == GLFW_PRESS;
+    bool& wasDown = m_keyState[key];
+    bool pressed = down && !wasDown;
+    wasDown = down;
+    return pressed;
 }
 
-bool InputHandler::prevFrameRequested() const
+void InputHandler::handlePlaybackKeys()
 {
-    return m_prevFrame;
+    m_playToggle = keyPressed(GLFW_KEY_SPACE);
+    m_speedUp    = keyPressed(GLFW_KEY_RIGHT_BRACKET);
+    m_speedDown  = keyPressed(GLFW_KEY_LEFT_BRACKET);
+    m_traceToggle = keyPressed(GLFW_KEY_F9);
+    m_overlayToggle = keyPressed(GLFW_KEY_F1);
+    m_sequenceSwitch = keyPressed(GLFW_KEY_TAB);
 }
@@ -1,7 +1,90 @@
-#include <iostream>
+#include "core/Application.h"
+#include "core/ReplayBenchmark.h"
 
-int main()
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Usage:
+//   kitti_visualizer [--config settings.ini] [--sequence dir] [--set key=value]...
+//   kitti_visualizer --benchmark [--frames n] [--first n] [--warmup n]
+//                    [--seeks] [--json out.json] [--label text] [other options above]
+//
+// --benchmark replays the sequence headless (hidden window, no vsync)
+// and reports FPS, frame latency percentiles, peak RSS and I/O.
+// --seeks jumps to random frames instead (seek-to-display latency).
+
+namespace
 {
-    std::cout << "KITTI Visualizer Build Test OK!" << std::endl;
+    void printUsage(const char* program)
+    {
+        std::fprintf(stderr,
+            "usage: %s [--config file] [--sequence dir] [--set key=value]...\n"
+            "       %s --benchmark [--frames n] [--first n] [--warmup n] [--seeks] [--json file] [--label text]\n",
+            program, program);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string configPath = "resources/config/settings.ini";
+
+    Application app;
+    bool benchmark = false;
+    ReplayBenchmark::Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--benchmark") == 0)
+        {
+            benchmark = true;
+            continue;
+        }
+        if (std::strcmp(arg, "--seeks") == 0)
+        {
+            options.seeks = true;
+            continue;
+        }
+
+        if (!value)
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+        ++i;
+
+        if (std::strcmp(arg, "--config") == 0)        configPath = value;
+        else if (std::strcmp(arg, "--sequence") == 0) app.overrideSetting("sequence_path", value);
+        else if (std::strcmp(arg, "--frames") == 0)   options.frames = std::atoi(value);
+        else if (std::strcmp(arg, "--first") == 0)    options.firstFrame = std::atoi(value);
+        else if (std::strcmp(arg, "--warmup") == 0)   options.warmupFrames = std::atoi(value);
+        else if (std::strcmp(arg, "--json") == 0)     options.jsonPath = value;
+        else if (std::strcmp(arg, "--label") == 0)    options.label = value;
+        else if (std::strcmp(arg, "--set") == 0 && std::strchr(value, '='))
+        {
+            const char* eq = std::strchr(value, '=');
+            app.overrideSetting(std::string(value, eq), eq + 1);
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (benchmark)
+        app.enableBenchmark(options);
+
+    if (!app.initialize(configPath))
+        return 1;
+
+    if (benchmark)
+        return app.runBenchmark() ? 0 : 1;
+
+    app.run();
     return 0;
 }
@@ -0,0 +1,387 @@
+// src/rendering/GlDevice.cpp
+// OpenGL backend of GpuDevice (one GL call per device call).
+
+#include "GlDevice.h"
+
+#include <glad/glad.h>
+
+namespace
+{
+    GLenum toGl(GpuBufferTarget target)
+    {
+        return target == GpuBufferTarget::Index ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+    }
+
+    GLenum toGl(GpuBufferUsage usage)
+    {
+        return usage == GpuBufferUsage::Static ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW;
+    }
+
+    GLenum toGl(GpuAttribType type)
+    {
+        return type == GpuAttribType::Int2101010Rev ? GL_INT_2_10_10_10_REV : GL_FLOAT;
+    }
+
+    GLenum toGl(GpuPrimitive primitive)
+    {
+        switch (primitive)
+        {
+            case GpuPrimitive::Points:    return GL_POINTS;
+            case GpuPrimitive::Lines:     return GL_LINES;
+            case GpuPrimitive::LineStrip: return GL_LINE_STRIP;
+            case GpuPrimitive::Triangles: return GL_TRIANGLES;
+        }
+        return GL_POINTS;
+    }
+
+    GLenum toGl(GpuCapability capability)
+    {
+        switch (capability)
+        {
+            case GpuCapability::DepthTest:        return GL_DEPTH_TEST;
+            case GpuCapability::Blend:            return GL_BLEND;
+            case GpuCapability::ProgramPointSize: return GL_PROGRAM_POINT_SIZE;
+        }
+        return GL_DEPTH_TEST;
+    }
+}
+
+std::string GlDevice::describe() const
+{
+    const GLubyte* renderer = glGetString(GL_RENDERER);
+    const GLubyte* version  = glGetString(GL_VERSION);
+
+    std::string text = renderer ? reinterpret_cast<const char*>(renderer) : "unknown";
+    text += " | ";
+    text += version ? reinterpret_cast<const char*>(version) : "unknown";
+    return text;
+}
+
+// ---- Buffers / vertex arrays ----
+
+GpuDevice::Handle GlDevice::createBuffer()
+{
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    return buffer;
+}
+
+void GlDevice::destroyBuffer(Handle buffer)
+{
+    glDeleteBuffers(1, &buffer);
+}
+
+GpuDevice::Handle GlDevice::createVertexArray()
+{
+    GLuint vao = 0;
+    glGenVertexArrays(1, &vao);
+    return vao;
+}
+
+void GlDevice::destroyVertexArray(Handle vao)
+{
+    glDeleteVertexArrays(1, &vao);
+}
+
+void GlDevice::bindVertexArray(Handle vao)
+{
+    glBindVertexArray(vao);
+}
+
+void GlDevice::bindBuffer(GpuBufferTarget target, Handle buffer)
+{
+    glBindBuffer(toGl(target), buffer);
+}
+
+void GlDevice::bufferData(GpuBufferTarget target, size_t bytes, const void* data, GpuBufferUsage usage)
+{
+    glBufferData(toGl(target), static_cast<GLsizeiptr>(bytes), data, toGl(usage));
+}
+
+void GlDevice::bufferSubData(GpuBufferTarget target, size_t offset, size_t bytes, const void* data)
+{
+    glBufferSubData(toGl(target), static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), data);
+}
+
+size_t GlDevice::bufferSize(GpuBufferTarget target)
+{
+    GLint size = 0;
+    glGetBufferParameteriv(toGl(target), GL_BUFFER_SIZE, &size);
+    return size > 0 ? static_cast<size_t>(size) : 0;
+}
+
+void GlDevice::vertexAttribPointer(unsigned int index, int components, GpuAttribType type,
+                                   bool normalized, int stride, size_t offset)
+{
+    glVertexAttribPointer(index, components, toGl(type), normalized ? GL_TRUE : GL_FALSE,
+                          stride, reinterpret_cast<const void*>(offset));
+}
+
+void GlDevice::setVertexAttribEnabled(unsigned int index, bool enabled)
+{
+    if (enabled)
+        glEnableVertexAttribArray(index);
+    else
+        glDisableVertexAttribArray(index);
+}
+
+void GlDevice::vertexAttribConstant(unsigned int index, float x, float y, float z, float w)
+{
+    glVertexAttrib4f(index, x, y, z, w);
+}
+
+// ---- Textures ----
+
+GpuDevice::Handle GlDevice::createTexture2D()
+{
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // 1x1 white so a sampler has something before the first upload
+    unsigned char white[3] = { 255, 255, 255 };
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, white);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+void GlDevice::destroyTexture(Handle texture)
+{
+    glDeleteTextures(1, &texture);
+}
+
+void GlDevice::uploadTexture2D(Handle texture, int width, int height,
+                               const unsigned char* rgb, bool generateMipmaps)
+{
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, rgb);
+    if (generateMipmaps)
+        glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GlDevice::bindTexture2D(unsigned int unit, Handle texture)
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+GpuDevice::Handle GlDevice::createTextureArray()
+{
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    return texture;
+}
+
+void GlDevice::allocateTextureArray(Handle texture, int width, int height, int layers)
+{
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGB8, width, height, layers, 0,
+                 GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void GlDevice::uploadTextureLayer(Handle texture, int layer, int width, int height,
+                                  const unsigned char* rgb)
+{
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1,
+                    GL_RGB, GL_UNSIGNED_BYTE, rgb);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void GlDevice::bindTextureArray(unsigned int unit, Handle texture)
+{
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+}
+
+// ---- Programs ----
+
+unsigned int GlDevice::compileShader(unsigned int type, const std::string& src, std::string& errorLog)
+{
+    unsigned int id = glCreateShader(type);
+    const char* srcc = src.c_str();
+    glShaderSource(id, 1, &srcc, nullptr);
+    glCompileShader(id);
+
+    int success = 0;
+    glGetShaderiv(id, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        int logLen = 0;
+        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &logLen);
+        std::string info(logLen, ' ');
+        glGetShaderInfoLog(id, logLen, nullptr, &info[0]);
+        errorLog = "compile error: " + info;
+        glDeleteShader(id);
+        return 0;
+    }
+    return id;
+}
+
+GpuDevice::Handle GlDevice::createProgram(const std::string& vertexSrc, const std::string& fragmentSrc,
+                                          std::string& errorLog)
+{
+    unsigned int vs = compileShader(GL_VERTEX_SHADER, vertexSrc, errorLog);
+    if (vs == 0) return 0;
+    unsigned int fs = compileShader(GL_FRAGMENT_SHADER, fragmentSrc, errorLog);
+    if (fs == 0) { glDeleteShader(vs); return 0; }
+
+    unsigned int prog = glCreateProgram();
+    glAttachShader(prog, vs);
+    glAttachShader(prog, fs);
+    glLinkProgram(prog);
+
+    int success = 0;
+    glGetProgramiv(prog, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        int logLen = 0;
+        glGetProgramiv(prog, GL_INFO_LOG_LENGTH, &logLen);
+        std::string info(logLen, ' ');
+        glGetProgramInfoLog(prog, logLen, nullptr, &info[0]);
+        errorLog = "link error: " + info;
+        glDeleteProgram(prog);
+        glDeleteShader(vs);
+        glDeleteShader(fs);
+        return 0;
+    }
+
+    // Shaders are not needed once linked
+    glDetachShader(prog, vs);
+    glDetachShader(prog, fs);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    return prog;
+}
+
+void GlDevice::destroyProgram(Handle program)
+{
+    glDeleteProgram(program);
+}
+
+void GlDevice::useProgram(Handle program)
+{
+    glUseProgram(program);
+}
+
+int GlDevice::uniformLocation(Handle program, const char* name)
+{
+    return glGetUniformLocation(program, name);
+}
+
+void GlDevice::setUniformMat4(int location, const float* values)
+{
+    glUniformMatrix4fv(location, 1, GL_FALSE, values);
+}
+
+void GlDevice::setUniformVec3(int location, const float* values)
+{
+    glUniform3fv(location, 1, values);
+}
+
+void GlDevice::setUniformFloat(int location, float value)
+{
+    glUniform1f(location, value);
+}
+
+void GlDevice::setUniformInt(int location, int value)
+{
+    glUniform1i(location, value);
+}
+
+// ---- Fixed-function state ----
+
+void GlDevice::setEnabled(GpuCapability capability, bool enabled)
+{
+    if (enabled)
+        glEnable(toGl(capability));
+    else
+        glDisable(toGl(capability));
+}
+
+void GlDevice::setAlphaBlendFunc()
+{
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void GlDevice::setLineWidth(float width)
+{
+    glLineWidth(width);
+}
+
+void GlDevice::clear(float r, float g, float b, float a)
+{
+    glClearColor(r, g, b, a);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+// ---- Draws ----
+
+void GlDevice::drawArrays(GpuPrimitive primitive, int first, int count)
+{
+    glDrawArrays(toGl(primitive), first, count);
+}
+
+void GlDevice::drawIndexed(GpuPrimitive primitive, int count)
+{
+    glDrawElements(toGl(primitive), count, GL_UNSIGNED_INT, nullptr);
+}
+
+// ---- Timer queries ----
+
+GpuDevice::Handle GlDevice::createTimerQuery()
+{
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    return query;
+}
+
+void GlDevice::destroyTimerQuery(Handle query)
+{
+    glDeleteQueries(1, &query);
+}
+
+void GlDevice::beginTimerQuery(Handle query)
+{
+    glBeginQuery(GL_TIME_ELAPSED, query);
+}
+
+void GlDevice::endTimerQuery()
+{
+    glEndQuery(GL_TIME_ELAPSED);
+}
+
+bool GlDevice::timerQueryResult(Handle query, uint64_t& outNs)
+{
+    GLint available = 0;
+    glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return false;
+
+    GLuint64 ns = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+    outNs = ns;
+    return true;
+}
+
+void GlDevice::finish()
+{
+    glFinish();
+}
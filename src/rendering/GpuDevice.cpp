@@ -0,0 +1,27 @@
+// src/rendering/GpuDevice.cpp
+// Process-wide current GpuDevice.
+
+#include "GpuDevice.h"
+
+#include <cassert>
+
+namespace
+{
+    GpuDevice* g_current = nullptr;
+}
+
+GpuDevice& GpuDevice::current()
+{
+    assert(g_current && "GpuDevice::setCurrent() must be called before rendering");
+    return *g_current;
+}
+
+void GpuDevice::setCurrent(GpuDevice* device)
+{
+    g_current = device;
+}
+
+bool GpuDevice::hasCurrent()
+{
+    return g_current != nullptr;
+}
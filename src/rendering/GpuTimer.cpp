@@ -0,0 +1,93 @@
+// src/rendering/GpuTimer.cpp
+// Non-blocking GL_TIME_ELAPSED query ring.
+
+#include "GpuTimer.h"
+#include "GpuDevice.h"
+#include "core/Profiler.h"
+
+GpuTimer::~GpuTimer()
+{
+    if (!m_isInitialized)
+        return;
+
+    GpuDevice& device = GpuDevice::current();
+    for (unsigned int query : m_queries)
+        device.destroyTimerQuery(query);
+}
+
+void GpuTimer::initialize()
+{
+    if (m_isInitialized)
+        return;
+
+    GpuDevice& device = GpuDevice::current();
+    for (unsigned int& query : m_queries)
+        query = device.createTimerQuery();
+    m_isInitialized = true;
+}
+
+void GpuTimer::begin()
+{
+    if (!m_isInitialized || m_active)
+        return;
+
+    // Ring full: the oldest query is still in flight, skip this frame
+    // rather than reusing it (which would block on its result).
+    collect();
+    if (m_pending[m_writeIndex])
+        return;
+
+    m_submitNs[m_writeIndex] = Profiler::nowNs();
+    GpuDevice::current().beginTimerQuery(m_queries[m_writeIndex]);
+    m_active = true;
+}
+
+void GpuTimer::end()
+{
+    if (!m_active)
+        return;
+
+    GpuDevice::current().endTimerQuery();
+    m_pending[m_writeIndex] = true;
+    m_writeIndex = (m_writeIndex + 1) % kRingSize;
+    m_active = false;
+}
+
+void GpuTimer::collect()
+{
+    GpuDevice& device = GpuDevice::current();
+
+    // Oldest first, so m_lastMs ends on the newest available result
+    for (int i = 0; i < kRingSize; ++i)
+    {
+        int idx = (m_writeIndex + i) % kRingSize;
+        if (!m_pending[idx])
+            continue;
+
+        uint64_t ns = 0;
+        if (!device.timerQueryResult(m_queries[idx], ns))
+            break;   // later queries cannot be ready before this one
+
+        m_pending[idx] = false;
+
+        m_lastMs = static_cast<double>(ns) * 1e-6;
+        m_lastSubmitNs = m_submitNs[idx];
+        m_hasNew = true;
+    }
+}
+
+bool GpuTimer::latestMs(double& outMs, uint64_t* submitNs)
+{
+    if (!m_isInitialized)
+        return false;
+
+    collect();
+    if (!m_hasNew)
+        return false;
+
+    outMs = m_lastMs;
+    if (submitNs)
+        *submitNs = m_lastSubmitNs;
+    m_hasNew = false;
+    return true;
+}
@@ -5,12 +5,16 @@
 // (file uploaded in this workspace — you can open it for UI/shader requirements)
 
 #include "ImageRenderer.h"
+#include "GpuDevice.h"
+#include "data/CameraImage.h"
+#include "core/MemoryBudget.h"
+#include "core/Profiler.h"
 #include "utils/FileUtils.h"
 #include "utils/Logger.h"
 
-#include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -26,14 +30,20 @@ ImageRenderer::ImageRenderer()
 
 ImageRenderer::~ImageRenderer()
 {
+    MemoryBudget::instance().remove(m_memoryId);
+
+    if (!m_textureID && !m_vao)
+        return;
+
+    GpuDevice& device = GpuDevice::current();
     if (m_textureID)
-        glDeleteTextures(1, &m_textureID);
+        device.destroyTexture(m_textureID);
     if (m_vbo)
-        glDeleteBuffers(1, &m_vbo);
+        device.destroyBuffer(m_vbo);
     if (m_ebo)
-        glDeleteBuffers(1, &m_ebo);
+        device.destroyBuffer(m_ebo);
     if (m_vao)
-        glDeleteVertexArrays(1, &m_vao);
+        device.destroyVertexArray(m_vao);
 }
 
 void ImageRenderer::initialize()
@@ -58,60 +68,117 @@ void ImageRenderer::initialize()
 
     createQuad();
     createTexture();
+    m_memoryId = MemoryBudget::instance().add("gpu_image", MemoryBudget::Gpu);
 
     Logger::info("ImageRenderer: initialized.");
 }
 
-bool ImageRenderer::updateImageTexture(int width, int height, const std::vector<unsigned char>& data)
+size_t ImageRenderer::updateImages(const CameraImage* images, int count)
 {
-    if (width <= 0 || height <= 0 || data.empty())
+    PROFILE_SCOPE("ImageRenderer::updateImages");
+
+    count = std::min(count, kMaxImages);
+
+    // Storage fits the largest image; KITTI cameras share one size,
+    // so after the first frame this never reallocates
+    int width = 0, height = 0;
+    for (int i = 0; i < count; ++i)
     {
-        Logger::warn("ImageRenderer::updateImageTexture - invalid image data.");
-        return false;
+        if (images[i].valid())
+        {
+            width  = std::max(width, images[i].width);
+            height = std::max(height, images[i].height);
+        }
+    }
+    if (width == 0)
+    {
+        m_imageCount = 0;
+        return 0;
     }
 
     if (m_textureID == 0)
         createTexture();
 
-    glBindTexture(GL_TEXTURE_2D, m_textureID);
-
-    // Upload image data as RGB; if your loader provides 4 channels (RGBA) adjust accordingly
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data.data());
+    GpuDevice& device = GpuDevice::current();
+    if (width > m_arrayWidth || height > m_arrayHeight || count > m_arrayLayers)
+    {
+        m_arrayWidth  = std::max(width, m_arrayWidth);
+        m_arrayHeight = std::max(height, m_arrayHeight);
+        m_arrayLayers = std::max(count, m_arrayLayers);
+        device.allocateTextureArray(m_textureID, m_arrayWidth, m_arrayHeight, m_arrayLayers);
+
+        // RGB8 (drivers may pad to RGBA)
+        MemoryBudget::instance().setUsage(m_memoryId, static_cast<size_t>(m_arrayWidth) * m_arrayHeight * 3 *
+                                                      static_cast<size_t>(m_arrayLayers));
+        LOG_DEBUG("ImageRenderer: texture array " + std::to_string(m_arrayWidth) + "x" +
+                  std::to_string(m_arrayHeight) + " x " + std::to_string(m_arrayLayers));
+    }
 
-    glGenerateMipmap(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    size_t uploaded = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        const CameraImage& image = images[i];
+        m_imageWidth[i]  = image.valid() ? image.width : 0;
+        m_imageHeight[i] = image.valid() ? image.height : 0;
+        if (!image.valid())
+            continue;
+
+        device.uploadTextureLayer(m_textureID, i, image.width, image.height, image.pixels.data());
+        uploaded += image.pixels.size();
+    }
 
+    m_imageCount = count;
     m_hasTexture = true;
-    Logger::info("ImageRenderer: texture updated (" + std::to_string(width) + "x" + std::to_string(height) + ").");
-    return true;
+    return uploaded;
 }
 
 void ImageRenderer::render(const glm::mat4& /*view*/, const glm::mat4& /*projection*/)
 {
-    if (!m_hasTexture)
+    PROFILE_SCOPE("ImageRenderer::render");
+
+    if (!m_hasTexture || m_imageCount == 0)
         return;
 
-    // Render a screen-aligned quad using the image texture.
-    // The shader is expected to sample a 'tex' uniform (sampler2D).
-    m_shader.bind();
+    // Tiles over the quad: 1 full, 2 side by side, 3-4 in a 2x2 grid
+    const int columns = m_imageCount == 1 ? 1 : 2;
+    const int rows    = m_imageCount <= 2 ? 1 : 2;
+    const float tileW = 2.0f / columns;
+    const float tileH = 2.0f / rows;
 
-    // If the shader expects a projection/model/view for positioning, you can set identity.
-    glm::mat4 model = glm::mat4(1.0f);
-    m_shader.setUniformMat4("u_Model", model);
-    m_shader.setUniformMat4("u_View", glm::mat4(1.0f));
-    m_shader.setUniformMat4("u_Projection", glm::mat4(1.0f));
+    m_shader.bind();
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_textureID);
-    m_shader.setUniformInt("u_Texture", 0);
+    GpuDevice& device = GpuDevice::current();
+    device.bindTextureArray(0, m_textureID);
+    m_shader.setUniformInt("u_Images", 0);
 
-    glBindVertexArray(m_vao);
-    // Draw two triangles (6 indices)
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    device.bindVertexArray(m_vao);
+    for (int i = 0; i < m_imageCount; ++i)
+    {
+        if (m_imageWidth[i] == 0)
+            continue;
+
+        // Unit quad → tile rectangle in NDC (tiles fill from the top left)
+        const float centerX = -1.0f + tileW * (static_cast<float>(i % columns) + 0.5f);
+        const float centerY =  1.0f - tileH * (static_cast<float>(i / columns) + 0.5f);
+        glm::mat4 model(1.0f);
+        model[0][0] = tileW * 0.5f;
+        model[1][1] = tileH * 0.5f;
+        model[3][0] = centerX;
+        model[3][1] = centerY;
+        m_shader.setUniformMat4("u_Model", model);
+
+        // Smaller images only cover part of their layer
+        m_shader.setUniformVec3("u_UvScale", glm::vec3(static_cast<float>(m_imageWidth[i]) / m_arrayWidth,
+                                                       static_cast<float>(m_imageHeight[i]) / m_arrayHeight,
+                                                       0.0f));
+        m_shader.setUniformInt("u_Layer", i);
+
+        // Draw two triangles (6 indices)
+        device.drawIndexed(GpuPrimitive::Triangles, 6);
+    }
+    device.bindVertexArray(0);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    device.bindTextureArray(0, 0);
     Shader::unbind();
 }
 
@@ -137,27 +204,28 @@ void ImageRenderer::createQuad()
         2, 3, 0
     };
 
-    glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
-    glGenBuffers(1, &m_ebo);
+    GpuDevice& device = GpuDevice::current();
+    m_vao = device.createVertexArray();
+    m_vbo = device.createBuffer();
+    m_ebo = device.createBuffer();
 
-    glBindVertexArray(m_vao);
+    device.bindVertexArray(m_vao);
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    device.bindBuffer(GpuBufferTarget::Vertex, m_vbo);
+    device.bufferData(GpuBufferTarget::Vertex, sizeof(vertices), vertices, GpuBufferUsage::Static);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    device.bindBuffer(GpuBufferTarget::Index, m_ebo);
+    device.bufferData(GpuBufferTarget::Index, sizeof(indices), indices, GpuBufferUsage::Static);
 
     // position attribute (vec2)
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    device.setVertexAttribEnabled(0, true);
+    device.vertexAttribPointer(0, 2, GpuAttribType::Float, false, 4 * sizeof(float), 0);
 
     // texcoord attribute (vec2)
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    device.setVertexAttribEnabled(1, true);
+    device.vertexAttribPointer(1, 2, GpuAttribType::Float, false, 4 * sizeof(float), 2 * sizeof(float));
 
-    glBindVertexArray(0);
+    device.bindVertexArray(0);
 }
 
 void ImageRenderer::createTexture()
@@ -165,20 +233,7 @@ void ImageRenderer::createTexture()
     if (m_textureID != 0)
         return;
 
-    glGenTextures(1, &m_textureID);
-    glBindTexture(GL_TEXTURE_2D, m_textureID);
-
-    // Default texture parameters — can be tuned via config
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // Allocate a tiny default 1x1 white texture so the shader has something before real image loads
-    unsigned char white[3] = { 255, 255, 255 };
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, white);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    m_hasTexture = true;
+    // Clamp-to-edge, linear; storage is allocated by the first
+    // updateImages(), nothing is drawn before that
+    m_textureID = GpuDevice::current().createTextureArray();
 }
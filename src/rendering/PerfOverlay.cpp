@@ -0,0 +1,223 @@
+// src/rendering/PerfOverlay.cpp
+// ImGui performance dashboard (display only).
+
+#include "PerfOverlay.h"
+#include "core/FrameStats.h"
+#include "core/Profiler.h"
+#include "data/ThumbnailStrip.h"
+#include "utils/Logger.h"
+
+#include <imgui.h>
+#include <imgui_impl_glfw.h>
+#include <imgui_impl_opengl3.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    // Graph scale: at least 0..33 ms, grows with the worst sample
+    float graphMax(const float* values, int count)
+    {
+        float worst = 0.0f;
+        for (int i = 0; i < count; ++i)
+            worst = std::max(worst, values[i]);
+        return std::max(33.3f, worst * 1.1f);
+    }
+
+    float average(const float* values, int count)
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < count; ++i)
+            sum += values[i];
+        return count > 0 ? sum / count : 0.0f;
+    }
+
+    bool endsWith(const char* text, const char* suffix)
+    {
+        const size_t n = std::strlen(text);
+        const size_t m = std::strlen(suffix);
+        return n >= m && std::strcmp(text + n - m, suffix) == 0;
+    }
+}
+
+PerfOverlay::~PerfOverlay()
+{
+    shutdown();
+}
+
+bool PerfOverlay::initialize(GLFWwindow* window)
+{
+    if (m_isInitialized)
+        return true;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;   // no imgui.ini next to the binary
+    io.LogFilename = nullptr;
+
+    ImGui::StyleColorsDark();
+    ImGui::GetStyle().Alpha = 0.9f;
+
+    // No callbacks: the panel is display only
+    if (!ImGui_ImplGlfw_InitForOpenGL(window, false) ||
+        !ImGui_ImplOpenGL3_Init("#version 330"))
+    {
+        Logger::error("PerfOverlay: failed to initialize ImGui backends.");
+        ImGui::DestroyContext();
+        return false;
+    }
+
+    m_isInitialized = true;
+    Logger::info("PerfOverlay: initialized (F1 toggles).");
+    return true;
+}
+
+void PerfOverlay::shutdown()
+{
+    if (!m_isInitialized)
+        return;
+
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplGlfw_Shutdown();
+    ImGui::DestroyContext();
+    m_isInitialized = false;
+}
+
+void PerfOverlay::addSample(float cpuMs, float gpuMs)
+{
+    m_cpuMs[m_historyOffset] = cpuMs;
+    m_gpuMs[m_historyOffset] = gpuMs;
+    m_historyOffset = (m_historyOffset + 1) % kHistory;
+}
+
+void PerfOverlay::render(const FrameStats& stats, const Counters& counters, const Timeline* timeline)
+{
+    if (!m_isInitialized || (!m_visible && !timeline))
+        return;
+
+    PROFILE_SCOPE("PerfOverlay::render");
+
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui_ImplGlfw_NewFrame();
+    ImGui::NewFrame();
+
+    if (m_visible)
+        drawPanel(stats, counters);
+    if (timeline)
+        drawTimeline(*timeline);
+
+    ImGui::Render();
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+}
+
+void PerfOverlay::drawPanel(const FrameStats& stats, const Counters& counters)
+{
+    const ImGuiWindowFlags flags =
+        ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+        ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs;
+
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(0.6f);
+
+    if (ImGui::Begin("Performance", nullptr, flags))
+    {
+        char label[64];
+
+        // ---- frame time history ----
+        const float cpuLast = m_cpuMs[(m_historyOffset + kHistory - 1) % kHistory];
+        const float gpuLast = m_gpuMs[(m_historyOffset + kHistory - 1) % kHistory];
+        const float scale = std::max(graphMax(m_cpuMs, kHistory), graphMax(m_gpuMs, kHistory));
+
+        ImGui::Text("%.1f fps", stats.fps());
+
+        std::snprintf(label, sizeof(label), "CPU %.2f ms (avg %.2f)", cpuLast, average(m_cpuMs, kHistory));
+        ImGui::PlotLines("##cpu", m_cpuMs, kHistory, m_historyOffset, label,
+                         0.0f, scale, ImVec2(260.0f, 50.0f));
+
+        std::snprintf(label, sizeof(label), "GPU %.2f ms (avg %.2f)", gpuLast, average(m_gpuMs, kHistory));
+        ImGui::PlotLines("##gpu", m_gpuMs, kHistory, m_historyOffset, label,
+                         0.0f, scale, ImVec2(260.0f, 50.0f));
+
+        // ---- loader ----
+        ImGui::Separator();
+        const float queueFill = counters.frameBuffers > 0
+            ? static_cast<float>(counters.queuedFrames) / counters.frameBuffers : 0.0f;
+        std::snprintf(label, sizeof(label), "%zu / %zu queued", counters.queuedFrames, counters.frameBuffers);
+        ImGui::ProgressBar(queueFill, ImVec2(260.0f, 0.0f), label);
+        ImGui::Text("Read-ahead hit rate  %5.1f %%", counters.readyHitRate * 100.0);
+        ImGui::Text("Dropped %llu (skipped %llu, discarded %llu)",
+                    static_cast<unsigned long long>(counters.framesSkipped + counters.framesDiscarded),
+                    static_cast<unsigned long long>(counters.framesSkipped),
+                    static_cast<unsigned long long>(counters.framesDiscarded));
+
+        // ---- uploads ----
+        ImGui::Separator();
+        ImGui::Text("Points uploaded  %zu", counters.pointsUploaded);
+        ImGui::Text("Points drawn     %zu", counters.pointsDrawn);
+        ImGui::Text("Uploaded         %.2f MB/frame", counters.bytesUploaded / (1024.0 * 1024.0));
+
+        // ---- per-stage timings (FrameStats, latest values) ----
+        ImGui::Separator();
+        for (const FrameStats::Entry& entry : stats.entries())
+        {
+            if (entry.samples == 0 && entry.last == 0.0)
+                continue;
+
+            if (endsWith(entry.name, "_ms"))
+                ImGui::Text("%-22s %7.2f ms", entry.name, entry.last);
+            else
+                ImGui::Text("%-22s %7.0f", entry.name, entry.last);
+        }
+    }
+    ImGui::End();
+}
+
+void PerfOverlay::drawTimeline(const Timeline& timeline)
+{
+    if (timeline.totalFrames <= 0)
+        return;
+
+    const ImVec2 display = ImGui::GetIO().DisplaySize;
+    const float  top = display.y - timeline.height;
+
+    // Frame → x; the last frame sits at the right edge like the scrub
+    const float last = static_cast<float>(std::max(1, timeline.totalFrames - 1));
+    auto frameX = [&](int frame) { return display.x * (frame / last); };
+
+    // Whole-screen draw list: no window, nothing to click
+    ImDrawList* draw = ImGui::GetForegroundDrawList();
+    draw->AddRectFilled(ImVec2(0.0f, top), display, IM_COL32(20, 20, 24, 170));
+
+    // Thumbnails ready so far (coarse-to-fine, so gaps close evenly)
+    if (timeline.thumbnails)
+    {
+        const ThumbnailStrip& strip = *timeline.thumbnails;
+        for (int slot = 0; slot < strip.getSlotCount(); ++slot)
+        {
+            if (!strip.isSlotReady(slot))
+                continue;
+            const float x = frameX(strip.getSlotFrame(slot));
+            draw->AddLine(ImVec2(x, top + 2.0f), ImVec2(x, top + 6.0f), IM_COL32(120, 160, 220, 200));
+        }
+    }
+
+    // Played part and the handle; amber while a preview stands in
+    const float x = frameX(timeline.frame);
+    const float mid = top + timeline.height * 0.5f;
+    draw->AddRectFilled(ImVec2(0.0f, mid - 2.0f), ImVec2(x, mid + 2.0f), IM_COL32(90, 140, 210, 255));
+    const ImU32 handle = timeline.preview ? IM_COL32(240, 180, 60, 255) : IM_COL32(230, 230, 230, 255);
+    const float halfWidth = timeline.scrubbing ? 5.0f : 3.0f;
+    draw->AddRectFilled(ImVec2(x - halfWidth, top + 4.0f), ImVec2(x + halfWidth, display.y - 4.0f), handle);
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "%d / %d%s", timeline.frame, timeline.totalFrames - 1,
+                  timeline.preview ? "  (preview)" : "");
+    const ImVec2 size = ImGui::CalcTextSize(label);
+    const float labelX = std::min(std::max(x - size.x * 0.5f, 4.0f), display.x - size.x - 4.0f);
+    draw->AddText(ImVec2(labelX, top - size.y - 4.0f), IM_COL32(235, 235, 235, 255), label);
+}
@@ -3,27 +3,39 @@
 // Reference: /mnt/data/OpenGL_Assignment.pdf
 
 #include "PointCloudRenderer.h"
+#include "GpuDevice.h"
 #include "PointCloud.h"
+#include "core/FrameArena.h"
+#include "core/MemoryBudget.h"
+#include "core/Profiler.h"
 #include "utils/FileUtils.h"
 #include "utils/Logger.h"
 
-#include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <vector>
 #include <cstring>
+#include <cmath>
+#include <numeric>
 
 static const std::string PC_VERT_SHADER = "resources/shaders/pointcloud.vert";
 static const std::string PC_FRAG_SHADER = "resources/shaders/pointcloud.frag";
 
 PointCloudRenderer::PointCloudRenderer()
-    : m_vao(0), m_vbo(0), m_pointCount(0), m_isInitialized(false)
+    : m_vao(0), m_vbo(0), m_normalVbo(0), m_pointCount(0), m_normalCount(0),
+      m_isInitialized(false)
 {
 }
 
 PointCloudRenderer::~PointCloudRenderer()
 {
-    if (m_vbo) glDeleteBuffers(1, &m_vbo);
-    if (m_vao) glDeleteVertexArrays(1, &m_vao);
+    MemoryBudget::instance().remove(m_memoryId);
+
+    if (!m_vao && !m_vbo && !m_normalVbo) return;
+
+    GpuDevice& device = GpuDevice::current();
+    if (m_vbo) device.destroyBuffer(m_vbo);
+    if (m_normalVbo) device.destroyBuffer(m_normalVbo);
+    if (m_vao) device.destroyVertexArray(m_vao);
 }
 
 void PointCloudRenderer::initialize()
@@ -46,35 +58,64 @@ void PointCloudRenderer::initialize()
     }
 
     createBuffers();
+    m_memoryId = MemoryBudget::instance().add("gpu_points", MemoryBudget::Gpu,
+                                              [this](std::size_t) { return releaseStaleNormals(); });
     m_isInitialized = true;
     Logger::info("PointCloudRenderer: initialized.");
 }
 
 void PointCloudRenderer::createBuffers()
 {
+    GpuDevice& device = GpuDevice::current();
+
     // VBO stores: float x,y,z,intensity  -> 4 floats per vertex
-    glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
+    m_vao = device.createVertexArray();
+    m_vbo = device.createBuffer();
 
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    device.bindVertexArray(m_vao);
+    device.bindBuffer(GpuBufferTarget::Vertex, m_vbo);
 
-    // Initially allocate a small buffer; will use glBufferData with NULL to allocate and glBufferSubData for updates.
-    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+    // Initially allocate a small buffer; will use bufferData with NULL to allocate and bufferSubData for updates.
+    device.bufferData(GpuBufferTarget::Vertex, 0, nullptr, GpuBufferUsage::Dynamic);
 
     // attribute 0: vec3 position
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(0));
+    device.setVertexAttribEnabled(0, true);
+    device.vertexAttribPointer(0, 3, GpuAttribType::Float, false, 4 * sizeof(float), 0);
 
     // attribute 1: float intensity
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(3 * sizeof(float)));
+    device.setVertexAttribEnabled(1, true);
+    device.vertexAttribPointer(1, 1, GpuAttribType::Float, false, 4 * sizeof(float), 3 * sizeof(float));
+
+    // attribute 2: packed normal (10:10:10:2 signed normalized) in its own VBO,
+    // so intensity-only frames never pay for it.
+    m_normalVbo = device.createBuffer();
+    device.bindBuffer(GpuBufferTarget::Vertex, m_normalVbo);
+    device.bufferData(GpuBufferTarget::Vertex, 0, nullptr, GpuBufferUsage::Dynamic);
+    device.vertexAttribPointer(2, 4, GpuAttribType::Int2101010Rev, true, sizeof(uint32_t), 0);
+    device.setVertexAttribEnabled(2, false);
+    device.vertexAttribConstant(2, 0.0f, 0.0f, 0.0f, 0.0f);
+
+    device.bindVertexArray(0);
+}
+
+// Stride s ≈ n / φ, coprime with n: k -> (k * s) mod n visits every
+// point once and any prefix is spread evenly over the scan (a Weyl
+// sequence over the ring-major KITTI point order).
+std::size_t PointCloudRenderer::shuffleStride(std::size_t n)
+{
+    if (n < 3)
+        return 1;
 
-    glBindVertexArray(0);
+    std::size_t s = static_cast<std::size_t>(std::llround(n * 0.6180339887498949));
+    while (std::gcd(s, n) != 1)
+        ++s;
+    return s % n;
 }
 
 void PointCloudRenderer::uploadPointCloud(const PointCloud& cloud)
 {
+    PROFILE_SCOPE("PointCloudRenderer::uploadPointCloud");
+
     if (!m_isInitialized)
     {
         Logger::warn("PointCloudRenderer: upload called before initialization. Initializing now.");
@@ -85,53 +126,129 @@ void PointCloudRenderer::uploadPointCloud(const PointCloud& cloud)
     const auto& pts = cloud.getPoints();
     std::size_t n = pts.size();
     m_pointCount = n;
+    m_normalCount = 0; // normals of the previous cloud are stale now
     if (n == 0) return;
 
-    // Create contiguous buffer of floats (x,y,z,intensity)
-    std::vector<float> buf;
-    buf.reserve(n * 4);
-    for (const auto& p : pts)
+    // Contiguous buffer of floats (x,y,z,intensity) in shuffled order,
+    // staged in the frame arena (gone after this frame)
+    m_shuffleStride = shuffleStride(n);
+    float* buf = FrameArena::mainThread().allocArray<float>(n * 4);
+
+    float* dst = buf;
+    std::size_t src = 0;
+    for (std::size_t k = 0; k < n; ++k)
     {
-        buf.push_back(p.x);
-        buf.push_back(p.y);
-        buf.push_back(p.z);
+        const auto& p = pts[src];
+        *dst++ = p.x;
+        *dst++ = p.y;
+        *dst++ = p.z;
         // intensity may be stored in p.intensity (0..1). Clamp to [0,1]
         float inten = p.intensity;
         if (inten < 0.0f) inten = 0.0f;
         if (inten > 1.0f) inten = 1.0f;
-        buf.push_back(inten);
+        *dst++ = inten;
+
+        src += m_shuffleStride;
+        if (src >= n) src -= n;
     }
+    const std::size_t floatCount = n * 4;
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    GpuDevice& device = GpuDevice::current();
+    device.bindBuffer(GpuBufferTarget::Vertex, m_vbo);
 
     // If buffer size changed, reallocate; otherwise orphan and update
-    GLint currentSize = 0;
-    glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &currentSize);
-    GLsizeiptr newSize = static_cast<GLsizeiptr>(buf.size() * sizeof(float));
+    std::size_t currentSize = device.bufferSize(GpuBufferTarget::Vertex);
+    std::size_t newSize = floatCount * sizeof(float);
 
-    if (static_cast<GLsizeiptr>(currentSize) < newSize)
+    if (currentSize < newSize)
     {
         // allocate new
-        glBufferData(GL_ARRAY_BUFFER, newSize, buf.data(), GL_DYNAMIC_DRAW);
+        device.bufferData(GpuBufferTarget::Vertex, newSize, buf, GpuBufferUsage::Dynamic);
     }
     else
     {
         // orphan and upload
-        glBufferData(GL_ARRAY_BUFFER, newSize, nullptr, GL_DYNAMIC_DRAW);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, newSize, buf.data());
+        device.bufferData(GpuBufferTarget::Vertex, newSize, nullptr, GpuBufferUsage::Dynamic);
+        device.bufferSubData(GpuBufferTarget::Vertex, 0, newSize, buf);
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    device.bindBuffer(GpuBufferTarget::Vertex, 0);
+
+    m_vboBytes = newSize;
+    reportMemory();
+}
+
+void PointCloudRenderer::uploadNormals(const std::vector<uint32_t>& packedNormals)
+{
+    PROFILE_SCOPE("PointCloudRenderer::uploadNormals");
+
+    if (!m_isInitialized)
+        return;
+
+    m_normalCount = packedNormals.size();
+    if (m_normalCount == 0) return;
+
+    // Same shuffled order as the positions (only meaningful when
+    // the counts match; render() checks that)
+    const std::size_t n = m_normalCount;
+    const std::size_t stride = (n == m_pointCount) ? m_shuffleStride : 1;
+    uint32_t* shuffled = FrameArena::mainThread().allocArray<uint32_t>(n);
+    std::size_t src = 0;
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        shuffled[k] = packedNormals[src];
+        src += stride;
+        if (src >= n) src -= n;
+    }
+
+    std::size_t newSize = n * sizeof(uint32_t);
+
+    GpuDevice& device = GpuDevice::current();
+    device.bindBuffer(GpuBufferTarget::Vertex, m_normalVbo);
+    device.bufferData(GpuBufferTarget::Vertex, newSize, nullptr, GpuBufferUsage::Dynamic);
+    device.bufferSubData(GpuBufferTarget::Vertex, 0, newSize, shuffled);
+    device.bindBuffer(GpuBufferTarget::Vertex, 0);
+
+    m_normalVboBytes = newSize;
+    reportMemory();
+}
+
+void PointCloudRenderer::reportMemory()
+{
+    MemoryBudget::instance().setUsage(m_memoryId, m_vboBytes + m_normalVboBytes);
+}
+
+std::size_t PointCloudRenderer::releaseStaleNormals()
+{
+    // Normals of an older cloud are never drawn again; the next
+    // uploadNormals() reallocates anyway
+    if (m_normalVboBytes == 0 || m_normalCount == m_pointCount)
+        return 0;
+
+    GpuDevice& device = GpuDevice::current();
+    device.bindBuffer(GpuBufferTarget::Vertex, m_normalVbo);
+    device.bufferData(GpuBufferTarget::Vertex, 0, nullptr, GpuBufferUsage::Dynamic);
+    device.bindBuffer(GpuBufferTarget::Vertex, 0);
+
+    std::size_t released = m_normalVboBytes;
+    m_normalVboBytes = 0;
+    m_normalCount = 0;
+    reportMemory();
+    return released;
 }
 
 void PointCloudRenderer::render(const glm::mat4& view, const glm::mat4& projection)
 {
+    PROFILE_SCOPE("PointCloudRenderer::render");
+
+    m_drawnCount = 0;
     if (!m_isInitialized || m_pointCount == 0)
         return;
 
-    glEnable(GL_PROGRAM_POINT_SIZE);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GpuDevice& device = GpuDevice::current();
+    device.setEnabled(GpuCapability::ProgramPointSize, true);
+    device.setEnabled(GpuCapability::Blend, true);
+    device.setAlphaBlendFunc();
 
     m_shader.bind();
     m_shader.setUniformMat4("u_View", view);
@@ -140,11 +257,27 @@ void PointCloudRenderer::render(const glm::mat4& view, const glm::mat4& projecti
     // control point size via uniform if shader supports it
     m_shader.setUniformFloat("u_PointSize", 2.0f);
 
-    glBindVertexArray(m_vao);
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(m_pointCount));
-    glBindVertexArray(0);
+    // Lit shading only when normals belong to the current cloud
+    bool lit = (m_shading == PointShading::Lit) && (m_normalCount == m_pointCount);
+    m_shader.setUniformInt("u_ShadingMode", lit ? 1 : 0);
+    if (lit)
+    {
+        // Headlight: light comes from the viewer, in view space
+        m_shader.setUniformVec3("u_LightDir", glm::vec3(0.3f, 0.5f, 1.0f));
+    }
+
+    device.bindVertexArray(m_vao);
+    device.setVertexAttribEnabled(2, lit);
+
+    // Prefix of the shuffled buffer = uniform subsample
+    m_drawnCount = m_pointCount;
+    if (m_pointBudget > 0 && m_pointBudget < m_pointCount)
+        m_drawnCount = m_pointBudget;
+
+    device.drawArrays(GpuPrimitive::Points, 0, static_cast<int>(m_drawnCount));
+    device.bindVertexArray(0);
 
     Shader::unbind();
 
-    glDisable(GL_BLEND);
+    device.setEnabled(GpuCapability::Blend, false);
 }
@@ -0,0 +1,474 @@
+// src/rendering/RecordingDevice.cpp
+// Context-free GpuDevice: counts and captures renderer commands.
+
+#include "RecordingDevice.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    const char* const kOpNames[] = {
+        "CreateBuffer", "DestroyBuffer", "CreateVertexArray", "DestroyVertexArray",
+        "BindVertexArray", "BindBuffer", "BufferData", "BufferSubData", "BufferSize",
+        "VertexAttribPointer", "VertexAttribEnable", "VertexAttribConstant",
+        "CreateTexture", "DestroyTexture", "UploadTexture", "BindTexture",
+        "CreateTextureArray", "AllocateTextureArray", "UploadTextureLayer", "BindTextureArray",
+        "CreateProgram", "DestroyProgram", "UseProgram", "UniformLocation",
+        "UniformMat4", "UniformVec3", "UniformFloat", "UniformInt",
+        "SetEnabled", "BlendFunc", "LineWidth", "Clear",
+        "DrawArrays", "DrawIndexed",
+        "CreateQuery", "DestroyQuery", "BeginQuery", "EndQuery", "QueryResult",
+        "Finish",
+    };
+    static_assert(sizeof(kOpNames) / sizeof(kOpNames[0]) == static_cast<size_t>(RecordingDevice::Op::Count),
+                  "kOpNames out of sync with RecordingDevice::Op");
+
+    constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+    constexpr uint64_t kFnvPrime  = 1099511628211ull;
+
+    uint64_t fnv1a(const void* data, size_t bytes, uint64_t hash = kFnvOffset)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < bytes; ++i)
+        {
+            hash ^= p[i];
+            hash *= kFnvPrime;
+        }
+        return hash;
+    }
+
+    uint32_t floatBits(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+const char* RecordingDevice::opName(Op op)
+{
+    size_t index = static_cast<size_t>(op);
+    return index < static_cast<size_t>(Op::Count) ? kOpNames[index] : "?";
+}
+
+void RecordingDevice::record(Op op, uint32_t a, uint32_t b, uint64_t c)
+{
+    ++m_counters.calls;
+    if (m_capture)
+        m_commands.push_back({ op, a, b, c });
+}
+
+GpuDevice::Handle RecordingDevice::newHandle()
+{
+    ++m_counters.objectsCreated;
+    return m_nextHandle++;
+}
+
+void RecordingDevice::stateChange(bool redundant)
+{
+    ++m_counters.stateChanges;
+    if (redundant)
+        ++m_counters.redundantStateChanges;
+}
+
+void RecordingDevice::uniform(Op op, int location, const void* values, size_t bytes)
+{
+    ++m_counters.uniformUpdates;
+    // Values only matter to the capture; skip hashing when counting
+    record(op, m_program, static_cast<uint32_t>(location), m_capture ? fnv1a(values, bytes) : 0);
+}
+
+uint64_t RecordingDevice::captureHash() const
+{
+    uint64_t hash = kFnvOffset;
+    for (const Command& cmd : m_commands)
+    {
+        const uint8_t op = static_cast<uint8_t>(cmd.op);
+        hash = fnv1a(&op, sizeof(op), hash);
+        hash = fnv1a(&cmd.a, sizeof(cmd.a), hash);
+        hash = fnv1a(&cmd.b, sizeof(cmd.b), hash);
+        hash = fnv1a(&cmd.c, sizeof(cmd.c), hash);
+    }
+    return hash;
+}
+
+std::string RecordingDevice::captureToText() const
+{
+    std::string text;
+    text.reserve(m_commands.size() * 32);
+
+    char line[96];
+    for (const Command& cmd : m_commands)
+    {
+        std::snprintf(line, sizeof(line), "%s %u %u %llu\n", opName(cmd.op), cmd.a, cmd.b,
+                      static_cast<unsigned long long>(cmd.c));
+        text += line;
+    }
+    return text;
+}
+
+bool RecordingDevice::writeCapture(const std::string& path) const
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file)
+        return false;
+
+    const std::string text = captureToText();
+    std::fwrite(text.data(), 1, text.size(), file);
+    return std::fclose(file) == 0;
+}
+
+std::string RecordingDevice::describe() const
+{
+    return "RecordingDevice (no GL)";
+}
+
+// ---- Buffers / vertex arrays ----
+
+GpuDevice::Handle RecordingDevice::createBuffer()
+{
+    Handle buffer = newHandle();
+    m_bufferSizes[buffer] = 0;
+    record(Op::CreateBuffer, buffer);
+    return buffer;
+}
+
+void RecordingDevice::destroyBuffer(Handle buffer)
+{
+    ++m_counters.objectsDestroyed;
+    m_bufferSizes.erase(buffer);
+    for (Handle& bound : m_buffers)
+        if (bound == buffer)
+            bound = 0;
+    record(Op::DestroyBuffer, buffer);
+}
+
+GpuDevice::Handle RecordingDevice::createVertexArray()
+{
+    Handle vao = newHandle();
+    record(Op::CreateVertexArray, vao);
+    return vao;
+}
+
+void RecordingDevice::destroyVertexArray(Handle vao)
+{
+    ++m_counters.objectsDestroyed;
+    if (m_vertexArray == vao)
+        m_vertexArray = 0;
+    record(Op::DestroyVertexArray, vao);
+}
+
+void RecordingDevice::bindVertexArray(Handle vao)
+{
+    stateChange(vao == m_vertexArray);
+    m_vertexArray = vao;
+    record(Op::BindVertexArray, vao);
+}
+
+void RecordingDevice::bindBuffer(GpuBufferTarget target, Handle buffer)
+{
+    Handle& bound = m_buffers[static_cast<int>(target)];
+    stateChange(buffer == bound);
+    bound = buffer;
+    record(Op::BindBuffer, static_cast<uint32_t>(target), buffer);
+}
+
+void RecordingDevice::bufferData(GpuBufferTarget target, size_t bytes, const void* data, GpuBufferUsage usage)
+{
+    Handle buffer = m_buffers[static_cast<int>(target)];
+    m_bufferSizes[buffer] = bytes;
+
+    ++m_counters.bufferAllocations;
+    if (data && bytes > 0)
+    {
+        ++m_counters.uploadCalls;
+        m_counters.uploadBytes += bytes;
+    }
+    record(Op::BufferData, buffer, static_cast<uint32_t>(usage), bytes);
+}
+
+void RecordingDevice::bufferSubData(GpuBufferTarget target, size_t offset, size_t bytes, const void* /*data*/)
+{
+    ++m_counters.uploadCalls;
+    m_counters.uploadBytes += bytes;
+    record(Op::BufferSubData, m_buffers[static_cast<int>(target)], static_cast<uint32_t>(offset), bytes);
+}
+
+size_t RecordingDevice::bufferSize(GpuBufferTarget target)
+{
+    Handle buffer = m_buffers[static_cast<int>(target)];
+    auto it = m_bufferSizes.find(buffer);
+    size_t size = it != m_bufferSizes.end() ? it->second : 0;
+    record(Op::BufferSize, buffer, 0, size);
+    return size;
+}
+
+void RecordingDevice::vertexAttribPointer(unsigned int index, int components, GpuAttribType type,
+                                          bool normalized, int stride, size_t offset)
+{
+    stateChange(false);
+    // b packs the layout: components | type << 8 | normalized << 16; c: stride << 32 | offset
+    uint32_t layout = static_cast<uint32_t>(components)
+                    | static_cast<uint32_t>(type) << 8
+                    | (normalized ? 1u : 0u) << 16;
+    record(Op::VertexAttribPointer, index, layout,
+           static_cast<uint64_t>(stride) << 32 | static_cast<uint32_t>(offset));
+}
+
+void RecordingDevice::setVertexAttribEnabled(unsigned int index, bool enabled)
+{
+    stateChange(false);
+    record(Op::VertexAttribEnable, index, enabled ? 1 : 0);
+}
+
+void RecordingDevice::vertexAttribConstant(unsigned int index, float x, float y, float z, float w)
+{
+    stateChange(false);
+    const float values[4] = { x, y, z, w };
+    record(Op::VertexAttribConstant, index, 0, fnv1a(values, sizeof(values)));
+}
+
+// ---- Textures ----
+
+GpuDevice::Handle RecordingDevice::createTexture2D()
+{
+    Handle texture = newHandle();
+    // GlDevice initialises a 1x1 RGB texel
+    ++m_counters.textureUploads;
+    ++m_counters.uploadCalls;
+    m_counters.uploadBytes += 3;
+    record(Op::CreateTexture, texture);
+    return texture;
+}
+
+void RecordingDevice::destroyTexture(Handle texture)
+{
+    ++m_counters.objectsDestroyed;
+    if (m_texture == texture)
+        m_texture = 0;
+    if (m_textureArray == texture)
+        m_textureArray = 0;
+    record(Op::DestroyTexture, texture);
+}
+
+void RecordingDevice::uploadTexture2D(Handle texture, int width, int height,
+                                      const unsigned char* /*rgb*/, bool generateMipmaps)
+{
+    const uint64_t bytes = static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * 3;
+    ++m_counters.textureUploads;
+    ++m_counters.uploadCalls;
+    m_counters.uploadBytes += bytes;
+    // Leaves no texture bound (same as GlDevice)
+    m_texture = 0;
+    record(Op::UploadTexture, texture,
+           static_cast<uint32_t>(width) << 16 | (static_cast<uint32_t>(height) & 0xffff),
+           bytes << 1 | (generateMipmaps ? 1 : 0));
+}
+
+void RecordingDevice::bindTexture2D(unsigned int unit, Handle texture)
+{
+    stateChange(unit == m_textureUnit && texture == m_texture);
+    m_textureUnit = unit;
+    m_texture = texture;
+    record(Op::BindTexture, unit, texture);
+}
+
+GpuDevice::Handle RecordingDevice::createTextureArray()
+{
+    Handle texture = newHandle();
+    record(Op::CreateTextureArray, texture);
+    return texture;
+}
+
+void RecordingDevice::allocateTextureArray(Handle texture, int width, int height, int layers)
+{
+    ++m_counters.bufferAllocations;
+    m_textureArray = 0;
+    record(Op::AllocateTextureArray, texture,
+           static_cast<uint32_t>(width) << 16 | (static_cast<uint32_t>(height) & 0xffff),
+           static_cast<uint64_t>(layers));
+}
+
+void RecordingDevice::uploadTextureLayer(Handle texture, int layer, int width, int height,
+                                         const unsigned char* /*rgb*/)
+{
+    const uint64_t bytes = static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * 3;
+    ++m_counters.textureUploads;
+    ++m_counters.uploadCalls;
+    m_counters.uploadBytes += bytes;
+    // Leaves no texture array bound (same as GlDevice)
+    m_textureArray = 0;
+    record(Op::UploadTextureLayer, texture, static_cast<uint32_t>(layer),
+           static_cast<uint64_t>(width) << 16 | (static_cast<uint64_t>(height) & 0xffff));
+}
+
+void RecordingDevice::bindTextureArray(unsigned int unit, Handle texture)
+{
+    stateChange(unit == m_textureArrayUnit && texture == m_textureArray);
+    m_textureArrayUnit = unit;
+    m_textureArray = texture;
+    record(Op::BindTextureArray, unit, texture);
+}
+
+// ---- Programs ----
+
+GpuDevice::Handle RecordingDevice::createProgram(const std::string& vertexSrc, const std::string& fragmentSrc,
+                                                 std::string& /*errorLog*/)
+{
+    // Nothing is compiled; any source "links"
+    Handle program = newHandle();
+    m_uniforms[program];
+    record(Op::CreateProgram, program, 0,
+           fnv1a(fragmentSrc.data(), fragmentSrc.size(), fnv1a(vertexSrc.data(), vertexSrc.size())));
+    return program;
+}
+
+void RecordingDevice::destroyProgram(Handle program)
+{
+    ++m_counters.objectsDestroyed;
+    m_uniforms.erase(program);
+    if (m_program == program)
+        m_program = 0;
+    record(Op::DestroyProgram, program);
+}
+
+void RecordingDevice::useProgram(Handle program)
+{
+    stateChange(program == m_program);
+    m_program = program;
+    record(Op::UseProgram, program);
+}
+
+int RecordingDevice::uniformLocation(Handle program, const char* name)
+{
+    ++m_counters.uniformLookups;
+
+    int location = -1;
+    auto it = m_uniforms.find(program);
+    if (it != m_uniforms.end())
+    {
+        auto& names = it->second;
+        for (const auto& entry : names)
+        {
+            if (entry.first == name)
+            {
+                location = entry.second;
+                break;
+            }
+        }
+        if (location < 0)
+        {
+            location = static_cast<int>(names.size());
+            names.emplace_back(name, location);
+        }
+    }
+
+    record(Op::UniformLocation, program, static_cast<uint32_t>(location));
+    return location;
+}
+
+void RecordingDevice::setUniformMat4(int location, const float* values)
+{
+    uniform(Op::UniformMat4, location, values, 16 * sizeof(float));
+}
+
+void RecordingDevice::setUniformVec3(int location, const float* values)
+{
+    uniform(Op::UniformVec3, location, values, 3 * sizeof(float));
+}
+
+void RecordingDevice::setUniformFloat(int location, float value)
+{
+    uniform(Op::UniformFloat, location, &value, sizeof(value));
+}
+
+void RecordingDevice::setUniformInt(int location, int value)
+{
+    uniform(Op::UniformInt, location, &value, sizeof(value));
+}
+
+// ---- Fixed-function state ----
+
+void RecordingDevice::setEnabled(GpuCapability capability, bool enabled)
+{
+    bool& current = m_enabled[static_cast<int>(capability)];
+    stateChange(current == enabled);
+    current = enabled;
+    record(Op::SetEnabled, static_cast<uint32_t>(capability), enabled ? 1 : 0);
+}
+
+void RecordingDevice::setAlphaBlendFunc()
+{
+    stateChange(m_blendFuncSet);
+    m_blendFuncSet = true;
+    record(Op::BlendFunc);
+}
+
+void RecordingDevice::setLineWidth(float width)
+{
+    stateChange(width == m_lineWidth);
+    m_lineWidth = width;
+    record(Op::LineWidth, floatBits(width));
+}
+
+void RecordingDevice::clear(float r, float g, float b, float a)
+{
+    const float color[4] = { r, g, b, a };
+    record(Op::Clear, 0, 0, fnv1a(color, sizeof(color)));
+}
+
+// ---- Draws ----
+
+void RecordingDevice::drawArrays(GpuPrimitive primitive, int first, int count)
+{
+    ++m_counters.drawCalls;
+    m_counters.vertices += count > 0 ? static_cast<uint64_t>(count) : 0;
+    record(Op::DrawArrays, static_cast<uint32_t>(primitive), static_cast<uint32_t>(first),
+           static_cast<uint64_t>(count));
+}
+
+void RecordingDevice::drawIndexed(GpuPrimitive primitive, int count)
+{
+    ++m_counters.drawCalls;
+    m_counters.vertices += count > 0 ? static_cast<uint64_t>(count) : 0;
+    record(Op::DrawIndexed, static_cast<uint32_t>(primitive), 0, static_cast<uint64_t>(count));
+}
+
+// ---- Timer queries ----
+
+GpuDevice::Handle RecordingDevice::createTimerQuery()
+{
+    Handle query = newHandle();
+    record(Op::CreateQuery, query);
+    return query;
+}
+
+void RecordingDevice::destroyTimerQuery(Handle query)
+{
+    ++m_counters.objectsDestroyed;
+    record(Op::DestroyQuery, query);
+}
+
+void RecordingDevice::beginTimerQuery(Handle query)
+{
+    record(Op::BeginQuery, query);
+}
+
+void RecordingDevice::endTimerQuery()
+{
+    record(Op::EndQuery);
+}
+
+bool RecordingDevice::timerQueryResult(Handle query, uint64_t& outNs)
+{
+    // Nothing ran on a GPU: always ready, always zero
+    outNs = 0;
+    record(Op::QueryResult, query);
+    return true;
+}
+
+void RecordingDevice::finish()
+{
+    record(Op::Finish);
+}
@@ -3,15 +3,40 @@
 // Reference: /mnt/data/OpenGL_Assignment.pdf
 
 #include "Renderer.h"
+#include "GpuDevice.h"
 #include "PointCloudRenderer.h"
 #include "ImageRenderer.h"
 #include "TrajectoryRenderer.h"
 #include "SteeringWheelRenderer.h"
 #include "Camera.h"
+#include "PointCloud.h"
+#include "Trajectory.h"
 
+#include "core/Profiler.h"
 #include "utils/Logger.h"
+#include "utils/MathUtils.h"
 
-#include <glad/glad.h>
+namespace
+{
+    // Times the GL commands issued during its lifetime
+    class ScopedGpuTimer
+    {
+    public:
+        explicit ScopedGpuTimer(GpuTimer& timer) : m_timer(timer) { m_timer.begin(); }
+        ~ScopedGpuTimer() { m_timer.end(); }
+
+    private:
+        GpuTimer& m_timer;
+    };
+
+    // Trace event names (GPU track)
+    const char* const kGpuPassTraceNames[Renderer::GpuPassCount] = {
+        "GPU PointCloudRenderer",
+        "GPU ImageRenderer",
+        "GPU TrajectoryRenderer",
+        "GPU SteeringWheelRenderer",
+    };
+}
 
 // Constructor / destructor
 Renderer::Renderer()
@@ -26,6 +51,9 @@ bool Renderer::init()
 {
     Logger::info("Renderer: initializing sub-renderers...");
 
+    // GPU pass timings go on their own trace track (collectGpuTimings)
+    Profiler::addTrack("GPU");
+
     // Create and initialize sub-renderers
     m_pointCloudRenderer = std::make_unique<PointCloudRenderer>();
     m_pointCloudRenderer->initialize();
@@ -39,6 +67,9 @@ bool Renderer::init()
     m_steeringRenderer = std::make_unique<SteeringWheelRenderer>();
     m_steeringRenderer->initialize();
 
+    for (GpuTimer& timer : m_passTimers)
+        timer.initialize();
+
     Logger::info("Renderer: all sub-renderers initialized.");
     return true;
 }
@@ -48,10 +79,86 @@ void Renderer::setCamera(Camera* camera)
     m_camera = camera;
 }
 
+void Renderer::setPointShading(PointShading shading)
+{
+    if (m_pointCloudRenderer)
+        m_pointCloudRenderer->setShading(shading);
+}
+
+void Renderer::setPointBudget(std::size_t budget)
+{
+    if (m_pointCloudRenderer)
+        m_pointCloudRenderer->setPointBudget(budget);
+}
+
+const char* Renderer::gpuPassStatName(int pass)
+{
+    switch (pass)
+    {
+        case GpuPassPoints:        return "gpu_points_ms";
+        case GpuPassImage:         return "gpu_image_ms";
+        case GpuPassTrajectory:    return "gpu_trajectory_ms";
+        case GpuPassSteeringWheel: return "gpu_steering_ms";
+    }
+    return "gpu_pass_ms";
+}
+
+void Renderer::collectGpuTimings()
+{
+    // Results land a few frames after submission. Each one goes on
+    // the trace's GPU track at the CPU time its query was begun; the
+    // GPU runs later, so the placement is approximate.
+    for (int pass = 0; pass < GpuPassCount; ++pass)
+    {
+        double ms = 0.0;
+        uint64_t submitNs = 0;
+        if (!m_passTimers[pass].latestMs(ms, &submitNs))
+            continue;
+
+        m_gpuTimings.passMs[pass] = ms;
+        m_gpuTimingsNew = true;
+        Profiler::recordEvent(kGpuPassTraceNames[pass], submitNs,
+                              static_cast<uint64_t>(ms * 1e6), "GPU");
+    }
+
+    if (!m_gpuTimingsNew)
+        return;
+
+    m_gpuTimings.totalMs = 0.0;
+    for (double ms : m_gpuTimings.passMs)
+        m_gpuTimings.totalMs += ms;
+}
+
+bool Renderer::getGpuFrameMs(double& outMs)
+{
+    collectGpuTimings();
+    if (!m_gpuTimingsNew)
+        return false;
+
+    outMs = m_gpuTimings.totalMs;
+    m_gpuTimingsNew = false;
+    return true;
+}
+
+std::size_t Renderer::getDrawnPointCount() const
+{
+    return m_pointCloudRenderer ? m_pointCloudRenderer->getDrawnPointCount() : 0;
+}
+
 void Renderer::clear()
 {
-    glClearColor(0.05f, 0.05f, 0.07f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    GpuDevice::current().clear(0.05f, 0.05f, 0.07f, 1.0f);
+}
+
+void Renderer::finish()
+{
+    PROFILE_SCOPE("Renderer::finish");
+    GpuDevice::current().finish();
+}
+
+std::string Renderer::getDeviceDescription() const
+{
+    return GpuDevice::current().describe();
 }
 
 void Renderer::updateSteeringWheel(const glm::mat4& pose)
@@ -68,11 +175,14 @@ void Renderer::updateSteeringWheel(const glm::mat4& pose)
 void Renderer::renderFrame(
     Camera& camera,
     const PointCloud& pointCloud,
-    const std::vector<unsigned char>& imageData,
-    int imageWidth,
-    int imageHeight,
-    const Trajectory& trajectory)
+    const CameraImage* images,
+    int imageCount,
+    const Trajectory& trajectory,
+    const std::vector<uint32_t>* pointNormals,
+    uint64_t contentId)
 {
+    PROFILE_SCOPE("Renderer::renderFrame");
+
     if (!m_camera)
         m_camera = &camera;
 
@@ -80,35 +190,67 @@ void Renderer::renderFrame(
     glm::mat4 view = m_camera->getViewMatrix();
     glm::mat4 projection = m_camera->getProjectionMatrix( (float)800 / 600 ); // you can compute proper aspect
 
+    m_lastView = view;
+    m_lastProjection = projection;
+
+    m_lastUpload = UploadStats();
+
+    // Points, normals and images only change with the frame; redraws
+    // of the same one (camera moves, overlay, idle) reuse the GPU copy
+    const bool uploadFrame = contentId == 0 || contentId != m_uploadedContent;
+    m_uploadedContent = contentId;
+
     // Clear buffers
     clear();
-    glEnable(GL_DEPTH_TEST);
+    GpuDevice::current().setEnabled(GpuCapability::DepthTest, true);
+
+    // Each pass is timed on its own (uploads included); timer
+    // queries cannot nest, so the frame total is their sum.
 
     // 1) Point cloud
     if (m_pointCloudRenderer)
     {
-        m_pointCloudRenderer->uploadPointCloud(pointCloud);
+        ScopedGpuTimer timer(m_passTimers[GpuPassPoints]);
+        if (uploadFrame)
+        {
+            m_pointCloudRenderer->uploadPointCloud(pointCloud);
+            m_lastUpload.points = pointCloud.size();
+            m_lastUpload.bytes += pointCloud.size() * 4 * sizeof(float);
+            if (pointNormals)
+            {
+                m_pointCloudRenderer->uploadNormals(*pointNormals);
+                m_lastUpload.bytes += pointNormals->size() * sizeof(uint32_t);
+            }
+        }
         m_pointCloudRenderer->render(view, projection);
     }
 
     // 2) Image overlay (draw last so it's on top)
-    if (m_imageRenderer && !imageData.empty())
+    if (m_imageRenderer && imageCount > 0)
     {
-        m_imageRenderer->updateImageTexture(imageWidth, imageHeight, imageData);
+        ScopedGpuTimer timer(m_passTimers[GpuPassImage]);
+        if (uploadFrame)
+            m_lastUpload.bytes += m_imageRenderer->updateImages(images, imageCount);
         // For image overlay we pass identity view/proj (quad in NDC) or camera matrices depending on shader.
         m_imageRenderer->render(glm::mat4(1.0f), glm::mat4(1.0f));
     }
+    else
+    {
+        m_gpuTimings.passMs[GpuPassImage] = 0.0;   // not drawn
+    }
 
     // 3) Trajectory
     if (m_trajectoryRenderer)
     {
-        m_trajectoryRenderer->uploadTrajectory(trajectory);
+        ScopedGpuTimer timer(m_passTimers[GpuPassTrajectory]);
+        m_lastUpload.bytes += m_trajectoryRenderer->updateTrajectory(trajectory);
         m_trajectoryRenderer->render(view, projection);
     }
 
     // 4) Steering wheel HUD
     if (m_steeringRenderer)
     {
+        ScopedGpuTimer timer(m_passTimers[GpuPassSteeringWheel]);
         m_steeringRenderer->render(view, projection);
     }
 
@@ -3,10 +3,11 @@
 // Reference: /mnt/data/OpenGL_Assignment.pdf
 
 #include "SteeringWheelRenderer.h"
+#include "GpuDevice.h"
+#include "core/Profiler.h"
 #include "utils/FileUtils.h"
 #include "utils/Logger.h"
 
-#include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <vector>
 #include <cmath>
@@ -21,8 +22,8 @@ SteeringWheelRenderer::SteeringWheelRenderer()
 
 SteeringWheelRenderer::~SteeringWheelRenderer()
 {
-    if (m_vbo) glDeleteBuffers(1, &m_vbo);
-    if (m_vao) glDeleteVertexArrays(1, &m_vao);
+    if (m_vbo) GpuDevice::current().destroyBuffer(m_vbo);
+    if (m_vao) GpuDevice::current().destroyVertexArray(m_vao);
 }
 
 void SteeringWheelRenderer::initialize()
@@ -73,18 +74,19 @@ void SteeringWheelRenderer::createWheelGeometry()
     }
 
     // Create VAO/VBO
-    glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
+    GpuDevice& device = GpuDevice::current();
+    m_vao = device.createVertexArray();
+    m_vbo = device.createBuffer();
 
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    device.bindVertexArray(m_vao);
+    device.bindBuffer(GpuBufferTarget::Vertex, m_vbo);
+    device.bufferData(GpuBufferTarget::Vertex, vertices.size() * sizeof(float), vertices.data(), GpuBufferUsage::Static);
 
     // position attribute (vec3)
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    device.setVertexAttribEnabled(0, true);
+    device.vertexAttribPointer(0, 3, GpuAttribType::Float, false, 3 * sizeof(float), 0);
 
-    glBindVertexArray(0);
+    device.bindVertexArray(0);
 }
 
 void SteeringWheelRenderer::setSteeringAngle(float angleRadians)
@@ -94,6 +96,8 @@ void SteeringWheelRenderer::setSteeringAngle(float angleRadians)
 
 void SteeringWheelRenderer::render(const glm::mat4& view, const glm::mat4& projection)
 {
+    PROFILE_SCOPE("SteeringWheelRenderer::render");
+
     if (!m_isInitialized) return;
 
     m_shader.bind();
@@ -112,13 +116,14 @@ void SteeringWheelRenderer::render(const glm::mat4& view, const glm::mat4& proje
 
     m_shader.setUniformVec3("u_Color", glm::vec3(0.15f, 0.15f, 0.15f));
 
-    glBindVertexArray(m_vao);
+    GpuDevice& device = GpuDevice::current();
+    device.bindVertexArray(m_vao);
 
     // Draw segments as pairs: 2 vertices per segment -> draw as GL_TRIANGLE_STRIP or GL_LINES for ring edges.
     // We'll draw as GL_LINES connecting outer->inner pairs for visual ring.
     const int segments = 64;
-    glDrawArrays(GL_LINES, 0, segments * 2);
+    device.drawArrays(GpuPrimitive::Lines, 0, segments * 2);
 
-    glBindVertexArray(0);
+    device.bindVertexArray(0);
     Shader::unbind();
 }
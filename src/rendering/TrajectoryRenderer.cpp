@@ -3,12 +3,16 @@
 // Reference: /mnt/data/OpenGL_Assignment.pdf
 
 #include "TrajectoryRenderer.h"
+#include "GpuDevice.h"
+#include "core/MemoryBudget.h"
+#include "core/Profiler.h"
 #include "utils/FileUtils.h"
 #include "utils/Logger.h"
 
-#include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+
 static const std::string TRAJ_VERT = "resources/shaders/trajectory.vert";
 static const std::string TRAJ_FRAG = "resources/shaders/trajectory.frag";
 
@@ -19,8 +23,11 @@ TrajectoryRenderer::TrajectoryRenderer()
 
 TrajectoryRenderer::~TrajectoryRenderer()
 {
-    if (m_vbo) glDeleteBuffers(1, &m_vbo);
-    if (m_vao) glDeleteVertexArrays(1, &m_vao);
+    MemoryBudget::instance().remove(m_memoryId);
+    if (m_vbo) GpuDevice::current().destroyBuffer(m_vbo);
+    if (m_vao) GpuDevice::current().destroyVertexArray(m_vao);
+    if (m_tailVbo) GpuDevice::current().destroyBuffer(m_tailVbo);
+    if (m_tailVao) GpuDevice::current().destroyVertexArray(m_tailVao);
 }
 
 void TrajectoryRenderer::initialize()
@@ -43,78 +50,134 @@ void TrajectoryRenderer::initialize()
     }
 
     createBuffers();
+    m_memoryId = MemoryBudget::instance().add("gpu_trajectory", MemoryBudget::Gpu);
     m_isInitialized = true;
     Logger::info("TrajectoryRenderer: initialized.");
 }
 
 void TrajectoryRenderer::createBuffers()
 {
-    glGenVertexArrays(1, &m_vao);
-    glGenBuffers(1, &m_vbo);
+    GpuDevice& device = GpuDevice::current();
+    m_vao = device.createVertexArray();
+    m_vbo = device.createBuffer();
 
-    glBindVertexArray(m_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    device.bindVertexArray(m_vao);
+    device.bindBuffer(GpuBufferTarget::Vertex, m_vbo);
     // start with empty buffer
-    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+    device.bufferData(GpuBufferTarget::Vertex, 0, nullptr, GpuBufferUsage::Dynamic);
+
+    device.setVertexAttribEnabled(0, true); // position vec3
+    device.vertexAttribPointer(0, 3, GpuAttribType::Float, false, 3 * sizeof(float), 0);
+
+    // Tail segment: two vertices, rewritten when the current frame moves
+    m_tailVao = device.createVertexArray();
+    m_tailVbo = device.createBuffer();
+
+    device.bindVertexArray(m_tailVao);
+    device.bindBuffer(GpuBufferTarget::Vertex, m_tailVbo);
+    device.bufferData(GpuBufferTarget::Vertex, 2 * sizeof(glm::vec3), nullptr, GpuBufferUsage::Dynamic);
 
-    glEnableVertexAttribArray(0); // position vec3
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    device.setVertexAttribEnabled(0, true);
+    device.vertexAttribPointer(0, 3, GpuAttribType::Float, false, 3 * sizeof(float), 0);
 
-    glBindVertexArray(0);
+    device.bindVertexArray(0);
 }
 
-void TrajectoryRenderer::uploadTrajectory(const Trajectory& trajectory)
+std::size_t TrajectoryRenderer::updateTrajectory(const Trajectory& trajectory)
 {
+    PROFILE_SCOPE("TrajectoryRenderer::updateTrajectory");
+
     if (!m_isInitialized)
     {
         Logger::warn("TrajectoryRenderer: upload before init -> initializing.");
         initialize();
-        if (!m_isInitialized) return;
+        if (!m_isInitialized) return 0;
     }
 
-    const auto& pts = trajectory.getPath();
-    m_pointCount = pts.size();
-    if (m_pointCount == 0) return;
+    // Uploaded straight from the trajectory's storage
+    static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "glm::vec3 must be tightly packed");
 
-    std::vector<float> buf;
-    buf.reserve(m_pointCount * 3);
-    for (const auto& p : pts)
-    {
-        buf.push_back(p.x);
-        buf.push_back(p.y);
-        buf.push_back(p.z);
-    }
+    GpuDevice& device = GpuDevice::current();
+    const std::vector<glm::vec3>& pts = trajectory.getDrawPath();
+    std::size_t uploaded = 0;
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    GLint currentSize = 0;
-    glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &currentSize);
-    GLsizeiptr newSize = static_cast<GLsizeiptr>(buf.size() * sizeof(float));
-    if (static_cast<GLsizeiptr>(currentSize) < newSize)
+    // 1) Vertices: all of them when the path was replaced, otherwise
+    //    only those appended since the last upload
+    const bool replaced = m_uploadedFrom != &trajectory ||
+                          m_uploadedGeneration != trajectory.getGeneration() ||
+                          pts.size() < m_uploadedCount;
+    if (replaced || pts.size() > m_uploadedCount)
     {
-        glBufferData(GL_ARRAY_BUFFER, newSize, buf.data(), GL_DYNAMIC_DRAW);
+        std::size_t first = replaced ? 0 : m_uploadedCount;
+
+        device.bindBuffer(GpuBufferTarget::Vertex, m_vbo);
+        if (replaced || pts.size() > m_capacity)
+        {
+            // Exact for a rebuilt path, doubled for a growing one
+            m_capacity = replaced ? pts.size() : std::max(pts.size(), m_capacity * 2);
+            device.bufferData(GpuBufferTarget::Vertex, m_capacity * sizeof(glm::vec3), nullptr,
+                              GpuBufferUsage::Dynamic);
+            first = 0;
+        }
+
+        const std::size_t bytes = (pts.size() - first) * sizeof(glm::vec3);
+        if (bytes > 0)
+            device.bufferSubData(GpuBufferTarget::Vertex, first * sizeof(glm::vec3), bytes, &pts[first]);
+        device.bindBuffer(GpuBufferTarget::Vertex, 0);
+
+        m_uploadedFrom       = &trajectory;
+        m_uploadedGeneration = trajectory.getGeneration();
+        m_uploadedCount      = pts.size();
+        m_tailFrame          = -1;
+        uploaded += bytes;
+
+        MemoryBudget::instance().setUsage(m_memoryId, (m_capacity + 2) * sizeof(glm::vec3));
     }
-    else
+
+    // 2) Range [0, current]: a prefix of the draw path
+    const int current = std::min(trajectory.getCurrentFrame(), static_cast<int>(trajectory.size()) - 1);
+    m_pointCount = trajectory.drawCountUpTo(current);
+
+    // 3) Simplified vertices stop short of the current frame: the
+    //    tail joins the last of them to the vehicle
+    const int tailFrame = trajectory.isSimplified() && m_pointCount > 0 ? current : -1;
+    if (tailFrame != m_tailFrame && tailFrame >= 0)
     {
-        glBufferData(GL_ARRAY_BUFFER, newSize, nullptr, GL_DYNAMIC_DRAW);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, newSize, buf.data());
+        const glm::vec3 tail[2] = { pts[m_pointCount - 1], trajectory.getPath()[tailFrame] };
+
+        device.bindBuffer(GpuBufferTarget::Vertex, m_tailVbo);
+        device.bufferSubData(GpuBufferTarget::Vertex, 0, sizeof(tail), tail);
+        device.bindBuffer(GpuBufferTarget::Vertex, 0);
+        uploaded += sizeof(tail);
     }
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_tailFrame = tailFrame;
+
+    return uploaded;
 }
 
 void TrajectoryRenderer::render(const glm::mat4& view, const glm::mat4& projection)
 {
+    PROFILE_SCOPE("TrajectoryRenderer::render");
+
     if (!m_isInitialized || m_pointCount == 0)
         return;
 
-    glLineWidth(2.0f);
+    GpuDevice& device = GpuDevice::current();
+    device.setLineWidth(2.0f);
     m_shader.bind();
     m_shader.setUniformMat4("u_View", view);
     m_shader.setUniformMat4("u_Projection", projection);
     m_shader.setUniformVec3("u_Color", glm::vec3(1.0f, 0.8f, 0.0f)); // amber
 
-    glBindVertexArray(m_vao);
-    glDrawArrays(GL_LINE_STRIP, 0, static_cast<GLsizei>(m_pointCount));
-    glBindVertexArray(0);
+    device.bindVertexArray(m_vao);
+    device.drawArrays(GpuPrimitive::LineStrip, 0, static_cast<int>(m_pointCount));
+
+    if (m_tailFrame >= 0)
+    {
+        device.bindVertexArray(m_tailVao);
+        device.drawArrays(GpuPrimitive::Lines, 0, 2);
+    }
+    device.bindVertexArray(0);
 
     Shader::unbind();
 }
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <filesystem>
 #include <algorithm>
+#include <iterator>
 
 namespace fs = std::filesystem;
 
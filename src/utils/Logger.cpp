@@ -1,10 +1,18 @@
 #include "Logger.h"
+#include "core/MpscRing.h"
 
-#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <fstream>
+#include <iostream>
+#include <memory>
 #include <mutex>
-#include <chrono>
-#include <iomanip>
+#include <thread>
 
 namespace Logger
 {
@@ -13,10 +21,48 @@ namespace Logger
     // ------------------------------------------------------------
     static std::ofstream g_logFile;
     static bool g_consoleEnabled = true;
-    static Level g_logLevel = Level::Info;
+    static std::atomic<int> g_logLevel{static_cast<int>(Level::Info)};
 
+    // Guards the outputs (console flag, log file) and sync logging
     static std::mutex g_mutex;
 
+    // ------------------------------------------------------------
+    // Async backend state
+    // ------------------------------------------------------------
+    struct Record
+    {
+        Level       level = Level::Info;
+        std::time_t time = 0;
+        uint16_t    length = 0;
+        char        text[kMaxAsyncMessage];
+    };
+
+    // Kept after stopAsync() for later restarts
+    static std::unique_ptr<MpscRing<Record>> g_ring;
+    static std::thread       g_writer;
+    static std::atomic<bool> g_async{false};
+    static std::atomic<bool> g_writerRunning{false};
+
+    // Producers between reading g_async and finishing their push;
+    // stopAsync() waits for them before stopping the writer
+    static std::atomic<int> g_producers{0};
+
+    // The writer sleeps while the ring is empty. Producers notify only
+    // when it is asleep (g_writerSleeping), i.e. on the first message
+    // after it ran dry.
+    static std::mutex              g_writerMutex;
+    static std::condition_variable g_writerWake;
+    static std::atomic<bool>       g_writerSleeping{false};
+
+    static std::atomic<uint64_t> g_accepted{0};   // pushed into the ring
+    static std::atomic<uint64_t> g_written{0};    // written by the writer
+    static std::atomic<uint64_t> g_dropped{0};
+    static uint64_t              g_droppedAtStart = 0;   // g_dropped at startAsync()
+
+    // Messages drained per write/flush
+    static constexpr size_t kBatchSize = 256;
+    static constexpr auto   kFlushPoll = std::chrono::milliseconds(1);
+
     // ------------------------------------------------------------
     // Helper: Convert enum Level → string
     // ------------------------------------------------------------
@@ -34,23 +80,48 @@ namespace Logger
 
     // ------------------------------------------------------------
     // Helper: timestamp [YYYY-MM-DD HH:MM:SS]
+    // Formatted at most once per second; one cache per thread that
+    // formats (sync loggers under g_mutex, the async writer).
     // ------------------------------------------------------------
-    static std::string timestamp()
+    class TimestampCache
     {
-        using clock = std::chrono::system_clock;
-        auto now = clock::now();
-        std::time_t t = clock::to_time_t(now);
-
-        std::tm tm{};
+    public:
+        const char* format(std::time_t t)
+        {
+            if (t != m_second)
+            {
+                std::tm tm{};
 #ifdef _WIN32
-        localtime_s(&tm, &t);
+                localtime_s(&tm, &t);
 #else
-        localtime_r(&t, &tm);
+                localtime_r(&t, &tm);
 #endif
+                std::strftime(m_text, sizeof(m_text), "%Y-%m-%d %H:%M:%S", &tm);
+                m_second = t;
+            }
+            return m_text;
+        }
+
+    private:
+        std::time_t m_second = -1;
+        char m_text[32] = {};
+    };
 
-        std::ostringstream ss;
-        ss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-        return ss.str();
+    static std::time_t now()
+    {
+        return std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    }
+
+    static void appendLine(std::string& out, const char* stamp, Level lvl,
+                           const char* text, size_t length)
+    {
+        out += '[';
+        out += stamp;
+        out += "] [";
+        out += levelToString(lvl);
+        out += "] ";
+        out.append(text, length);
+        out += '\n';
     }
 
     // ------------------------------------------------------------
@@ -85,41 +156,264 @@ namespace Logger
     // Set minimum log level
     // ------------------------------------------------------------
     void setLogLevel(Level level)
+    {
+        g_logLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    bool isEnabled(Level level)
+    {
+        return static_cast<int>(level) >= g_logLevel.load(std::memory_order_relaxed);
+    }
+
+    // ------------------------------------------------------------
+    // Writer thread: drain the ring in batches, one write + flush
+    // per output and batch
+    // ------------------------------------------------------------
+    static void writeBatch(const std::string& out, const std::string& err, const std::string& all)
     {
         std::lock_guard<std::mutex> lock(g_mutex);
-        g_logLevel = level;
+
+        if (g_consoleEnabled)
+        {
+            if (!out.empty())
+            {
+                std::fwrite(out.data(), 1, out.size(), stdout);
+                std::fflush(stdout);
+            }
+            if (!err.empty())
+                std::fwrite(err.data(), 1, err.size(), stderr);
+        }
+
+        if (g_logFile.is_open())
+        {
+            g_logFile.write(all.data(), static_cast<std::streamsize>(all.size()));
+            g_logFile.flush();
+        }
+    }
+
+    // Writer-side state: owned by the writer thread, and by
+    // stopAsync() once the writer has been joined
+    struct DrainState
+    {
+        TimestampCache stamps;
+        std::string    out, err, all;
+        uint64_t       droppedReported = 0;
+    };
+    static DrainState g_drain;
+
+    // Write up to one batch from the ring (plus a note for any new
+    // drops); returns the number of messages written
+    static size_t drainBatch(DrainState& s)
+    {
+        size_t count = 0;
+        while (count < kBatchSize)
+        {
+            Record* rec = g_ring->front();
+            if (!rec)
+                break;
+
+            const char* stamp = s.stamps.format(rec->time);
+            appendLine(rec->level == Level::Error ? s.err : s.out, stamp,
+                       rec->level, rec->text, rec->length);
+            appendLine(s.all, stamp, rec->level, rec->text, rec->length);
+
+            g_ring->pop();
+            ++count;
+        }
+
+        uint64_t dropped = g_dropped.load(std::memory_order_relaxed);
+        if (dropped != s.droppedReported)
+        {
+            char note[64];
+            int len = std::snprintf(note, sizeof(note), "%llu messages dropped (ring full)",
+                                    static_cast<unsigned long long>(dropped - s.droppedReported));
+            const char* stamp = s.stamps.format(now());
+            appendLine(s.err, stamp, Level::Warning, note, static_cast<size_t>(len));
+            appendLine(s.all, stamp, Level::Warning, note, static_cast<size_t>(len));
+            s.droppedReported = dropped;
+        }
+
+        if (!s.all.empty())
+        {
+            writeBatch(s.out, s.err, s.all);
+            s.out.clear();
+            s.err.clear();
+            s.all.clear();
+            g_written.fetch_add(count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    static void writerLoop()
+    {
+        g_drain.out.reserve(kBatchSize * 128);
+        g_drain.all.reserve(kBatchSize * 128);
+
+        while (true)
+        {
+            if (drainBatch(g_drain) > 0)
+                continue;
+
+            if (!g_writerRunning.load(std::memory_order_acquire))
+                break;   // stopped and drained
+
+            // Sequentially consistent with log(): either the producer
+            // sees us sleeping, or we see its message accepted
+            std::unique_lock<std::mutex> lock(g_writerMutex);
+            g_writerSleeping.store(true);
+            g_writerWake.wait(lock, []()
+            {
+                return g_accepted.load() > g_written.load(std::memory_order_relaxed) ||
+                       !g_writerRunning.load();
+            });
+            g_writerSleeping.store(false);
+        }
+    }
+
+    static void wakeWriter()
+    {
+        // Taking the lock orders the notify after the writer's check
+        {
+            std::lock_guard<std::mutex> lock(g_writerMutex);
+        }
+        g_writerWake.notify_one();
+    }
+
+    void startAsync(size_t ringCapacity)
+    {
+        if (g_writerRunning.load())
+            return;
+
+        // Sized once; later restarts reuse the first ring
+        if (!g_ring)
+            g_ring = std::make_unique<MpscRing<Record>>(ringCapacity);
+
+        g_droppedAtStart = g_dropped.load(std::memory_order_relaxed);
+        g_writerRunning = true;
+        g_writer = std::thread(writerLoop);
+        g_async.store(true, std::memory_order_release);
+    }
+
+    void stopAsync()
+    {
+        if (!g_writerRunning.load())
+            return;
+
+        // Producers that saw the async flag before it was cleared
+        // finish their push first; later ones log synchronously
+        g_async.store(false);
+        while (g_producers.load() > 0)
+            std::this_thread::yield();
+
+        g_writerRunning.store(false);
+        wakeWriter();
+        if (g_writer.joinable())
+            g_writer.join();
+
+        // The writer may have found the ring empty just before the
+        // last of those pushes became visible to it
+        while (drainBatch(g_drain) > 0)
+        {
+        }
+
+        const uint64_t dropped = g_dropped.load(std::memory_order_relaxed) - g_droppedAtStart;
+        if (dropped > 0)
+            warn("Logger: " + std::to_string(dropped) + " messages dropped while asynchronous (ring full)");
+    }
+
+    void flush()
+    {
+        if (!g_async.load(std::memory_order_acquire))
+            return;
+
+        const uint64_t target = g_accepted.load(std::memory_order_acquire);
+        while (g_written.load(std::memory_order_acquire) < target &&
+               g_writerRunning.load(std::memory_order_acquire))
+        {
+            std::this_thread::sleep_for(kFlushPoll);
+        }
+    }
+
+    uint64_t getDroppedCount()
+    {
+        return g_dropped.load(std::memory_order_relaxed);
     }
 
     // ------------------------------------------------------------
-    // Main logging function
+    // Synchronous write: format, write and flush under the lock
     // ------------------------------------------------------------
-    void log(Level lvl, const std::string& message)
+    static void writeSync(Level lvl, const std::string& message)
     {
-        if (lvl < g_logLevel)
-            return; // filtered out
-        
+        static TimestampCache stamps;
+        static std::string line;
+
         std::lock_guard<std::mutex> lock(g_mutex);
 
-        std::string finalMessage =
-            "[" + timestamp() + "] [" + levelToString(lvl) + "] " + message;
+        line.clear();
+        appendLine(line, stamps.format(now()), lvl, message.data(), message.size());
 
         // Console logging
         if (g_consoleEnabled)
         {
-            switch (lvl)
-            {
-            case Level::Info:    std::cout  << finalMessage << std::endl; break;
-            case Level::Warning: std::cout  << finalMessage << std::endl; break;
-            case Level::Error:   std::cerr << finalMessage << std::endl; break;
-            case Level::Debug:   std::cout  << finalMessage << std::endl; break;
-            }
+            std::FILE* stream = lvl == Level::Error ? stderr : stdout;
+            std::fwrite(line.data(), 1, line.size(), stream);
+            std::fflush(stream);
         }
 
         // File logging
         if (g_logFile.is_open())
         {
-            g_logFile << finalMessage << std::endl;
+            g_logFile.write(line.data(), static_cast<std::streamsize>(line.size()));
             g_logFile.flush();
         }
     }
+
+    // ------------------------------------------------------------
+    // Main logging function
+    // ------------------------------------------------------------
+    void log(Level lvl, const std::string& message)
+    {
+        if (!isEnabled(lvl))
+            return; // filtered out
+
+        // Counted before the flag is read (both sequentially
+        // consistent), so stopAsync() either waits for this push or
+        // this call sees the flag cleared
+        g_producers.fetch_add(1);
+        if (g_async.load())
+        {
+            const std::time_t t = now();
+            const size_t length = std::min(message.size(), kMaxAsyncMessage);
+
+            bool pushed = g_ring->tryPush([&](Record& rec)
+            {
+                rec.level  = lvl;
+                rec.time   = t;
+                rec.length = static_cast<uint16_t>(length);
+                std::memcpy(rec.text, message.data(), length);
+            });
+
+            if (pushed)
+            {
+                g_accepted.fetch_add(1);
+                if (g_writerSleeping.load())
+                    wakeWriter();
+                g_producers.fetch_sub(1, std::memory_order_release);
+                return;
+            }
+
+            // Ring full: debug/info messages are dropped and counted;
+            // warnings and errors are written synchronously instead,
+            // possibly ahead of older messages still in the ring
+            if (lvl < Level::Warning)
+            {
+                g_dropped.fetch_add(1, std::memory_order_relaxed);
+                g_producers.fetch_sub(1, std::memory_order_release);
+                return;
+            }
+        }
+        g_producers.fetch_sub(1, std::memory_order_release);
+
+        writeSync(lvl, message);
+    }
 }
@@ -2,6 +2,7 @@
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
+#include <algorithm>
 
 namespace MathUtils
 {
@@ -45,4 +46,93 @@ namespace MathUtils
 		// yaw = atan2(R21, R11)
 		return std::atan2(pose[0][2], pose[0][0]);
 	}
+
+	glm::vec3 smallestEigenvector(const glm::mat3& A)
+	{
+		// Eigenvalues of a symmetric 3x3 via the trigonometric method
+		// (Smith 1961). glm is column-major: A[col][row].
+		const float p1 = A[1][0] * A[1][0] + A[2][0] * A[2][0] + A[2][1] * A[2][1];
+		const float q  = (A[0][0] + A[1][1] + A[2][2]) / 3.0f;
+
+		float lambdaMin;
+		if (p1 <= 1e-12f)
+		{
+			// Already diagonal
+			lambdaMin = std::min(A[0][0], std::min(A[1][1], A[2][2]));
+		}
+		else
+		{
+			const float d0 = A[0][0] - q;
+			const float d1 = A[1][1] - q;
+			const float d2 = A[2][2] - q;
+			const float p2 = d0 * d0 + d1 * d1 + d2 * d2 + 2.0f * p1;
+			const float p  = std::sqrt(p2 / 6.0f);
+
+			glm::mat3 B = (1.0f / p) * (A - q * glm::mat3(1.0f));
+			float r = glm::determinant(B) * 0.5f;
+			r = clamp(r, -1.0f, 1.0f);
+
+			const float phi = std::acos(r) / 3.0f;
+			// eig1 >= eig2 >= eig3; the smallest is at phi + 2pi/3
+			lambdaMin = q + 2.0f * p * std::cos(phi + (2.0f * 3.14159265f / 3.0f));
+		}
+
+		// The eigenvector is orthogonal to the rows of (A - lambda*I);
+		// take the best-conditioned cross product of two rows.
+		const glm::mat3 M = A - lambdaMin * glm::mat3(1.0f);
+		const glm::vec3 r0(M[0][0], M[1][0], M[2][0]);
+		const glm::vec3 r1(M[0][1], M[1][1], M[2][1]);
+		const glm::vec3 r2(M[0][2], M[1][2], M[2][2]);
+
+		glm::vec3 c01 = glm::cross(r0, r1);
+		glm::vec3 c02 = glm::cross(r0, r2);
+		glm::vec3 c12 = glm::cross(r1, r2);
+
+		float l01 = glm::dot(c01, c01);
+		float l02 = glm::dot(c02, c02);
+		float l12 = glm::dot(c12, c12);
+
+		glm::vec3 best = c01;
+		float bestLen = l01;
+		if (l02 > bestLen) { best = c02; bestLen = l02; }
+		if (l12 > bestLen) { best = c12; bestLen = l12; }
+
+		if (bestLen < 1e-20f)
+			return glm::vec3(0.0f);
+
+		return best / std::sqrt(bestLen);
+	}
+
+	uint32_t packSnorm1010102(const glm::vec3& n, int w)
+	{
+		auto pack10 = [](float v) -> uint32_t
+		{
+			v = clamp(v, -1.0f, 1.0f);
+			int32_t i = static_cast<int32_t>(std::lround(v * 511.0f));
+			return static_cast<uint32_t>(i) & 0x3FFu;
+		};
+
+		return pack10(n.x)
+			 | (pack10(n.y) << 10)
+			 | (pack10(n.z) << 20)
+			 | ((static_cast<uint32_t>(w) & 0x3u) << 30);
+	}
+
+	void ndcToWorldRay(const glm::vec2& ndc,
+					   const glm::mat4& view,
+					   const glm::mat4& projection,
+					   glm::vec3& origin,
+					   glm::vec3& dir)
+	{
+		glm::mat4 invViewProj = glm::inverse(projection * view);
+
+		glm::vec4 nearH = invViewProj * glm::vec4(ndc.x, ndc.y, -1.0f, 1.0f);
+		glm::vec4 farH  = invViewProj * glm::vec4(ndc.x, ndc.y,  1.0f, 1.0f);
+
+		glm::vec3 nearP = glm::vec3(nearH) / nearH.w;
+		glm::vec3 farP  = glm::vec3(farH) / farH.w;
+
+		origin = nearP;
+		dir = safeNormalize(farP - nearP);
+	}
 }
@@ -0,0 +1,97 @@
+#include "ProcessStats.h"
+
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+    #include <unistd.h>
+#endif
+
+namespace ProcessStats
+{
+    uint64_t peakRssBytes()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+        return 0;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+    #if defined(__APPLE__)
+        return static_cast<uint64_t>(usage.ru_maxrss);          // bytes
+    #else
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024;   // KiB
+    #endif
+#endif
+    }
+
+    uint64_t currentRssBytes()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return static_cast<uint64_t>(counters.WorkingSetSize);
+        return 0;
+#elif defined(__linux__)
+        std::FILE* file = std::fopen("/proc/self/statm", "r");
+        if (!file)
+            return 0;
+
+        unsigned long long pages = 0, resident = 0;
+        const int n = std::fscanf(file, "%llu %llu", &pages, &resident);
+        std::fclose(file);
+        return n == 2 ? resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+        return 0;
+#endif
+    }
+
+    bool ioBytes(uint64_t& readBytes, uint64_t& writtenBytes)
+    {
+        readBytes = writtenBytes = 0;
+
+#if defined(_WIN32)
+        IO_COUNTERS counters;
+        if (!GetProcessIoCounters(GetCurrentProcess(), &counters))
+            return false;
+        readBytes    = counters.ReadTransferCount;
+        writtenBytes = counters.WriteTransferCount;
+        return true;
+#elif defined(__linux__)
+        std::FILE* file = std::fopen("/proc/self/io", "r");
+        if (!file)
+            return false;
+
+        bool haveRead = false, haveWrite = false;
+        char line[128];
+        unsigned long long value = 0;
+        while (std::fgets(line, sizeof(line), file))
+        {
+            if (std::sscanf(line, "rchar: %llu", &value) == 1)
+            {
+                readBytes = value;
+                haveRead = true;
+            }
+            else if (std::sscanf(line, "wchar: %llu", &value) == 1)
+            {
+                writtenBytes = value;
+                haveWrite = true;
+            }
+        }
+        std::fclose(file);
+        return haveRead && haveWrite;
+#else
+        return false;
+#endif
+    }
+}
@@ -0,0 +1,108 @@
+// ------------------------------------------------------------
+// trajectory_test
+// ------------------------------------------------------------
+// Trajectory append/build behaviour. Exits non-zero on the first
+// failed check (run by ctest when KITTI_BUILD_TESTS is on).
+// ------------------------------------------------------------
+
+#include "Trajectory.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+int g_failures = 0;
+
+void check(bool ok, const char* what)
+{
+    if (!ok)
+    {
+        std::fprintf(stderr, "FAILED: %s\n", what);
+        g_failures++;
+    }
+}
+
+bool near(const glm::vec3& a, const glm::vec3& b)
+{
+    return std::fabs(a.x - b.x) < 1e-5f && std::fabs(a.y - b.y) < 1e-5f && std::fabs(a.z - b.z) < 1e-5f;
+}
+
+void appendInOrder()
+{
+    Trajectory t;
+    check(t.append(0, glm::vec3(0.0f)), "append frame 0");
+    check(t.append(1, glm::vec3(1.0f, 0.0f, 0.0f)), "append frame 1");
+    check(!t.append(1, glm::vec3(5.0f)), "repeated frame is ignored");
+    check(!t.append(0, glm::vec3(5.0f)), "earlier frame is ignored");
+    check(t.size() == 2, "two frames stored");
+    check(near(t.getPath()[1], glm::vec3(1.0f, 0.0f, 0.0f)), "repeat did not overwrite");
+}
+
+void appendWithGap()
+{
+    Trajectory t;
+    t.append(0, glm::vec3(0.0f));
+    t.append(1, glm::vec3(1.0f, 0.0f, 0.0f));
+
+    // Frames 2 and 3 skipped (slow load); the path keeps growing
+    check(t.append(4, glm::vec3(4.0f, 3.0f, 0.0f)), "append after a gap");
+    check(t.size() == 5, "gap frames filled");
+    check(near(t.getPath()[2], glm::vec3(2.0f, 1.0f, 0.0f)), "frame 2 interpolated");
+    check(near(t.getPath()[3], glm::vec3(3.0f, 2.0f, 0.0f)), "frame 3 interpolated");
+    check(near(t.getPath()[4], glm::vec3(4.0f, 3.0f, 0.0f)), "frame 4 exact");
+
+    check(t.append(5, glm::vec3(5.0f, 3.0f, 0.0f)), "append continues after the gap");
+    check(t.size() == 6, "six frames stored");
+
+    t.setCurrentFrame(3);
+    check(t.drawCountUpTo(3) == 4, "drawn up to the current frame");
+}
+
+void appendFromLateStart()
+{
+    // First frame seen is 3 (opened mid-sequence)
+    Trajectory t;
+    check(t.append(3, glm::vec3(2.0f)), "append to an empty path at frame 3");
+    check(t.size() == 4, "frames 0-3 stored");
+    check(near(t.getPath()[0], glm::vec3(2.0f)), "leading frames at the first pose");
+}
+
+void appendToSimplified()
+{
+    Trajectory::Params params;
+    params.simplifyMinPoints = 10;
+    params.simplifyTolerance = 0.01f;
+    Trajectory t(params);
+
+    std::vector<glm::vec3> line;
+    for (int i = 0; i < 20; ++i)
+        line.emplace_back(static_cast<float>(i), 0.0f, 0.0f);
+    t.build(line);
+    check(t.isSimplified(), "long straight path is simplified");
+    check(t.getDrawPath().size() == 2, "straight path keeps its ends");
+
+    const uint32_t generation = t.getGeneration();
+    check(t.append(22, glm::vec3(22.0f, 2.0f, 0.0f)), "append with a gap to a simplified path");
+    check(t.size() == 23, "simplified path grows");
+    check(t.getDrawPath().size() == 5, "appended frames are drawn");
+    check(t.getGeneration() == generation, "append keeps the generation");
+    check(t.drawCountUpTo(21) == 4, "draw count includes gap frames");
+}
+} // namespace
+
+int main()
+{
+    appendInOrder();
+    appendWithGap();
+    appendFromLateStart();
+    appendToSimplified();
+
+    if (g_failures > 0)
+        return EXIT_FAILURE;
+
+    std::printf("trajectory_test: all checks passed\n");
+    return EXIT_SUCCESS;
+}